@@ -175,11 +175,15 @@ win32 {
 DISTFILES *= ""
 DISTFILES = ""
 HEADERS *= "" \
+    src/chorale-archive.h \
     src/choraledisplay.h \
-    src/chorale-constants.h
+    src/chorale-constants.h \
+    src/pianoroll.h
 HEADERS = ""
 SOURCES *= "" \
-    src/choraledisplay.cpp
+    src/chorale-archive.cpp \
+    src/choraledisplay.cpp \
+    src/pianoroll.cpp
 SOURCES = ""
 
 # include various source .cpp files and header .h files in the build process
@@ -427,6 +431,9 @@ CONFIG(debug, debug|release) {
 # make 'release' target be statically linked so it is a stand-alone executable
 CONFIG(release, debug|release) {
     QMAKE_CXXFLAGS += -O2
+
+    # skip Vector index range checks and iterator version bookkeeping
+    DEFINES += SPL_UNCHECKED_VECTOR
     macx {
         QMAKE_POST_LINK += 'macdeployqt $${OUT_PWD}/$${TARGET}.app'
         #QMAKE_POST_LINK += 'macdeployqt $${OUT_PWD}/$${TARGET}.app && rm $${OUT_PWD}/*.o && rm $${OUT_PWD}/Makefile'
@@ -0,0 +1,109 @@
+/*
+ * File: biginteger-bench.cpp
+ * --------------------------
+ * Times BigInteger on n-digit by n-digit operands for n = 10^3, 10^4, ...
+ * up to a limit (10^5 by default): converting from a string, multiplying,
+ * dividing the 2n-digit product by an n-digit number, taking the remainder,
+ * and converting back to a string.  Every result is checked, so the run
+ * also exercises Karatsuba multiplication, Knuth division and the
+ * recursive decimal conversions on large inputs.
+ *
+ * From the top of the repository:
+ *
+ *   g++ -std=c++11 -O2 $FLAGS bench/biginteger-bench.cpp $SOURCES -ldl -lpthread -o biginteger-bench
+ *   ./biginteger-bench            # up to 10^5 digits
+ *   ./biginteger-bench 1000000    # up to 10^6 digits; division and printing take about a minute
+ *
+ * where
+ *
+ *   FLAGS="-D__StanfordCppLibraryInitializer_created -Ilib/StanfordCPPLib \
+ *          -Ilib/StanfordCPPLib/collections -Ilib/StanfordCPPLib/graphics -Ilib/StanfordCPPLib/io \
+ *          -Ilib/StanfordCPPLib/system -Ilib/StanfordCPPLib/util"
+ *   SOURCES="$(find lib/StanfordCPPLib -name '*.cpp')"
+ *
+ * Defining __StanfordCppLibraryInitializer_created keeps the library from
+ * starting its Java back end, which BigInteger never needs.  It prints one
+ * line of times (best of three runs below 10^5 digits) per size, and exits
+ * with status 1 if any result is wrong.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "biginteger.h"
+
+// biginteger.h brings in the library's wrapper around main(), which this file replaces
+#undef main
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what, int digits) {
+    if (!ok) {
+        std::printf("FAIL: %s at %d digits\n", what.c_str(), digits);
+        failures++;
+    }
+}
+
+static std::string randomDigits(std::mt19937& rng, int digits) {
+    std::string s(digits, '0');
+    s[0] = (char) ('1' + rng() % 9);
+    for (int i = 1; i < digits; i++) {
+        s[i] = (char) ('0' + rng() % 10);
+    }
+    return s;
+}
+
+/*
+ * Runs op reps times and returns the fastest time in milliseconds.
+ */
+template <typename Op>
+static double bestOf(int reps, Op op) {
+    double best = 0;
+    for (int i = 0; i < reps; i++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        op();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || ms < best) {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    int maxDigits = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::mt19937 rng(20261017);
+    std::printf("%9s %10s %10s %10s %10s %10s\n", "digits", "parse ms", "mul ms", "div ms", "mod ms", "print ms");
+    for (int digits = 1000; digits <= maxDigits; digits *= 10) {
+        int reps = digits < 100000 ? 3 : 1;
+        std::string aText = randomDigits(rng, digits);
+        std::string bText = randomDigits(rng, digits);
+        BigInteger a;
+        BigInteger b;
+        BigInteger product;
+        BigInteger quotient;
+        BigInteger remainder;
+        std::string printed;
+
+        double parseMs = bestOf(reps, [&]() { a = BigInteger(aText); });
+        b = BigInteger(bText);
+        double mulMs = bestOf(reps, [&]() { product = a * b; });
+        BigInteger offset = b - BigInteger(1);   // a remainder that isn't zero
+        BigInteger dividend = product + offset;
+        double divMs = bestOf(reps, [&]() { quotient = dividend / b; });
+        double modMs = bestOf(reps, [&]() { remainder = dividend % b; });
+        double printMs = bestOf(reps, [&]() { printed = a.toString(); });
+
+        check(printed == aText, "toString(BigInteger(s)) == s", digits);
+        check(quotient == a, "(a * b + b - 1) / b == a", digits);
+        check(remainder == offset, "(a * b + b - 1) % b == b - 1", digits);
+        check(product.toString().length() >= (size_t) (2 * digits - 1), "length of a * b", digits);
+        std::printf("%9d %10.2f %10.2f %10.2f %10.2f %10.2f\n", digits, parseMs, mulMs, divMs, modMs, printMs);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+/*
+ * File: console-bench.cpp
+ * -----------------------
+ * Counts the pipe commands that text written to the graphical console
+ * costs.  The back end isn't needed: putConsole is replaced by a stub that
+ * builds the same JBEConsole.print command as the real one in platform.cpp
+ * and counts the commands and bytes it would send, and that keeps the text
+ * that would appear in the console.  It writes 200,000 lines like the
+ * solver's through ConsoleStreambuf, once flushed every 1000 lines and once
+ * flushed every line as std::endl does, and does the same through
+ * LineStreambuf, a copy of the 2016 ConsoleStreambuf that sent one print
+ * and one println per line.  It then checks that the console text is the
+ * same both ways, and that text sent to cerr between cout lines lands in
+ * the right place.
+ *
+ * From the top of the repository:
+ *
+ *   g++ -std=c++11 -O2 -D__StanfordCppLibraryInitializer_created -Ilib/StanfordCPPLib -Ilib/StanfordCPPLib/system -Ilib/StanfordCPPLib/util \
+ *       bench/console-bench.cpp lib/StanfordCPPLib/util/strlib.cpp -o console-bench
+ *   ./console-bench
+ *
+ * It prints the commands, bytes and time for each run, and exits with
+ * status 1 if any check fails.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "strlib.h"
+
+// strlib.h brings in the library's wrapper around main(), which this file replaces
+#undef main
+
+/*
+ * Stand-ins for the library functions that the stream buffers call, so that
+ * this file needs nothing from the library but strlib.cpp.
+ */
+void error(const std::string& msg) {
+    throw std::runtime_error(msg);
+}
+
+namespace stanfordcpplib {
+
+// What the back end would have received and shown
+static long pipeCommands = 0;
+static size_t pipeBytes = 0;
+static std::string screen;          // cerr text is marked <err>...</err>
+static bool screenIsStderr = false;
+
+static void show(const std::string& str, bool isStderr) {
+    if (isStderr != screenIsStderr) {
+        screen += isStderr ? "<err>" : "</err>";
+        screenIsStderr = isStderr;
+    }
+    screen += str;
+}
+
+static void putPipe(const std::string& command) {
+    pipeCommands++;
+    pipeBytes += command.length() + 1;   // and the newline that ends it
+}
+
+/* The same command as putConsole in platform.cpp. */
+void putConsole(const std::string& str, bool isStderr) {
+    std::ostringstream os;
+    os << "JBEConsole.print(";
+    if (!str.empty() && str[str.length() - 1] == '\\') {
+        writeQuotedString(os, str + ' ');
+    } else {
+        writeQuotedString(os, str);
+    }
+    os << "," << std::boolalpha << isStderr << ")";
+    putPipe(os.str());
+    show(str, isStderr);
+}
+
+/* The same command as endLineConsole in platform.cpp. */
+void endLineConsole(bool isStderr) {
+    putPipe("JBEConsole.println()");
+    show("\n", isStderr);
+}
+
+std::string getLineConsole() {
+    return "";
+}
+
+} // namespace stanfordcpplib
+
+#include "private/consolestreambuf.h"
+#include "private/forwardingstreambuf.h"
+
+/*
+ * The output side of ConsoleStreambuf as it was before 2026/10/17, which
+ * sent each buffered line as a print followed by a println.
+ */
+class LineStreambuf : public std::streambuf {
+private:
+    static const int BUFFER_SIZE = 4096;
+    char outBuffer[BUFFER_SIZE];
+
+public:
+    LineStreambuf() {
+        setp(outBuffer, outBuffer + BUFFER_SIZE);
+    }
+
+    virtual int overflow(int ch = EOF) {
+        std::string line = "";
+        for (char* cp = pbase(); cp < pptr(); cp++) {
+            if (*cp == '\n') {
+                stanfordcpplib::putConsole(line, /* isStderr */ false);
+                stanfordcpplib::endLineConsole(/* isStderr */ false);
+                line = "";
+            } else {
+                line += *cp;
+            }
+        }
+        if (line != "") {
+            stanfordcpplib::putConsole(line, /* isStderr */ false);
+        }
+        setp(outBuffer, outBuffer + BUFFER_SIZE);
+        if (ch != EOF) {
+            outBuffer[0] = char(ch);
+            pbump(1);
+        }
+        return ch != EOF;
+    }
+
+    virtual int sync() {
+        return overflow();
+    }
+};
+
+static const int LINES = 200000;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+    std::printf("%s: %s\n", ok ? "PASS" : "FAIL", what.c_str());
+    if (!ok) {
+        failures++;
+    }
+}
+
+/*
+ * Writes the benchmark lines through buf, flushing every flushEvery lines,
+ * prints what it cost, and returns the console text.
+ */
+static std::string run(const char* name, std::streambuf& buf, int flushEvery) {
+    stanfordcpplib::pipeCommands = 0;
+    stanfordcpplib::pipeBytes = 0;
+    stanfordcpplib::screen.clear();
+    stanfordcpplib::screenIsStderr = false;
+    std::ostream out(&buf);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 1; i <= LINES; i++) {
+        out << "Chord " << i << ": I IV V7 vi ii6 V I  soprano 34 alto 29 tenor 22 bass 10\n";
+        if (i % flushEvery == 0) {
+            out.flush();
+        }
+    }
+    out.flush();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-34s %9ld commands %8.1f MB %8.0f ms\n", name, stanfordcpplib::pipeCommands,
+                stanfordcpplib::pipeBytes / 1e6, ms);
+    return stanfordcpplib::screen;
+}
+
+/*
+ * Writes to cout and cerr in turn the way the library sets them up, with
+ * cerr forwarding to the console buffer and unit-buffered.
+ */
+static void checkInterleaving() {
+    stanfordcpplib::screen.clear();
+    stanfordcpplib::screenIsStderr = false;
+    stanfordcpplib::ConsoleStreambuf console;
+    stanfordcpplib::ForwardingStreambuf forward(console, /* isStderr */ true);
+    std::ostream out(&console);
+    std::ostream err(&forward);
+    err.setf(std::ios::unitbuf);
+    out << "Solving chorale 1\n";
+    err << "warning: parallel fifths in bar " << 3 << "\n";
+    out << "Solving chorale 2\n";
+    out << "done\n" << std::flush;
+    check(stanfordcpplib::screen == "Solving chorale 1\n<err>warning: parallel fifths in bar 3\n</err>"
+                                    "Solving chorale 2\ndone\n",
+          "cerr text lands between the cout lines around it");
+}
+
+int main() {
+    std::string expected;
+    for (int flushEvery : { 1000, 1 }) {
+        std::printf("flushing every %d line(s):\n", flushEvery);
+        LineStreambuf lines;
+        stanfordcpplib::ConsoleStreambuf console;
+        std::string before = run("  one print + println per line", lines, flushEvery);
+        std::string after = run("  one print per flush", console, flushEvery);
+        check(before == after, "same console text both ways");
+        if (expected.empty()) {
+            expected = after;
+        } else {
+            check(after == expected, "same console text whatever the flushing");
+        }
+    }
+    checkInterleaving();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,335 @@
+/*
+ * File: chorale-fuzz.cpp
+ * ----------------------
+ * Fuzz targets for the chorale solver, in the libFuzzer interface
+ * (LLVMFuzzerTestOneInput plus a custom mutator). Each build fuzzes one
+ * target, picked by defining one of:
+ *
+ *   FUZZ_PARSER       getNotes, fed a session of typed answers on std::cin
+ *   FUZZ_PROGRESSION  createChordProgression on a well-formed bass line
+ *   FUZZ_CHORALE      createChordProgression, canCreateChorale, and the
+ *                     randomized restarts when the standard voicings fail
+ *
+ * With clang and libFuzzer, from the top of the repository:
+ *
+ *   clang++ -std=c++11 -g -O1 -fsanitize=fuzzer,address,undefined -DFUZZ_CHORALE $FLAGS \
+ *       fuzz/chorale-fuzz.cpp $SOURCES -ldl -lpthread -o fuzz-chorale
+ *   ./fuzz-chorale -max_total_time=60
+ *
+ * With gcc, link fuzz-driver.cpp instead of -fsanitize=fuzzer; it accepts
+ * the same -runs, -seed, -max_len and -timeout flags (see that file):
+ *
+ *   g++ -std=c++11 -g -O1 -fsanitize=address,undefined -fno-sanitize-recover=all -DFUZZ_CHORALE $FLAGS \
+ *       fuzz/chorale-fuzz.cpp fuzz/fuzz-driver.cpp $SOURCES -ldl -lpthread -o fuzz-chorale
+ *   ASAN_OPTIONS=abort_on_error=1 UBSAN_OPTIONS=abort_on_error=1 ./fuzz-chorale -runs=100000
+ *
+ * where
+ *
+ *   FLAGS="-D__StanfordCppLibraryInitializer_created -Isrc -Ilib/StanfordCPPLib \
+ *          -Ilib/StanfordCPPLib/collections -Ilib/StanfordCPPLib/graphics -Ilib/StanfordCPPLib/io \
+ *          -Ilib/StanfordCPPLib/system -Ilib/StanfordCPPLib/util"
+ *   SOURCES="$(find lib/StanfordCPPLib -name '*.cpp') src/chorale-archive.cpp src/pianoroll.cpp"
+ *
+ * Defining __StanfordCppLibraryInitializer_created keeps the library from
+ * starting its Java back end, which the solver's algorithms never need.
+ * chorale-solver.cpp is compiled as part of this file, so that its static
+ * functions can be called, with the keyboard display and pause() replaced
+ * by stand-ins that only check their arguments.
+ *
+ * Inputs are decoded so that every byte string is a well-formed bass line
+ * (or, for the parser, a session that ends in one), which keeps the fuzzer
+ * in the solver instead of in its input checks. The custom mutator makes
+ * musical edits to that encoding: adding a step, cutting or repeating a
+ * phrase, changing one note, and changing the key.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#define __DONT_ENABLE_GRAPHICAL_CONSOLE
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "console.h"
+#include "simpio.h"
+#include "gobjects.h"
+#include "choraledisplay.h"
+#include "chorale-archive.h"
+#include "chorale-constants.h"
+#include "filelib.h"
+#include "pianoroll.h"
+#include "random.h"
+#include "trace.h"
+#include "vector.h"
+
+#if !defined(FUZZ_PARSER) && !defined(FUZZ_PROGRESSION) && !defined(FUZZ_CHORALE)
+#error "define one of FUZZ_PARSER, FUZZ_PROGRESSION, or FUZZ_CHORALE"
+#endif
+
+/*
+ * Stand-in for the keyboard display: getNotes highlights every note it
+ * accepts, so only check that the note is on the keyboard.
+ */
+class FuzzDisplay {
+public:
+    void highlightKey(const int keyNumber, std::string /*color*/, bool /*flag*/) {
+        if (keyNumber < BASS_MIN || keyNumber > SOPRANO_MAX) {
+            abort();
+        }
+    }
+};
+
+static void fuzzPause(double /*milliseconds*/) {
+    // don't sleep between notes
+}
+
+#undef main
+#define main choraleSolverMain
+#define ChoraleDisplay FuzzDisplay
+#define pause fuzzPause
+#include "../src/chorale-solver.cpp"
+#undef pause
+#undef ChoraleDisplay
+#undef main
+
+extern "C" size_t LLVMFuzzerMutate(uint8_t* data, size_t size, size_t maxSize);
+
+// Longest bass line decoded from one input
+static const int MAX_NOTES = 2000;
+
+// Longest bass line that is also given to the randomized search, and its restarts
+static const int MAX_RANDOMIZED_NOTES = 60;
+static const int FUZZ_RESTARTS = 20;
+
+#ifdef FUZZ_PARSER
+
+/*
+ * Answers the parser is given, besides note numbers from -4 to 27: ways of
+ * finishing, and things that aren't notes at all.
+ */
+static const char* const MODE_ANSWERS[] = { "", "minor", "MINOR", "major", " minor" };
+static const char* const OTHER_ANSWERS[] = { "done", "DONE", " done", "x", "12abc", "3.5", "99999999999999", "", " 7 ", "-0", "+5" };
+
+/**
+ * Function: decodeSession
+ * -----------------------
+ * Turns fuzzer bytes into the lines typed during one call to getNotes. The first byte picks the answer to the major/minor question, and each later byte is a note number or one of OTHER_ANSWERS. The session always ends with each note from BASS_MIN to BASS_MAX typed twice and then "done", which finishes any bass line, so getNotes never waits for input that isn't there.
+ */
+
+static std::string decodeSession(const uint8_t* data, size_t size) {
+    std::ostringstream session;
+    const size_t modes = sizeof(MODE_ANSWERS) / sizeof(MODE_ANSWERS[0]);
+    const size_t others = sizeof(OTHER_ANSWERS) / sizeof(OTHER_ANSWERS[0]);
+    session << (size == 0 ? "" : MODE_ANSWERS[data[0] % modes]) << "\n";
+    for (size_t i = 1; i < size; ++i) {
+        if (data[i] < 0xc0) {
+            session << data[i] % 32 - 4 << "\n";
+        }
+        else {
+            session << OTHER_ANSWERS[(data[i] - 0xc0) % others] << "\n";
+        }
+    }
+    for (int note = BASS_MIN; note <= BASS_MAX; ++note) {
+        session << note << "\n" << note << "\n" << "done\n";
+    }
+    return session.str();
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    std::istringstream input(decodeSession(data, size));
+    std::ostringstream output;
+    std::streambuf* oldIn = std::cin.rdbuf(input.rdbuf());
+    std::streambuf* oldOut = std::cout.rdbuf(output.rdbuf());
+    FuzzDisplay display;
+    std::vector<int> bass = getNotes(display);
+    std::cin.rdbuf(oldIn);
+    std::cout.rdbuf(oldOut);
+
+    if (bass.size() < 3 || (bass.back() - bass[0]) % 12 != 0) {
+        abort();
+    }
+    for (int note: bass) {
+        if (note < BASS_MIN || note > BASS_MAX || notInScale(note, bass[0], majorKey)) {
+            abort();
+        }
+    }
+    return 0;
+}
+
+#else // FUZZ_PROGRESSION or FUZZ_CHORALE
+
+/**
+ * Function: scaleNotes
+ * --------------------
+ * Returns the notes of the bass range that are in the scale of startNote, from lowest to highest.
+ */
+
+static std::vector<int> scaleNotes(int startNote, bool major) {
+    std::vector<int> scale;
+    for (int note = BASS_MIN; note <= BASS_MAX; ++note) {
+        if (!notInScale(note, startNote, major)) {
+            scale.push_back(note);
+        }
+    }
+    return scale;
+}
+
+/**
+ * Function: decodeBassLine
+ * ------------------------
+ * Turns fuzzer bytes into a bass line that getNotes would accept, and sets majorKey. The low bit of the first byte picks major or minor, and the rest of it the starting note. Each following byte with its high bit set leaps to any note of the scale; otherwise it moves up to 7 scale steps from the previous note. The line is closed with the tonic nearest its last note, and padded to at least 3 notes.
+ */
+
+static std::vector<int> decodeBassLine(const uint8_t* data, size_t size) {
+    majorKey = size == 0 || (data[0] & 1) == 0;
+    int startNote = size == 0 ? BASS_MIN : BASS_MIN + (data[0] >> 1) % (BASS_MAX - BASS_MIN + 1);
+    std::vector<int> scale = scaleNotes(startNote, majorKey);
+    std::vector<int> bass = { startNote };
+    int position = (int) (std::find(scale.begin(), scale.end(), startNote) - scale.begin());
+    for (size_t i = 1; i < size && (int) bass.size() < MAX_NOTES - 1; ++i) {
+        if (data[i] & 0x80) {
+            position = (data[i] & 0x7f) % (int) scale.size();
+        }
+        else {
+            position += data[i] % 15 - 7;
+            position = std::max(0, std::min((int) scale.size() - 1, position));
+        }
+        bass.push_back(scale[position]);
+    }
+    if (bass.size() < 2) {
+        bass.push_back(startNote);
+    }
+    int tonic = startNote;
+    for (int note: scale) {
+        if ((note - startNote) % 12 == 0 && std::abs(note - bass.back()) < std::abs(tonic - bass.back())) {
+            tonic = note;
+        }
+    }
+    bass.push_back(tonic);
+    return bass;
+}
+
+/**
+ * Function: checkProgression
+ * --------------------------
+ * Aborts unless chords is a progression for bass that the rules allow: one chord per note, starting on I, ending on V-I, and every chord allowed to follow the one before it.
+ */
+
+static void checkProgression(const std::vector<int>& bass, const Vector<int>& chords, const std::vector<std::vector<int>>& chordRelations) {
+    if (chords.size() != (int) bass.size() || chords[0] != 1 || chords[chords.size() - 2] != 5 || chords[chords.size() - 1] != 1) {
+        abort();
+    }
+    for (int i = 0; i + 1 < chords.size(); ++i) {
+        const std::vector<int>& next = chordRelations[chords[i]];
+        if (std::find(next.begin(), next.end(), chords[i + 1]) == next.end()) {
+            abort();
+        }
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    std::vector<int> bass = decodeBassLine(data, size);
+    std::vector<std::vector<int>> chordRelations = setUpChordRels();
+    Vector<int> chords;
+    if (!createChordProgression(bass, chords, chordRelations)) {
+        return 0;
+    }
+    checkProgression(bass, chords, chordRelations);
+
+#ifdef FUZZ_CHORALE
+    std::vector<std::vector<int>> notesInChords = establishNotesInChords(bass[0], majorKey);
+    std::vector<int> soprano;
+    std::vector<int> alto;
+    std::vector<int> tenor;
+    if (canCreateChorale(chords, notesInChords, soprano, alto, tenor, bass)) {
+        if (soprano.size() != bass.size() || alto.size() != bass.size() || tenor.size() != bass.size()) {
+            abort();
+        }
+    }
+    else if ((int) bass.size() <= MAX_RANDOMIZED_NOTES) {
+        int restarts = 0;
+        int restartsRun = 0;
+        if (canCreateChoraleRandomized(chords, notesInChords, soprano, alto, tenor, bass, size, FUZZ_RESTARTS, 1, restarts, restartsRun)) {
+            // isGoodVoicing is the rule the search itself applies, so every chord of its answer must pass it
+            std::vector<int> chordList(chords.begin(), chords.end());
+            if (soprano.size() != bass.size() || restarts < 1 || restarts > restartsRun) {
+                abort();
+            }
+            for (int i = 0; i < (int) bass.size(); ++i) {
+                if (!isGoodVoicing(chordList, notesInChords, soprano, alto, tenor, bass, i, soprano[i], alto[i], tenor[i])) {
+                    abort();
+                }
+            }
+        }
+    }
+#endif // FUZZ_CHORALE
+    return 0;
+}
+
+#endif // FUZZ_PARSER
+
+/**
+ * Function: LLVMFuzzerCustomMutator
+ * ---------------------------------
+ * Makes one musical edit to an input: adds a step somewhere in the line, cuts a phrase, repeats a phrase elsewhere (as a sequence would), changes one note, or changes the key. One time in six it leaves the edit to the fuzzer's own byte mutations. The edits apply to the parser's sessions too, where each byte is one typed answer.
+ */
+
+extern "C" size_t LLVMFuzzerCustomMutator(uint8_t* data, size_t size, size_t maxSize, unsigned int seed) {
+    RandomGenerator rng(seed);
+    if (size == 0 || maxSize < 2) {
+        return LLVMFuzzerMutate(data, size, maxSize);
+    }
+    switch (rng.nextInteger(0, 5)) {
+    case 0: {
+        // Add a step of up to two scale degrees
+        if (size >= maxSize) break;
+        size_t at = (size_t) rng.nextInteger(1, (int) size);
+        std::copy_backward(data + at, data + size, data + size + 1);
+        data[at] = (uint8_t) (7 + rng.nextInteger(-2, 2));
+        return size + 1;
+    }
+    case 1: {
+        // Cut a phrase of up to 8 notes
+        if (size < 2) break;
+        size_t at = (size_t) rng.nextInteger(1, (int) size - 1);
+        size_t length = std::min(size - at, (size_t) rng.nextInteger(1, 8));
+        std::copy(data + at + length, data + size, data + at);
+        return size - length;
+    }
+    case 2: {
+        // Repeat a phrase of up to 8 notes somewhere else in the line
+        if (size < 2) break;
+        size_t from = (size_t) rng.nextInteger(1, (int) size - 1);
+        size_t length = std::min(std::min(size - from, maxSize - size), (size_t) rng.nextInteger(2, 8));
+        if (length == 0) break;
+        std::vector<uint8_t> phrase(data + from, data + from + length);
+        size_t at = (size_t) rng.nextInteger(1, (int) size);
+        std::copy_backward(data + at, data + size, data + size + length);
+        std::copy(phrase.begin(), phrase.end(), data + at);
+        return size + length;
+    }
+    case 3: {
+        // Change one note, to a step or a leap
+        if (size < 2) break;
+        size_t at = (size_t) rng.nextInteger(1, (int) size - 1);
+        data[at] = rng.nextBool() ? (uint8_t) rng.nextInteger(0, 14) : (uint8_t) (0x80 | rng.nextInteger(0, 0x7f));
+        return size;
+    }
+    case 4:
+        // Switch between major and minor, or move the starting note
+        data[0] = rng.nextBool() ? (uint8_t) (data[0] ^ 1) : (uint8_t) ((data[0] & 1) | rng.nextInteger(0, 0x7f) << 1);
+        return size;
+    default:
+        break;
+    }
+    return LLVMFuzzerMutate(data, size, maxSize);
+}
@@ -0,0 +1,213 @@
+/*
+ * File: fuzz-driver.cpp
+ * ---------------------
+ * A small stand-in for libFuzzer's main(), for building the targets in
+ * chorale-fuzz.cpp with gcc, which has no -fsanitize=fuzzer. It has no
+ * coverage feedback: it keeps a pool of inputs, grows it with some of the
+ * inputs it tries, and mutates them with the target's custom mutator. It
+ * understands the libFuzzer flags that make sense without coverage:
+ *
+ *   -runs=N      stop after N inputs (default 100000)
+ *   -seed=N      seed for the mutations (default 1), so a run can be repeated
+ *   -max_len=N   longest input to try (default 4096)
+ *   -timeout=N   treat an input that runs for N seconds as a hang (default 10)
+ *
+ * Any other arguments are files to run once each instead of fuzzing, which
+ * replays a crash or timeout file. exec/s is printed as the run goes, like
+ * libFuzzer does. When an input crashes or hangs it is written to
+ * crash-input or timeout-input before the program dies; run with
+ * ASAN_OPTIONS=abort_on_error=1 UBSAN_OPTIONS=abort_on_error=1 so that
+ * sanitizer errors end in abort() and are caught as well.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include "random.h"
+
+// random.h brings in the library's wrapper around main(), which this file replaces
+#undef main
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+extern "C" size_t LLVMFuzzerCustomMutator(uint8_t* data, size_t size, size_t maxSize, unsigned int seed);
+
+// Inputs kept to mutate from, at most
+static const size_t MAX_POOL = 1000;
+
+// One input in this many is added to the pool
+static const int POOL_ODDS = 16;
+
+static RandomGenerator mutationRng(1);
+
+// The input being run, for the signal handlers to save
+static const uint8_t* currentData = nullptr;
+static size_t currentSize = 0;
+
+/*
+ * Writes the current input to filename. Only calls functions that are
+ * safe in a signal handler.
+ */
+static void saveCurrentInput(const char* filename) {
+    int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return;
+    }
+    size_t written = 0;
+    while (written < currentSize) {
+        ssize_t n = write(fd, currentData + written, currentSize - written);
+        if (n <= 0) {
+            break;
+        }
+        written += (size_t) n;
+    }
+    close(fd);
+    const char message[] = "==fuzz-driver== input saved to ";
+    if (write(STDERR_FILENO, message, sizeof(message) - 1) < 0 || write(STDERR_FILENO, filename, strlen(filename)) < 0 || write(STDERR_FILENO, "\n", 1) < 0) {
+        // nothing more can be done from here
+    }
+}
+
+static void crashHandler(int sig) {
+    saveCurrentInput("crash-input");
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+static void timeoutHandler(int /*sig*/) {
+    saveCurrentInput("timeout-input");
+    _exit(1);
+}
+
+static void runOne(const std::vector<uint8_t>& input, unsigned int timeout) {
+    currentData = input.data();
+    currentSize = input.size();
+    alarm(timeout);
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+    alarm(0);
+}
+
+/*
+ * The byte-level mutations that libFuzzer would otherwise provide, which
+ * the custom mutator falls back on: flip a bit, set a byte, insert a byte,
+ * or erase a byte.
+ */
+extern "C" size_t LLVMFuzzerMutate(uint8_t* data, size_t size, size_t maxSize) {
+    if (size == 0) {
+        if (maxSize == 0) {
+            return 0;
+        }
+        data[0] = (uint8_t) mutationRng.nextInteger(0, 255);
+        return 1;
+    }
+    size_t at = (size_t) mutationRng.nextInteger(0, (int) size - 1);
+    switch (mutationRng.nextInteger(0, 3)) {
+    case 0:
+        data[at] = (uint8_t) (data[at] ^ 1 << mutationRng.nextInteger(0, 7));
+        return size;
+    case 1:
+        data[at] = (uint8_t) mutationRng.nextInteger(0, 255);
+        return size;
+    case 2:
+        if (size >= maxSize) {
+            return size;
+        }
+        memmove(data + at + 1, data + at, size - at);
+        data[at] = (uint8_t) mutationRng.nextInteger(0, 255);
+        return size + 1;
+    default:
+        if (size == 1) {
+            return size;
+        }
+        memmove(data + at, data + at + 1, size - at - 1);
+        return size - 1;
+    }
+}
+
+static bool readFlag(const std::string& arg, const std::string& name, long& value) {
+    if (arg.compare(0, name.size(), name) != 0) {
+        return false;
+    }
+    value = atol(arg.c_str() + name.size());
+    return true;
+}
+
+int main(int argc, char** argv) {
+    long runs = 100000;
+    long seed = 1;
+    long maxLen = 4096;
+    long timeout = 10;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (!readFlag(arg, "-runs=", runs) && !readFlag(arg, "-seed=", seed)
+                && !readFlag(arg, "-max_len=", maxLen) && !readFlag(arg, "-timeout=", timeout)) {
+            files.push_back(arg);
+        }
+    }
+    signal(SIGABRT, crashHandler);
+    signal(SIGSEGV, crashHandler);
+    signal(SIGBUS, crashHandler);
+    signal(SIGFPE, crashHandler);
+    signal(SIGILL, crashHandler);
+    signal(SIGALRM, timeoutHandler);
+
+    if (!files.empty()) {
+        for (const std::string& file: files) {
+            std::ifstream in(file.c_str(), std::ios::binary);
+            if (!in) {
+                std::cerr << "fuzz-driver: can't read " << file << std::endl;
+                return 1;
+            }
+            std::vector<uint8_t> input((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            std::cerr << "Running " << file << " (" << input.size() << " bytes)" << std::endl;
+            runOne(input, (unsigned int) timeout);
+        }
+        std::cerr << "Executed " << files.size() << " inputs" << std::endl;
+        return 0;
+    }
+
+    mutationRng = RandomGenerator((std::uint64_t) seed);
+    std::cerr << "Fuzzing with -seed=" << seed << " -runs=" << runs << " -max_len=" << maxLen << std::endl;
+    std::vector<std::vector<uint8_t>> pool(1, std::vector<uint8_t>(1, 0));
+    std::vector<uint8_t> input;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    long nextReport = 1;
+    for (long run = 1; run <= runs; ++run) {
+        input = pool[(size_t) mutationRng.nextInteger(0, (int) pool.size() - 1)];
+        size_t size = std::min(input.size(), (size_t) maxLen);
+        input.resize((size_t) maxLen);
+        size = LLVMFuzzerCustomMutator(input.data(), size, (size_t) maxLen, (unsigned int) mutationRng.nextInteger(0, 0x7fffffff));
+        input.resize(size);
+        runOne(input, (unsigned int) timeout);
+        if (mutationRng.nextInteger(1, POOL_ODDS) == 1) {
+            if (pool.size() < MAX_POOL) {
+                pool.push_back(input);
+            }
+            else {
+                pool[(size_t) mutationRng.nextInteger(0, (int) MAX_POOL - 1)] = input;
+            }
+        }
+        if (run == nextReport || run == runs) {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cerr << "#" << run << "\tpool: " << pool.size() << " exec/s: " << (long) (run / std::max(seconds, 1e-9)) << std::endl;
+            nextReport *= 2;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "Done " << runs << " runs in " << seconds << " second(s), exec/s: " << (long) (runs / std::max(seconds, 1e-9)) << std::endl;
+    return 0;
+}
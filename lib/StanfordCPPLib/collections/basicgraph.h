@@ -9,6 +9,8 @@
  * See BasicGraph.cpp for implementation of each member.
  *
  * @author Marty Stepp
+ * @version 2026/10/17
+ * - added freeze, which makes a FrozenGraph snapshot for fast traversal
  * @version 2017/11/14
  * - fix missing "this->" on some methods
  * - added getVertexNames, vertexCount, edgeCount
@@ -62,10 +64,13 @@
 #ifndef _basicgraph_h
 #define _basicgraph_h
 
+#include <algorithm>
 #include <initializer_list>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
+#include "frozengraph.h"
 #include "gmath.h"
 #include "graph.h"
 #include "grid.h"
@@ -263,6 +268,18 @@ public:
     bool containsEdge(EdgeGen<V, E>* edge) const;
     bool containsVertex(const std::string& name) const;
     bool containsVertex(VertexGen<V, E>* v) const;
+
+    /*
+     * Method: freeze
+     * Usage: FrozenGraph frozen = graph.freeze();
+     * -------------------------------------------
+     * Returns a read-only snapshot of this graph's current vertices, edges
+     * and edge costs in a compact array form that is much faster to
+     * traverse, and that provides breadth-first search, Dijkstra's
+     * algorithm and topological sorting.  See frozengraph.h.
+     */
+    FrozenGraph freeze() const;
+
     EdgeGen<V, E>* getEdge(VertexGen<V, E>* v1, VertexGen<V, E>* v2) const;
     EdgeGen<V, E>* getEdge(const std::string& v1, const std::string& v2) const;
     EdgeGen<V, E>* getInverseArc(EdgeGen<V, E>* edge) const;
@@ -597,6 +614,51 @@ int BasicGraphGen<V, E>::edgeCount() const {
     return this->arcCount();
 }
 
+/*
+ * Implementation notes: freeze
+ * ----------------------------
+ * The vertex set is ordered by name, so numbering the vertices in iteration
+ * order makes IDs alphabetical.  Each vertex's arc set is ordered by finish
+ * vertex name, and therefore by target ID, which lets FrozenGraph binary
+ * search a vertex's edges.
+ */
+template <typename V, typename E>
+FrozenGraph BasicGraphGen<V, E>::freeze() const {
+    FrozenGraph frozen;
+    int n = this->vertexCount();
+    frozen.names.reserve(n);
+    frozen.offsets.reserve(n + 1);
+    frozen.targets.reserve(this->edgeCount());
+    frozen.weights.reserve(this->edgeCount());
+    for (VertexGen<V, E>* v : this->getVertexSet()) {
+        frozen.ids.put(v->name, (int) frozen.names.size());
+        frozen.names.push_back(v->name);
+    }
+    std::vector<std::pair<int, double> > edges;
+    for (VertexGen<V, E>* v : this->getVertexSet()) {
+        edges.clear();
+        for (EdgeGen<V, E>* e : v->arcs) {
+            edges.push_back(std::make_pair(frozen.ids.get(e->finish->name), e->cost));
+            if (e->cost < 0.0) {
+                frozen.hasNegativeWeights = true;
+            }
+        }
+        // a vertex added with addVertex(v) may order its arcs differently
+        auto byTarget = [](const std::pair<int, double>& a, const std::pair<int, double>& b) {
+            return a.first < b.first;
+        };
+        if (!std::is_sorted(edges.begin(), edges.end(), byTarget)) {
+            std::stable_sort(edges.begin(), edges.end(), byTarget);
+        }
+        for (const std::pair<int, double>& edge : edges) {
+            frozen.targets.push_back(edge.first);
+            frozen.weights.push_back(edge.second);
+        }
+        frozen.offsets.push_back((int) frozen.targets.size());
+    }
+    return frozen;
+}
+
 template <typename V, typename E>
 EdgeGen<V, E>* BasicGraphGen<V, E>::getEdge(VertexGen<V, E>* v1, VertexGen<V, E>* v2) const {
     return this->getArc(v1, v2);
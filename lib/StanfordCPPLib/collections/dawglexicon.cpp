@@ -15,6 +15,8 @@
  * The DAWG builder code is quite a bit more intricate, see Julie Zelenski
  * if you need it.
  * 
+ * @version 2026/10/17
+ * - added a mapped binary format that is used in place via mmap
  * @version 2016/08/10
  * - added constructor support for std initializer_list usage, such as {"a", "b", "c"}
  * @version 2016/08/04
@@ -44,7 +46,35 @@
 #include "error.h"
 #include "hashcode.h"
 #include "strlib.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
+/*
+ * The mapped format is a MappedHeader followed by the edge array exactly
+ * as it is laid out in memory.  The header records the byte order and
+ * edge size of the machine that wrote it, plus the word count, so that a
+ * file can be checked and used without reading any of its edges.
+ */
+struct MappedHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t edgeSize;
+    uint32_t startIndex;
+    uint32_t numEdges;
+    uint32_t numWords;
+};
+
+static const char MAPPED_MAGIC[8] = {'D', 'A', 'W', 'G', 'M', 'A', 'P', '1'};
+static const uint32_t MAPPED_VERSION = 1;
+static const uint32_t MAPPED_BYTE_ORDER = 0x01020304;
+static const uint32_t MAX_EDGES = 1u << 24;   // children indexes are 24 bits
+
+static bool isValidMappedHeader(const MappedHeader& header, size_t edgeSize);
 static uint32_t my_ntohl(uint32_t arg);
 
 /*
@@ -64,7 +94,9 @@ DawgLexicon::DawgLexicon() :
         edges(nullptr),
         start(nullptr),
         numEdges(0),
-        numDawgWords(0) {
+        numDawgWords(0),
+        mappedData(nullptr),
+        mappedSize(0) {
     // empty
 }
 
@@ -72,7 +104,9 @@ DawgLexicon::DawgLexicon(std::istream& input) :
         edges(nullptr),
         start(nullptr),
         numEdges(0),
-        numDawgWords(0) {
+        numDawgWords(0),
+        mappedData(nullptr),
+        mappedSize(0) {
     addWordsFromFile(input);
 }
 
@@ -80,7 +114,9 @@ DawgLexicon::DawgLexicon(const std::string& filename) :
         edges(nullptr),
         start(nullptr),
         numEdges(0),
-        numDawgWords(0) {
+        numDawgWords(0),
+        mappedData(nullptr),
+        mappedSize(0) {
     addWordsFromFile(filename);
 }
 
@@ -88,7 +124,9 @@ DawgLexicon::DawgLexicon(const DawgLexicon& src) :
         edges(nullptr),
         start(nullptr),
         numEdges(0),
-        numDawgWords(0) {
+        numDawgWords(0),
+        mappedData(nullptr),
+        mappedSize(0) {
     deepCopy(src);
 }
 
@@ -96,14 +134,14 @@ DawgLexicon::DawgLexicon(std::initializer_list<std::string> list) :
         edges(nullptr),
         start(nullptr),
         numEdges(0),
-        numDawgWords(0) {
+        numDawgWords(0),
+        mappedData(nullptr),
+        mappedSize(0) {
     addAll(list);
 }
 
 DawgLexicon::~DawgLexicon() {
-    if (edges) {
-        delete[] edges;
-    }
+    freeEdges();
 }
 
 void DawgLexicon::add(const std::string& word) {
@@ -133,18 +171,24 @@ DawgLexicon& DawgLexicon::addAll(std::initializer_list<std::string> list) {
  * otherwise assume ASCII, one word per line
  */
 void DawgLexicon::addWordsFromFile(std::istream& input) {
-    char firstFour[4], expected[] = "DAWG";
+    char firstEight[8], expected[] = "DAWG";
     if (input.fail()) {
         error("DawgLexicon::addWordsFromFile: Couldn't read input");
     }
-    input.read(firstFour, 4);
-    if (strncmp(firstFour, expected, 4) == 0) {
+    input.read(firstEight, 8);
+    if (input.gcount() == 8 && memcmp(firstEight, MAPPED_MAGIC, 8) == 0) {
+        if (otherWords.size() != 0 || edges) {
+            error("DawgLexicon::addWordsFromFile: Binary files require an empty lexicon");
+        }
+        readMappedFile(input);
+    } else if (input.gcount() >= 4 && strncmp(firstEight, expected, 4) == 0) {
         if (otherWords.size() != 0) {
             error("DawgLexicon::addWordsFromFile: Binary files require an empty lexicon");
         }
         readBinaryFile(input);
     } else {
         // plain text file
+        input.clear();
         input.seekg(0);
         std::string line;
         while (getline(input, line)) {
@@ -158,6 +202,9 @@ void DawgLexicon::addWordsFromFile(std::istream& input) {
  * otherwise assume ASCII, one word per line
  */
 void DawgLexicon::addWordsFromFile(const std::string& filename) {
+    if (mapFile(filename)) {
+        return;
+    }
     std::ifstream input(filename.c_str());
     if (input.fail()) {
         error("DawgLexicon::addWordsFromFile: Couldn't open lexicon file " + filename);
@@ -167,10 +214,7 @@ void DawgLexicon::addWordsFromFile(const std::string& filename) {
 }
 
 void DawgLexicon::clear() {
-    if (edges) {
-        delete[] edges;
-    }
-    edges = start = nullptr;
+    freeEdges();
     numEdges = numDawgWords = 0;
     otherWords.clear();
 }
@@ -282,6 +326,29 @@ std::string DawgLexicon::toString() const {
     return out.str();
 }
 
+void DawgLexicon::writeMappedFile(const std::string& filename) const {
+    if (!otherWords.isEmpty()) {
+        error("DawgLexicon::writeMappedFile: words added with add cannot be written to a mapped file");
+    }
+    MappedHeader header;
+    memcpy(header.magic, MAPPED_MAGIC, sizeof(header.magic));
+    header.version = MAPPED_VERSION;
+    header.byteOrder = MAPPED_BYTE_ORDER;
+    header.edgeSize = sizeof(Edge);
+    header.startIndex = start ? uint32_t(start - edges) : 0;
+    header.numEdges = edges ? uint32_t(numEdges) : 0;
+    header.numWords = edges ? uint32_t(numDawgWords) : 0;
+    std::ofstream output(filename.c_str(), std::ios::out | std::ios::binary);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (header.numEdges > 0) {
+        output.write(reinterpret_cast<const char*>(edges), std::streamsize(sizeof(Edge) * header.numEdges));
+    }
+    output.close();
+    if (output.fail()) {
+        error("DawgLexicon::writeMappedFile: Couldn't write lexicon file " + filename);
+    }
+}
+
 std::set<std::string> DawgLexicon::toStlSet() const {
     std::set<std::string> result;
     for (std::string word : *this) {
@@ -384,6 +451,23 @@ void DawgLexicon::deepCopy(const DawgLexicon& src) {
     otherWords = src.otherWords;
 }
 
+/*
+ * Releases the edge array, which is either on the heap or in a mapped file.
+ */
+void DawgLexicon::freeEdges() {
+    if (mappedData) {
+#ifndef _WIN32
+        munmap(mappedData, mappedSize);
+#endif
+        mappedData = nullptr;
+        mappedSize = 0;
+    } else if (edges) {
+        delete[] edges;
+    }
+    edges = start = nullptr;
+    numEdges = numDawgWords = 0;
+}
+
 /*
  * Implementation notes: findEdgeForChar
  * -------------------------------------
@@ -467,6 +551,88 @@ void DawgLexicon::readBinaryFile(const std::string& filename) {
     input.close();
 }
 
+/*
+ * Implementation notes: mapFile
+ * -----------------------------
+ * Maps a file in the mapped format read-only and points the edge array
+ * into it, after checking its header and size.  Returns false if the file
+ * is not in that format (or cannot be mapped) so that the caller can read
+ * it as a stream instead.  The edges themselves are trusted, just as they
+ * are when read from the stream formats.
+ */
+bool DawgLexicon::mapFile(const std::string& filename) {
+#ifdef _WIN32
+    (void) filename;
+    return false;
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    MappedHeader header;
+    if (fstat(fd, &info) != 0 || info.st_size < off_t(sizeof(header))
+            || pread(fd, &header, sizeof(header), 0) != ssize_t(sizeof(header))
+            || memcmp(header.magic, MAPPED_MAGIC, sizeof(header.magic)) != 0) {
+        close(fd);
+        return false;
+    }
+    if (otherWords.size() != 0 || edges) {
+        close(fd);
+        error("DawgLexicon::addWordsFromFile: Binary files require an empty lexicon");
+    }
+    size_t size = size_t(info.st_size);
+    if (!isValidMappedHeader(header, sizeof(Edge))
+            || size != sizeof(header) + sizeof(Edge) * header.numEdges) {
+        close(fd);
+        error("DawgLexicon::addWordsFromFile: Improperly formed lexicon file " + filename);
+    }
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    mappedData = data;
+    mappedSize = size;
+    if (header.numEdges > 0) {
+        edges = reinterpret_cast<Edge*>(static_cast<char*>(data) + sizeof(header));
+        start = &edges[header.startIndex];
+    }
+    numEdges = int(header.numEdges);
+    numDawgWords = int(header.numWords);
+    return true;
+#endif
+}
+
+/*
+ * Implementation notes: readMappedFile
+ * ------------------------------------
+ * Reads a file in the mapped format from a stream into a heap array.  This
+ * is used when the file cannot be mapped, such as when reading from a
+ * stream rather than a named file.
+ */
+void DawgLexicon::readMappedFile(std::istream& input) {
+    input.clear();
+    input.seekg(0, std::ios::beg);
+    MappedHeader header;
+    input.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (input.fail() || !isValidMappedHeader(header, sizeof(Edge))) {
+        error("DawgLexicon::addWordsFromFile: Improperly formed lexicon file");
+    }
+    if (header.numEdges > 0) {
+        edges = new Edge[header.numEdges];
+        std::streamsize numBytes = std::streamsize(sizeof(Edge) * header.numEdges);
+        input.read(reinterpret_cast<char*>(edges), numBytes);
+        if (input.gcount() != numBytes) {
+            freeEdges();
+            error("DawgLexicon::addWordsFromFile: Improperly formed lexicon file");
+        }
+        start = &edges[header.startIndex];
+    }
+    numEdges = int(header.numEdges);
+    numDawgWords = int(header.numWords);
+}
+
 /*
  * Implementation notes: traceToLastEdge
  * -------------------------------------
@@ -491,9 +657,7 @@ DawgLexicon::Edge* DawgLexicon::traceToLastEdge(const std::string& s) const {
 
 DawgLexicon& DawgLexicon::operator =(const DawgLexicon& src) {
     if (this != &src) {
-        if (edges) {
-            delete[] edges;
-        }
+        freeEdges();
         deepCopy(src);
     }
     return *this;
@@ -552,6 +716,20 @@ int hashCode(const DawgLexicon& lex) {
     return stanfordcpplib::collections::hashCodeCollection(lex);
 }
 
+/*
+ * Returns true if a mapped file header was written by a compatible machine
+ * and describes a well-formed edge array.
+ */
+static bool isValidMappedHeader(const MappedHeader& header, size_t edgeSize) {
+    return memcmp(header.magic, MAPPED_MAGIC, sizeof(header.magic)) == 0
+            && header.version == MAPPED_VERSION
+            && header.byteOrder == MAPPED_BYTE_ORDER
+            && header.edgeSize == edgeSize
+            && header.numEdges <= MAX_EDGES
+            && (header.numEdges == 0 ? header.startIndex == 0 : header.startIndex < header.numEdges)
+            && header.numWords <= 0x7fffffffu;
+}
+
 /*
  * Swaps a 4-byte long from big to little endian byte order
  */
@@ -4,6 +4,8 @@
  * This file exports the <code>DawgLexicon</code> class, which is a
  * compact structure for storing a list of words.
  * 
+ * @version 2026/10/17
+ * - added a memory-mapped binary format and writeMappedFile
  * @version 2017/11/14
  * - added iterator version checking support
  * @version 2017/10/18
@@ -78,8 +80,9 @@ public:
      * ---------------------------------
      * Initializes a new lexicon.  The default constructor creates an empty
      * lexicon.  The second form reads in the contents of the lexicon from
-     * the specified data file.  The data file must be in one of two formats:
-     * (1) a space-efficient precompiled binary format or (2) a text file
+     * the specified data file.  The data file must be in one of three formats:
+     * (1) a space-efficient precompiled binary format, (2) the mapped binary
+     * format written by <code>writeMappedFile</code>, or (3) a text file
      * containing one word per line.  The Stanford library distribution
      * includes a binary lexicon file named <code>English.dat</code>
      * containing a list of words in English.  The standard code pattern
@@ -139,6 +142,9 @@ public:
      * Usage: lex.addWordsFromFile(filename);
      * --------------------------------------
      * Reads the file and adds all of its words to the lexicon.
+     * A file in the mapped format is not read at all; it is mapped into
+     * memory and searched in place, so loading it takes constant time and
+     * its pages are shared by every process that maps the same file.
      */
     void addWordsFromFile(const std::string& filename);
     
@@ -274,6 +280,19 @@ public:
      */
     std::string toString() const;
     
+    /*
+     * Method: writeMappedFile
+     * Usage: lex.writeMappedFile(filename);
+     * -------------------------------------
+     * Writes the lexicon to the given file in the mapped binary format,
+     * which <code>addWordsFromFile</code> can map into memory directly.
+     * The file holds the lexicon's DAWG exactly as it is laid out in memory,
+     * so it must be read on a machine with the same byte order.  Only words
+     * loaded from a binary file can be written; if any words were added
+     * with <code>add</code>, this method signals an error.
+     */
+    void writeMappedFile(const std::string& filename) const;
+
     /*
      * Operators: ==, !=
      * Usage: if (lex1 == lex2) ...
@@ -389,6 +408,8 @@ private:
     int numEdges;
     int numDawgWords;
     Set<std::string> otherWords;
+    void* mappedData;      // mapped file holding edges, or nullptr if edges is on the heap
+    size_t mappedSize;
 
 public:
     /*
@@ -526,6 +547,9 @@ private:
     void readBinaryFile(const std::string& filename);
     void deepCopy(const DawgLexicon& src);
     int countDawgWords(Edge* start) const;
+    void freeEdges();
+    bool mapFile(const std::string& filename);
+    void readMappedFile(std::istream& input);
 
     unsigned int charToOrd(char ch) const {
         return ((unsigned int)(tolower(ch) - 'a' + 1));
@@ -0,0 +1,249 @@
+/*
+ * File: frozengraph.cpp
+ * ---------------------
+ * This file implements the frozengraph.h interface.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include "frozengraph.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include "collections.h"
+#include "error.h"
+#include "gmath.h"
+#include "priorityqueue.h"
+#include "strlib.h"
+
+FrozenGraph::FrozenGraph()
+        : offsets(1, 0),
+          hasNegativeWeights(false) {
+    // empty
+}
+
+void FrozenGraph::breadthFirstSearch(int start, Vector<int>& distance, Vector<int>& previous) const {
+    checkVertex(start, "breadthFirstSearch");
+    int n = vertexCount();
+    std::vector<int> dist(n, -1);
+    std::vector<int> prev(n, -1);
+
+    // every vertex enters the queue at most once, so a flat array with
+    // a read index is all the queue needs
+    std::vector<int> queue;
+    queue.reserve(n);
+    queue.push_back(start);
+    dist[start] = 0;
+    for (int head = 0; head < (int) queue.size(); head++) {
+        int v = queue[head];
+        for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+            int w = targets[e];
+            if (dist[w] < 0) {
+                dist[w] = dist[v] + 1;
+                prev[w] = v;
+                queue.push_back(w);
+            }
+        }
+    }
+    distance = Vector<int>(dist);
+    previous = Vector<int>(prev);
+}
+
+void FrozenGraph::checkEdge(int e, const char* member) const {
+    if (e < 0 || e >= edgeCount()) {
+        error(std::string("FrozenGraph::") + member + ": edge number "
+              + integerToString(e) + " is outside range [0.."
+              + integerToString(edgeCount() - 1) + "]");
+    }
+}
+
+void FrozenGraph::checkVertex(int v, const char* member) const {
+    if (v < 0 || v >= vertexCount()) {
+        error(std::string("FrozenGraph::") + member + ": vertex ID "
+              + integerToString(v) + " is outside range [0.."
+              + integerToString(vertexCount() - 1) + "]");
+    }
+}
+
+bool FrozenGraph::containsEdge(int v1, int v2) const {
+    checkVertex(v1, "containsEdge");
+    checkVertex(v2, "containsEdge");
+    const int* first = targets.data() + offsets[v1];
+    const int* last = targets.data() + offsets[v1 + 1];
+    return std::binary_search(first, last, v2);
+}
+
+/*
+ * Implementation notes: dijkstra
+ * ------------------------------
+ * Each vertex is enqueued once, when it is first reached, and its priority
+ * is lowered through its handle when a cheaper path turns up, so the queue
+ * never holds more than V entries.
+ */
+void FrozenGraph::dijkstra(int start, Vector<double>& distance, Vector<int>& previous) const {
+    checkVertex(start, "dijkstra");
+    if (hasNegativeWeights) {
+        error("FrozenGraph::dijkstra: graph has negative edge weights");
+    }
+    int n = vertexCount();
+    std::vector<double> dist(n, std::numeric_limits<double>::infinity());
+    std::vector<int> prev(n, -1);
+    std::vector<bool> done(n, false);
+    std::vector<PriorityQueue<int>::Handle> handles(n);
+
+    PriorityQueue<int> pq;
+    dist[start] = 0.0;
+    handles[start] = pq.enqueueWithHandle(start, 0.0);
+    while (!pq.isEmpty()) {
+        int v = pq.dequeue();
+        done[v] = true;
+        for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+            int w = targets[e];
+            double newDist = dist[v] + weights[e];
+            if (done[w] || newDist >= dist[w]) {
+                continue;
+            }
+            if (std::isinf(dist[w])) {
+                handles[w] = pq.enqueueWithHandle(w, newDist);
+            } else {
+                pq.changePriority(handles[w], newDist);
+            }
+            dist[w] = newDist;
+            prev[w] = v;
+        }
+    }
+    distance = Vector<double>(dist);
+    previous = Vector<int>(prev);
+}
+
+int FrozenGraph::edgeBegin(int v) const {
+    checkVertex(v, "edgeBegin");
+    return offsets[v];
+}
+
+int FrozenGraph::edgeCount() const {
+    return (int) targets.size();
+}
+
+int FrozenGraph::edgeEnd(int v) const {
+    checkVertex(v, "edgeEnd");
+    return offsets[v + 1];
+}
+
+int FrozenGraph::edgeSource(int e) const {
+    checkEdge(e, "edgeSource");
+    // the last vertex whose first edge is at or before e; vertices with no
+    // edges share their offset with the next vertex, which upper_bound skips
+    return (int) (std::upper_bound(offsets.begin(), offsets.end(), e) - offsets.begin()) - 1;
+}
+
+int FrozenGraph::edgeTarget(int e) const {
+    checkEdge(e, "edgeTarget");
+    return targets[e];
+}
+
+double FrozenGraph::edgeWeight(int e) const {
+    checkEdge(e, "edgeWeight");
+    return weights[e];
+}
+
+int FrozenGraph::getVertexId(const std::string& name) const {
+    return ids.containsKey(name) ? ids.get(name) : -1;
+}
+
+const std::string& FrozenGraph::getVertexName(int v) const {
+    checkVertex(v, "getVertexName");
+    return names[v];
+}
+
+bool FrozenGraph::isEmpty() const {
+    return names.empty();
+}
+
+int FrozenGraph::outDegree(int v) const {
+    checkVertex(v, "outDegree");
+    return offsets[v + 1] - offsets[v];
+}
+
+/*
+ * Implementation notes: topologicalSort
+ * -------------------------------------
+ * Kahn's algorithm: repeatedly take a vertex that no remaining edge leads
+ * to.  A min-heap of the ready vertices keeps the order deterministic and
+ * makes lower IDs come first.  If vertices are left over, they are all on
+ * or behind a cycle.
+ */
+Vector<int> FrozenGraph::topologicalSort() const {
+    int n = vertexCount();
+    std::vector<int> inDegree(n, 0);
+    for (int w : targets) {
+        inDegree[w]++;
+    }
+    std::vector<int> ready;
+    for (int v = 0; v < n; v++) {
+        if (inDegree[v] == 0) {
+            ready.push_back(v);
+        }
+    }
+    std::greater<int> later;
+    std::make_heap(ready.begin(), ready.end(), later);
+
+    std::vector<int> order;
+    order.reserve(n);
+    while (!ready.empty()) {
+        std::pop_heap(ready.begin(), ready.end(), later);
+        int v = ready.back();
+        ready.pop_back();
+        order.push_back(v);
+        for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+            int w = targets[e];
+            if (--inDegree[w] == 0) {
+                ready.push_back(w);
+                std::push_heap(ready.begin(), ready.end(), later);
+            }
+        }
+    }
+    if ((int) order.size() != n) {
+        error("FrozenGraph::topologicalSort: graph contains a cycle");
+    }
+    return Vector<int>(order);
+}
+
+std::string FrozenGraph::toString() const {
+    std::ostringstream os;
+    os << *this;
+    return os.str();
+}
+
+int FrozenGraph::vertexCount() const {
+    return (int) names.size();
+}
+
+std::ostream& operator <<(std::ostream& os, const FrozenGraph& graph) {
+    os << "{";
+    int n = graph.vertexCount();
+    for (int v = 0; v < n; v++) {
+        if (v > 0) {
+            os << ", ";
+        }
+        const std::string& name = graph.getVertexName(v);
+        writeGenericValue(os, name, stringIsInteger(name) || stringIsReal(name));
+    }
+    for (int v = 0; v < n; v++) {
+        const std::string& start = graph.getVertexName(v);
+        for (int e = graph.edgeBegin(v); e < graph.edgeEnd(v); e++) {
+            const std::string& finish = graph.getVertexName(graph.edgeTarget(e));
+            os << ", ";
+            writeGenericValue(os, start, stringIsInteger(start) || stringIsReal(start));
+            os << " -> ";
+            writeGenericValue(os, finish, stringIsInteger(finish) || stringIsReal(finish));
+            if (!floatingPointEqual(graph.edgeWeight(e), 0.0)) {
+                os << " : " << graph.edgeWeight(e);
+            }
+        }
+    }
+    return os << "}";
+}
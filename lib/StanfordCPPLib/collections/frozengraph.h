@@ -0,0 +1,236 @@
+/*
+ * File: frozengraph.h
+ * -------------------
+ * This file exports the <code>FrozenGraph</code> class, an immutable
+ * snapshot of a <code>BasicGraph</code> that is laid out for fast traversal.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#ifndef _frozengraph_h
+#define _frozengraph_h
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "hashmap.h"
+#include "vector.h"
+
+template <typename V, typename E>
+class BasicGraphGen;
+
+/*
+ * Class: FrozenGraph
+ * ------------------
+ * This class is a read-only copy of a graph, made by calling
+ * <code>freeze</code> on a <code>BasicGraph</code>.  Vertices are numbered
+ * from 0 to <code>vertexCount() - 1</code> in alphabetical order of their
+ * names, which is the order in which the graph iterates over them.  The
+ * edges are stored in compressed sparse row form: the edges leaving each
+ * vertex are numbered consecutively, and edge <i>k</i>'s target vertex and
+ * weight are entries <i>k</i> of two flat arrays.  Walking a vertex's
+ * edges therefore reads adjacent memory instead of following the pointers
+ * of a tree of arcs, which makes traversals many times faster.
+ *
+ * The snapshot does not change when the original graph changes.
+ *
+ *<pre>
+ *    FrozenGraph frozen = graph.freeze();
+ *    int v = frozen.getVertexId("C");
+ *    for (int e = frozen.edgeBegin(v); e < frozen.edgeEnd(v); e++) {
+ *        int neighbor = frozen.edgeTarget(e);
+ *        double cost = frozen.edgeWeight(e);
+ *        ...
+ *    }
+ *</pre>
+ */
+class FrozenGraph {
+public:
+    /*
+     * Constructor: FrozenGraph
+     * Usage: FrozenGraph frozen;
+     * --------------------------
+     * Creates an empty graph with no vertices.
+     */
+    FrozenGraph();
+
+    /*
+     * Method: breadthFirstSearch
+     * Usage: frozen.breadthFirstSearch(start, distance, previous);
+     * ------------------------------------------------------------
+     * Visits the vertices reachable from the start vertex in breadth-first
+     * order.  Afterward, <code>distance[v]</code> is the number of edges on
+     * a shortest path from start to v, and <code>previous[v]</code> is the
+     * vertex before v on that path.  Both are -1 for vertices that cannot
+     * be reached, and <code>previous[start]</code> is -1.
+     * Throws an error if start is not a valid vertex ID.
+     */
+    void breadthFirstSearch(int start, Vector<int>& distance, Vector<int>& previous) const;
+
+    /*
+     * Method: containsEdge
+     * Usage: if (frozen.containsEdge(v1, v2)) ...
+     * -------------------------------------------
+     * Returns true if there is an edge from vertex v1 to vertex v2.
+     * This takes O(log D) time, where D is the number of edges leaving v1.
+     * Throws an error if either vertex ID is invalid.
+     */
+    bool containsEdge(int v1, int v2) const;
+
+    /*
+     * Method: dijkstra
+     * Usage: frozen.dijkstra(start, distance, previous);
+     * --------------------------------------------------
+     * Finds the cheapest paths from the start vertex to every other vertex,
+     * using edge weights as costs.  Afterward, <code>distance[v]</code> is
+     * the total weight of a cheapest path from start to v, and
+     * <code>previous[v]</code> is the vertex before v on that path.
+     * Vertices that cannot be reached have an infinite distance and a
+     * previous vertex of -1.
+     * Throws an error if start is not a valid vertex ID or if any edge has
+     * a negative weight.
+     */
+    void dijkstra(int start, Vector<double>& distance, Vector<int>& previous) const;
+
+    /*
+     * Method: edgeBegin, edgeEnd
+     * Usage: for (int e = frozen.edgeBegin(v); e < frozen.edgeEnd(v); e++) ...
+     * -----------------------------------------------------------------------
+     * Return the range of edge numbers of the edges leaving vertex v.
+     * The edges are ordered by target vertex.
+     * Throws an error if v is not a valid vertex ID.
+     */
+    int edgeBegin(int v) const;
+    int edgeEnd(int v) const;
+
+    /*
+     * Method: edgeCount
+     * Usage: int count = frozen.edgeCount();
+     * --------------------------------------
+     * Returns the number of edges in the graph.
+     */
+    int edgeCount() const;
+
+    /*
+     * Method: edgeSource
+     * Usage: int v = frozen.edgeSource(e);
+     * ------------------------------------
+     * Returns the vertex that edge number e leaves from.  This takes
+     * O(log V) time; loops over edgeBegin/edgeEnd already know it.
+     * Throws an error if e is not a valid edge number.
+     */
+    int edgeSource(int e) const;
+
+    /*
+     * Method: edgeTarget
+     * Usage: int v = frozen.edgeTarget(e);
+     * ------------------------------------
+     * Returns the vertex that edge number e leads to.
+     * Throws an error if e is not a valid edge number.
+     */
+    int edgeTarget(int e) const;
+
+    /*
+     * Method: edgeWeight
+     * Usage: double cost = frozen.edgeWeight(e);
+     * ------------------------------------------
+     * Returns the weight (cost) of edge number e.
+     * Throws an error if e is not a valid edge number.
+     */
+    double edgeWeight(int e) const;
+
+    /*
+     * Method: getVertexId
+     * Usage: int v = frozen.getVertexId(name);
+     * ----------------------------------------
+     * Returns the ID of the vertex with the given name, or -1 if there is
+     * no such vertex.
+     */
+    int getVertexId(const std::string& name) const;
+
+    /*
+     * Method: getVertexName
+     * Usage: string name = frozen.getVertexName(v);
+     * ---------------------------------------------
+     * Returns the name of the vertex with the given ID.
+     * Throws an error if v is not a valid vertex ID.
+     */
+    const std::string& getVertexName(int v) const;
+
+    /*
+     * Method: isEmpty
+     * Usage: if (frozen.isEmpty()) ...
+     * --------------------------------
+     * Returns true if the graph has no vertices.
+     */
+    bool isEmpty() const;
+
+    /*
+     * Method: outDegree
+     * Usage: int count = frozen.outDegree(v);
+     * ---------------------------------------
+     * Returns the number of edges leaving vertex v.
+     * Throws an error if v is not a valid vertex ID.
+     */
+    int outDegree(int v) const;
+
+    /*
+     * Method: topologicalSort
+     * Usage: Vector<int> order = frozen.topologicalSort();
+     * ----------------------------------------------------
+     * Returns every vertex ID in an order in which each edge leads from an
+     * earlier vertex to a later one.  Among vertices whose order is not
+     * forced by the edges, lower IDs come first.
+     * Throws an error if the graph contains a cycle.
+     */
+    Vector<int> topologicalSort() const;
+
+    /*
+     * Method: toString
+     * Usage: string str = frozen.toString();
+     * --------------------------------------
+     * Converts the graph to a printable string representation, in the same
+     * format that the graph it was made from prints in.
+     */
+    std::string toString() const;
+
+    /*
+     * Method: vertexCount
+     * Usage: int count = frozen.vertexCount();
+     * ----------------------------------------
+     * Returns the number of vertices in the graph.
+     */
+    int vertexCount() const;
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+
+private:
+    std::vector<std::string> names;     // vertex names, indexed by ID
+    HashMap<std::string, int> ids;      // vertex IDs, indexed by name
+    std::vector<int> offsets;           // vertex v's edges are offsets[v] .. offsets[v + 1] - 1
+    std::vector<int> targets;           // target vertex of each edge
+    std::vector<double> weights;        // weight of each edge
+    bool hasNegativeWeights;
+
+    void checkEdge(int e, const char* member) const;
+    void checkVertex(int v, const char* member) const;
+
+    template <typename V, typename E>
+    friend class BasicGraphGen;
+};
+
+/*
+ * Operator: <<
+ * ------------
+ * Prints the graph to the given output stream, in the same format as
+ * a <code>BasicGraph</code>.
+ */
+std::ostream& operator <<(std::ostream& os, const FrozenGraph& graph);
+
+#include "private/init.h"   // ensure that Stanford C++ lib is initialized
+
+#endif // _frozengraph_h
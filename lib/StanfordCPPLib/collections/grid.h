@@ -4,6 +4,10 @@
  * This file exports the <code>Grid</code> class, which offers a
  * convenient abstraction for representing a two-dimensional array.
  *
+ * @version 2026/10/17
+ * - added rowView/columnView for unchecked access to a row or column
+ * - added copyFrom and transpose; fill and copying work on the whole array
+ * - resize(..., true) moves the retained elements instead of copying them
  * @version 2017/11/14
  * - added iterator version checking support
  * @version 2017/10/18
@@ -40,10 +44,13 @@
 #ifndef _grid_h
 #define _grid_h
 
+#include <algorithm>
 #include <initializer_list>
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <utility>
+#include <vector>
 #include "collections.h"
 #include "error.h"
 #include "hashcode.h"
@@ -75,6 +82,12 @@ public:
     /* Forward reference */
     class GridRow;
     class GridRowConst;
+    template <typename T>
+    class GridView;
+
+    /* Types returned by rowView and columnView */
+    typedef GridView<ValueType> View;
+    typedef GridView<const ValueType> ConstView;
 
     /*
      * Constructor: Grid
@@ -106,6 +119,29 @@ public:
      * Frees any heap storage associated with this grid.
      */
     virtual ~Grid();
+
+    /*
+     * Method: columnView
+     * Usage: Grid<ValueType>::View column = grid.columnView(col);
+     * -----------------------------------------------------------
+     * Returns a view of the given column of this grid; see rowView.
+     * Consecutive elements of a column are a row apart in memory, so
+     * walking a column is slower than walking a row.
+     * This method signals an error if <code>col</code> is outside the grid.
+     */
+    View columnView(int col);
+    ConstView columnView(int col) const;
+
+    /*
+     * Method: copyFrom
+     * Usage: grid.copyFrom(grid2);
+     * ----------------------------
+     * Makes this grid the same size as the given grid and copies all of its
+     * elements, in one pass over the underlying array.  If the grids are
+     * already the same size, no memory is allocated.  This is what
+     * assignment between grids does.
+     */
+    void copyFrom(const Grid<ValueType>& grid);
     
     /*
      * Method: equals
@@ -222,6 +258,32 @@ public:
      */
     void resize(int nRows, int nCols, bool retain = false);
 
+    /*
+     * Method: rowView
+     * Usage: Grid<ValueType>::View row = grid.rowView(row);
+     * -----------------------------------------------------
+     * Returns a view of the given row of this grid, which can be indexed
+     * with <code>[]</code> and walked with a range-based for loop.  The
+     * row index is checked once here; indexing the view is not checked, and
+     * does not count as a modification for iterator checking, so it is
+     * as fast as indexing an array.  Indexes past the end of the row are
+     * not caught.  The view is invalidated when the grid is resized,
+     * transposed or assigned to.
+     * This method signals an error if <code>row</code> is outside the grid.
+     *
+     *<pre>
+     *    for (int i = 1; i < table.numRows(); i++) {
+     *        Grid<double>::View prev = table.rowView(i - 1);
+     *        Grid<double>::View curr = table.rowView(i);
+     *        for (int j = 0; j < curr.size(); j++) {
+     *            curr[j] = prev[j] + cost(i, j);
+     *        }
+     *    }
+     *</pre>
+     */
+    View rowView(int row);
+    ConstView rowView(int row) const;
+
     /*
      * Method: set
      * Usage: grid.set(row, col, value);
@@ -268,6 +330,16 @@ public:
             std::string colSeparator = ", ",
             std::string rowSeparator = ",\n ") const;
 
+    /*
+     * Method: transpose
+     * Usage: grid.transpose();
+     * ------------------------
+     * Flips the grid over its main diagonal in place, so that an R x C grid
+     * becomes a C x R grid whose element (c, r) is the old element (r, c).
+     * Elements are moved, not copied, and no second grid is allocated.
+     */
+    void transpose();
+
     /*
      * Method: width
      * Usage: int nCols = grid.width();
@@ -370,6 +442,7 @@ private:
     void checkIndexes(int row, int col,
                       int rowMax, int colMax,
                       std::string prefix) const;
+    void checkLine(int index, int max, const char* what, const char* prefix) const;
     int gridCompare(const Grid& grid2) const;
 
     /*
@@ -397,23 +470,19 @@ private:
     void deepCopy(const Grid& grid) {
         int n = grid.nRows * grid.nCols;
         elements = new ValueType[n];
-        for (int i = 0; i < n; i++) {
-            elements[i] = grid.elements[i];
-        }
+        std::copy(grid.elements, grid.elements + n, elements);
         nRows = grid.nRows;
         nCols = grid.nCols;
     }
 
 public:
     Grid& operator =(const Grid& src) {
-        if (this != &src) {
-            delete[] elements;
-            deepCopy(src);
-        }
+        copyFrom(src);
         return *this;
     }
 
-    Grid(const Grid& src) {
+    Grid(const Grid& src)
+            : m_version(0) {
         deepCopy(src);
     }
 
@@ -557,6 +626,96 @@ public:
         friend class Grid;
     };
     friend class GridRowConst;
+
+    /*
+     * Private class: Grid<ValType>::GridView
+     * --------------------------------------
+     * A row or column of a grid, returned by rowView and columnView.
+     * It holds a pointer to the first element and the distance between
+     * consecutive elements, which is 1 for a row and the grid's width for
+     * a column, so indexing it is a multiply and an add with no checks.
+     */
+    template <typename T>
+    class GridView {
+    public:
+        class iterator : public std::iterator<std::forward_iterator_tag, T> {
+        public:
+            iterator() : first(nullptr), stride(0), index(0) {
+                // empty
+            }
+
+            iterator& operator ++() {
+                index++;
+                return *this;
+            }
+
+            iterator operator ++(int) {
+                iterator copy(*this);
+                index++;
+                return copy;
+            }
+
+            bool operator ==(const iterator& rhs) const {
+                return first == rhs.first && index == rhs.index;
+            }
+
+            bool operator !=(const iterator& rhs) const {
+                return !(*this == rhs);
+            }
+
+            T& operator *() const {
+                return first[index * stride];
+            }
+
+            T* operator ->() const {
+                return &first[index * stride];
+            }
+
+        private:
+            // the index is kept instead of a pointer so that the end of a
+            // column never points past the end of the grid's array
+            iterator(T* theFirst, int theStride, int theIndex)
+                    : first(theFirst), stride(theStride), index(theIndex) {
+                // empty
+            }
+
+            T* first;
+            int stride;
+            int index;
+            friend class GridView;
+        };
+
+        GridView() : first(nullptr), count(0), stride(0) {
+            // empty
+        }
+
+        T& operator [](int i) const {
+            return first[i * stride];
+        }
+
+        iterator begin() const {
+            return iterator(first, stride, 0);
+        }
+
+        iterator end() const {
+            return iterator(first, stride, count);
+        }
+
+        int size() const {
+            return count;
+        }
+
+    private:
+        GridView(T* theFirst, int theCount, int theStride)
+                : first(theFirst), count(theCount), stride(theStride) {
+            // empty
+        }
+
+        T* first;
+        int count;
+        int stride;
+        friend class Grid;
+    };
 };
 
 template <typename ValueType>
@@ -623,6 +782,37 @@ Grid<ValueType>::~Grid() {
     }
 }
 
+template <typename ValueType>
+typename Grid<ValueType>::View Grid<ValueType>::columnView(int col) {
+    checkLine(col, nCols - 1, "column", "columnView");
+    m_version++;
+    return View(elements + col, nRows, nCols);
+}
+
+template <typename ValueType>
+typename Grid<ValueType>::ConstView Grid<ValueType>::columnView(int col) const {
+    checkLine(col, nCols - 1, "column", "columnView");
+    return ConstView(elements + col, nRows, nCols);
+}
+
+template <typename ValueType>
+void Grid<ValueType>::copyFrom(const Grid<ValueType>& grid) {
+    if (this == &grid) {
+        return;
+    }
+    int n = grid.nRows * grid.nCols;
+    if (n != nRows * nCols) {
+        // allocate before freeing, so a failed allocation leaves this grid intact
+        ValueType* newElements = new ValueType[n];
+        delete[] elements;
+        elements = newElements;
+    }
+    std::copy(grid.elements, grid.elements + n, elements);
+    nRows = grid.nRows;
+    nCols = grid.nCols;
+    m_version++;
+}
+
 template <typename ValueType>
 bool Grid<ValueType>::equals(const Grid<ValueType>& grid2) const {
     // optimization: if literally same grid, stop
@@ -633,11 +823,10 @@ bool Grid<ValueType>::equals(const Grid<ValueType>& grid2) const {
     if (nRows != grid2.nRows || nCols != grid2.nCols) {
         return false;
     }
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            if (get(row, col) != grid2.get(row, col)) {
-                return false;
-            }
+    int n = nRows * nCols;
+    for (int i = 0; i < n; i++) {
+        if (elements[i] != grid2.elements[i]) {
+            return false;
         }
     }
     return true;
@@ -645,11 +834,8 @@ bool Grid<ValueType>::equals(const Grid<ValueType>& grid2) const {
 
 template <typename ValueType>
 void Grid<ValueType>::fill(const ValueType& value) {
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            set(row, col, value);
-        }
-    }
+    std::fill(elements, elements + nRows * nCols, value);
+    m_version++;
 }
 
 template <typename ValueType>
@@ -681,29 +867,26 @@ bool Grid<ValueType>::isEmpty() const {
 
 template <typename ValueType>
 void Grid<ValueType>::mapAll(void (*fn)(ValueType value)) const {
-    for (int i = 0; i < nRows; i++) {
-        for (int j = 0; j < nCols; j++) {
-            fn(get(i, j));
-        }
+    int n = nRows * nCols;
+    for (int i = 0; i < n; i++) {
+        fn(elements[i]);
     }
 }
 
 template <typename ValueType>
 void Grid<ValueType>::mapAll(void (*fn)(const ValueType & value)) const {
-    for (int i = 0; i < nRows; i++) {
-        for (int j = 0; j < nCols; j++) {
-            fn(get(i, j));
-        }
+    int n = nRows * nCols;
+    for (int i = 0; i < n; i++) {
+        fn(elements[i]);
     }
 }
 
 template <typename ValueType>
 template <typename FunctorType>
 void Grid<ValueType>::mapAll(FunctorType fn) const {
-    for (int i = 0; i < nRows; i++) {
-        for (int j = 0; j < nCols; j++) {
-            fn(get(i, j));
-        }
+    int n = nRows * nCols;
+    for (int i = 0; i < n; i++) {
+        fn(elements[i]);
     }
 }
 
@@ -755,7 +938,10 @@ void Grid<ValueType>::resize(int numRows, int numCols, bool retain) {
     }
 
     // optimization: don't do the resize if we are already that size
-    if (numRows == this->nRows && numCols == this->nCols && retain) {
+    if (numRows == this->nRows && numCols == this->nCols && elements) {
+        if (!retain) {
+            fill(ValueType());
+        }
         return;
     }
     
@@ -764,25 +950,19 @@ void Grid<ValueType>::resize(int numRows, int numCols, bool retain) {
     int oldnRows = this->nRows;
     int oldnCols = this->nCols;
     
-    // create new empty array and set new size
+    // create new array in empty/default state and set new size;
+    // the () value-initializes every element, zeroing numbers and pointers
+    this->elements = new ValueType[numRows * numCols]();
     this->nRows = numRows;
     this->nCols = numCols;
-    this->elements = new ValueType[numRows * numCols];
-    
-    // initialize to empty/default state
-    ValueType value = ValueType();
-    for (int i = 0; i < numRows * numCols; i++) {
-        this->elements[i] = value;
-    }
     
-    // possibly retain old contents
+    // possibly retain old contents; they are about to be freed, so move them
     if (retain) {
-        int minRows = oldnRows < numRows ? oldnRows : numRows;
-        int minCols = oldnCols < numCols ? oldnCols : numCols;
+        int minRows = std::min(oldnRows, numRows);
+        int minCols = std::min(oldnCols, numCols);
         for (int row = 0; row < minRows; row++) {
-            for (int col = 0; col < minCols; col++) {
-                this->elements[(row * numCols) + col] = oldElements[(row * oldnCols) + col];
-            }
+            ValueType* oldRow = oldElements + row * oldnCols;
+            std::move(oldRow, oldRow + minCols, this->elements + row * numCols);
         }
     }
     
@@ -793,6 +973,19 @@ void Grid<ValueType>::resize(int numRows, int numCols, bool retain) {
     m_version++;
 }
 
+template <typename ValueType>
+typename Grid<ValueType>::View Grid<ValueType>::rowView(int row) {
+    checkLine(row, nRows - 1, "row", "rowView");
+    m_version++;
+    return View(elements + row * nCols, nCols, 1);
+}
+
+template <typename ValueType>
+typename Grid<ValueType>::ConstView Grid<ValueType>::rowView(int row) const {
+    checkLine(row, nRows - 1, "row", "rowView");
+    return ConstView(elements + row * nCols, nCols, 1);
+}
+
 template <typename ValueType>
 void Grid<ValueType>::set(int row, int col, const ValueType& value) {
     checkIndexes(row, col, nRows - 1, nCols - 1, "set");
@@ -842,6 +1035,47 @@ std::string Grid<ValueType>::toString2D(
     return os.str();
 }
 
+/*
+ * Implementation notes: transpose
+ * -------------------------------
+ * A square grid is transposed by swapping each element above the diagonal
+ * with its mirror image.  Otherwise the element at index i moves to index
+ * (i % nCols) * nRows + i / nCols, and following those moves from any
+ * index leads around a cycle back to it; each cycle is rotated by one
+ * carried element, and a bit per element records which ones have been
+ * placed so that no cycle is rotated twice.  A single row or column has
+ * the same layout either way, so only its dimensions change.
+ */
+template <typename ValueType>
+void Grid<ValueType>::transpose() {
+    if (nRows == nCols) {
+        for (int row = 0; row < nRows; row++) {
+            for (int col = row + 1; col < nCols; col++) {
+                std::swap(elements[row * nCols + col], elements[col * nCols + row]);
+            }
+        }
+    } else if (nRows > 1 && nCols > 1) {
+        // the first and last elements stay where they are
+        int n = nRows * nCols;
+        std::vector<bool> placed(n, false);
+        for (int start = 1; start < n - 1; start++) {
+            if (placed[start]) {
+                continue;
+            }
+            ValueType carry = std::move(elements[start]);
+            int i = start;
+            do {
+                int next = (i % nCols) * nRows + i / nCols;
+                std::swap(carry, elements[next]);
+                placed[next] = true;
+                i = next;
+            } while (i != start);
+        }
+    }
+    std::swap(nRows, nCols);
+    m_version++;
+}
+
 template <typename ValueType>
 int Grid<ValueType>::width() const {
     return nCols;
@@ -909,6 +1143,17 @@ void Grid<ValueType>::checkIndexes(int row, int col,
     }
 }
 
+template <typename ValueType>
+void Grid<ValueType>::checkLine(int index, int max,
+                                const char* what, const char* prefix) const {
+    if (index < 0 || index > max) {
+        std::ostringstream out;
+        out << "Grid::" << prefix << ": " << what << " " << index
+            << " is outside of valid range [0.." << max << "]";
+        error(out.str());
+    }
+}
+
 template <typename ValueType>
 int Grid<ValueType>::gridCompare(const Grid& grid2) const {
     int h1 = height();
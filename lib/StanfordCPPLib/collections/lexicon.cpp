@@ -15,6 +15,8 @@
  *
  * The original DAWG implementation is retained as dawglexicon.h/cpp.
  * 
+ * @version 2026/10/17
+ * - added freeze/isFrozen, which store the trie as one array of 8-byte nodes
  * @version 2016/09/24
  * - refactored to use collections.h utility functions
  * @version 2016/08/11
@@ -48,6 +50,7 @@
 #include "hashcode.h"
 #include "strlib.h"
 
+static int popcount(uint32_t bits);
 static bool scrub(std::string& str);
 
 Lexicon::Lexicon() :
@@ -97,6 +100,9 @@ bool Lexicon::add(const std::string& word) {
     if (!scrub(scrubbed)) {
         return false;
     }
+    if (isFrozen()) {
+        thaw();
+    }
     return addHelper(m_root, scrubbed, /* originalWord */ scrubbed);
 }
 
@@ -144,12 +150,16 @@ void Lexicon::clear() {
     m_allWords.clear();
     deleteTree(m_root);
     m_root = nullptr;
+    std::vector<FrozenNode>().swap(m_frozen);
 }
 
 bool Lexicon::contains(const std::string& word) const {
     if (word.empty()) {
         return false;
     }
+    if (isFrozen()) {
+        return frozenContains(word, /* isPrefix */ false);
+    }
     std::string scrubbed = word;
     if (!scrub(scrubbed)) {
         return false;
@@ -179,6 +189,9 @@ bool Lexicon::containsPrefix(const std::string& prefix) const {
     if (prefix.empty()) {
         return true;
     }
+    if (isFrozen()) {
+        return frozenContains(prefix, /* isPrefix */ true);
+    }
     std::string scrubbed = prefix;
     if (!scrub(scrubbed)) {
         return false;
@@ -197,6 +210,42 @@ std::string Lexicon::first() const {
     return m_allWords.first();
 }
 
+/*
+ * The trie is laid out breadth-first, so each node's children are numbered
+ * consecutively and a node only needs the index of its first child and a
+ * bit mask of which letters have children.
+ */
+void Lexicon::freeze() {
+    if (isFrozen()) {
+        return;
+    }
+    std::vector<TrieNode*> order;
+    order.push_back(m_root);
+    std::vector<FrozenNode> frozen;
+    for (size_t i = 0; i < order.size(); i++) {
+        TrieNode* node = order[i];
+        FrozenNode frozenNode;
+        frozenNode.firstChild = (uint32_t) order.size();
+        frozenNode.childMask = 0;
+        if (node) {
+            if (node->isWord()) {
+                frozenNode.childMask |= FROZEN_WORD_BIT;
+            }
+            for (char letter = 'a'; letter <= 'z'; letter++) {
+                if (node->child(letter)) {
+                    frozenNode.childMask |= 1u << (letter - 'a');
+                    order.push_back(node->child(letter));
+                }
+            }
+        }
+        frozen.push_back(frozenNode);
+    }
+    deleteTree(m_root);
+    m_root = nullptr;
+    frozen.shrink_to_fit();
+    m_frozen.swap(frozen);
+}
+
 void Lexicon::insert(const std::string& word) {
     add(word);
 }
@@ -205,6 +254,10 @@ bool Lexicon::isEmpty() const {
     return size() == 0;
 }
 
+bool Lexicon::isFrozen() const {
+    return !m_frozen.empty();
+}
+
 bool Lexicon::isSubsetOf(const Lexicon& lex2) const {
     auto it = begin();
     auto end = this->end();
@@ -250,6 +303,9 @@ bool Lexicon::remove(const std::string& word) {
     if (!scrub(scrubbed)) {
         return false;
     }
+    if (isFrozen()) {
+        thaw();
+    }
     return removeHelper(m_root, scrubbed, /* originalWord */ scrubbed, /* isPrefix */ false);
 }
 
@@ -283,7 +339,9 @@ bool Lexicon::removePrefix(const std::string& prefix) {
     if (!scrub(scrubbed)) {
         return false;
     }
-    
+    if (isFrozen()) {
+        thaw();
+    }
     return removeHelper(m_root, scrubbed, /* originalWord */ scrubbed, /* isPrefix */ true);
 }
 
@@ -544,6 +602,12 @@ void Lexicon::removeSubtreeHelper(TrieNode*& node, const std::string& originalWo
 }
 
 void Lexicon::deepCopy(const Lexicon& src) {
+    if (src.isFrozen()) {
+        m_frozen = src.m_frozen;
+        m_allWords = src.m_allWords;
+        m_size = src.m_size;
+        return;
+    }
     for (std::string word : src.m_allWords) {
         add(word);
     }
@@ -558,6 +622,51 @@ void Lexicon::deleteTree(TrieNode* node) {
     }
 }
 
+/*
+ * Looks up a word or prefix in the frozen trie.  The letters are lowercased
+ * as they are read, which gives the same result as scrubbing a copy.
+ */
+bool Lexicon::frozenContains(const std::string& word, bool isPrefix) const {
+    const FrozenNode* nodes = m_frozen.data();
+    uint32_t index = 0;
+    for (char ch : word) {
+        int letter = tolower(ch) - 'a';
+        if (letter < 0 || letter >= 26) {
+            return false;
+        }
+        uint32_t mask = nodes[index].childMask;
+        uint32_t bit = 1u << letter;
+        if (!(mask & bit)) {
+            return false;
+        }
+        index = nodes[index].firstChild + popcount(mask & (bit - 1));
+    }
+    return isPrefix || (nodes[index].childMask & FROZEN_WORD_BIT) != 0;
+}
+
+/*
+ * Rebuilds the pointer-based trie from the frozen one so that the lexicon
+ * can be modified again.
+ */
+void Lexicon::thaw() {
+    m_root = thawHelper(0);
+    std::vector<FrozenNode>().swap(m_frozen);
+}
+
+Lexicon::TrieNode* Lexicon::thawHelper(uint32_t index) const {
+    const FrozenNode& frozenNode = m_frozen[index];
+    TrieNode* node = new TrieNode();
+    node->setWord((frozenNode.childMask & FROZEN_WORD_BIT) != 0);
+    uint32_t child = frozenNode.firstChild;
+    for (char letter = 'a'; letter <= 'z'; letter++) {
+        if (frozenNode.childMask & (1u << (letter - 'a'))) {
+            node->child(letter) = thawHelper(child);
+            child++;
+        }
+    }
+    return node;
+}
+
 /*
  * Returns true if the given file (probably) represents a
  * binary DAWG lexicon data file.
@@ -650,3 +759,15 @@ static bool scrub(std::string& str) {
     }
     return true;
 }
+
+static int popcount(uint32_t bits) {
+#ifdef __GNUC__
+    return __builtin_popcount(bits);
+#else
+    int count = 0;
+    for (; bits != 0; bits &= bits - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
@@ -5,6 +5,8 @@
  * compact structure for storing a list of words.
  *
  * @author Marty Stepp
+ * @version 2026/10/17
+ * - added freeze and isFrozen for a compact read-only trie
  * @version 2016/12/09
  * - added iterator version checking support (implicitly via Set)
  * @version 2016/09/24
@@ -28,7 +30,9 @@
 #include <initializer_list>
 #include <iterator>
 #include <set>
+#include <stdint.h>
 #include <string>
+#include <vector>
 #include "hashcode.h"
 #include "set.h"
 
@@ -200,6 +204,19 @@ public:
      */
     std::string first() const;
 
+    /*
+     * Method: freeze
+     * Usage: lex.freeze();
+     * --------------------
+     * Converts the lexicon's internal trie into a compact read-only form
+     * stored in a single array, which uses far less memory and makes
+     * <code>contains</code> and <code>containsPrefix</code> faster.
+     * This is meant to be called once a lexicon has been fully loaded.
+     * The lexicon can still be modified afterward, but the first change
+     * converts it back to the ordinary form.
+     */
+    void freeze();
+
     /*
      * Method: insert
      * Usage: lex.insert(word);
@@ -217,6 +234,15 @@ public:
      */
     bool isEmpty() const;
 
+    /*
+     * Method: isFrozen
+     * Usage: if (lex.isFrozen()) ...
+     * ------------------------------
+     * Returns <code>true</code> if the lexicon is currently stored in the
+     * compact form created by <code>freeze</code>.
+     */
+    bool isFrozen() const;
+
     /*
      * Method: isSubsetOf
      * Usage: if (lex.isSubsetOf(lex2)) ...
@@ -510,6 +536,19 @@ private:
         TrieNode* m_children[26];   // 0=a, 1=b, 2=c, ..., 25=z
     };
 
+    /*
+     * A node of the frozen trie.  All nodes are kept in one vector in
+     * breadth-first order, so the children of a node are adjacent and the
+     * child for a letter is found by counting the lower bits of childMask.
+     */
+    struct FrozenNode {
+        uint32_t firstChild;   // index of the node's first child
+        uint32_t childMask;    // bit i set if there is a child for 'a' + i;
+                               // FROZEN_WORD_BIT set if the node ends a word
+    };
+
+    static const uint32_t FROZEN_WORD_BIT = 1u << 31;
+
     /*
      * private helper functions, including
      * recursive helpers to implement public add/contains/remove
@@ -518,6 +557,9 @@ private:
     bool containsHelper(TrieNode* node, const std::string& word, bool isPrefix) const;
     void deepCopy(const Lexicon& src);
     void deleteTree(TrieNode* node);
+    bool frozenContains(const std::string& word, bool isPrefix) const;
+    TrieNode* thawHelper(uint32_t index) const;
+    void thaw();
     bool isDAWGFile(std::istream& input) const;
     bool isDAWGFile(const std::string& filename) const;
     void readBinaryFile(std::istream& input);
@@ -530,6 +572,7 @@ private:
 
     /* instance variables */
     TrieNode* m_root;
+    std::vector<FrozenNode> m_frozen;   // frozen trie; empty unless frozen
     int m_size;
     bool m_removeFlag;             // flag to differentiate += and -= when used with ,
     Set<std::string> m_allWords;   // secondary structure of all words for foreach;
@@ -4,6 +4,8 @@
  * This file exports the template class <code>Map</code>, which
  * maintains a collection of <i>key</i>-<i>value</i> pairs.
  * 
+ * @version 2026/10/17
+ * - added linear-time key merging (mergeKeys, isKeySubsetOf) for Set algebra
  * @version 2017/10/18
  * - fix compiler warnings
  * @version 2016/12/09
@@ -39,6 +41,7 @@
 #include <initializer_list>
 #include <map>
 #include <utility>
+#include <vector>
 #include "collections.h"
 #include "error.h"
 #include "hashcode.h"
@@ -794,6 +797,82 @@ private:
         }
     }
 
+    /*
+     * Implementation notes: KeyCursor
+     * -------------------------------
+     * Walks the nodes of a tree in key order without allocating a Stack per
+     * step the way iterator does; the path holds at most one node per level.
+     * The cursor reads a node's right pointer when it moves past that node,
+     * so a node that is visited may be freed or relinked once the cursor has
+     * moved on.
+     */
+    class KeyCursor {
+    public:
+        explicit KeyCursor(BSTNode* root) {
+            pushLeftSpine(root);
+        }
+
+        bool isDone() const {
+            return path.empty();
+        }
+
+        BSTNode* node() const {
+            return path.back();
+        }
+
+        BSTNode* next() {
+            BSTNode* np = path.back();
+            path.pop_back();
+            pushLeftSpine(np->right);
+            return np;
+        }
+
+    private:
+        void pushLeftSpine(BSTNode* np) {
+            while (np) {
+                path.push_back(np);
+                np = np->left;
+            }
+        }
+
+        std::vector<BSTNode*> path;
+    };
+
+    /*
+     * Implementation notes: buildBalancedTree(nodes, start, end, height)
+     * -------------------------------------------------------------------
+     * Links the given nodes, which are in key order, into a tree that is as
+     * balanced as possible and returns its root.  Splitting at the middle
+     * makes the two halves of every subtree differ in size by at most one,
+     * so their heights differ by at most one and the result is an AVL tree.
+     */
+    BSTNode* buildBalancedTree(const std::vector<BSTNode*>& nodes, int start, int end, int& height) {
+        if (start >= end) {
+            height = 0;
+            return nullptr;
+        }
+        int middle = start + (end - start) / 2;
+        int leftHeight;
+        int rightHeight;
+        BSTNode* np = nodes[middle];
+        np->left = buildBalancedTree(nodes, start, middle, leftHeight);
+        np->right = buildBalancedTree(nodes, middle + 1, end, rightHeight);
+        np->bf = rightHeight - leftHeight;
+        height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+        return np;
+    }
+
+    BSTNode* copyNode(BSTNode* t) {
+        BSTNode* np = new BSTNode;
+        np->key = t->key;
+        np->value = t->value;
+        return np;
+    }
+
+    bool hasDefaultComparator() const {
+        return dynamic_cast<TemplateComparator<std::less<KeyType> >*>(cmpp) != nullptr;
+    }
+
 public:
     /*
      * Hidden features
@@ -852,6 +931,116 @@ public:
         deepCopy(src);
     }
 
+    /*
+     * Key merging support
+     * -------------------
+     * These methods let Set combine two trees in time linear in their sizes
+     * by walking both in key order, rather than searching one tree for every
+     * key of the other.  They are only meaningful when both maps order their
+     * keys the same way, which hasSameKeyOrder checks.
+     */
+    enum KeyMergeMode {
+        KEYS_IN_EITHER,     // union
+        KEYS_IN_BOTH,       // intersection
+        KEYS_IN_FIRST_ONLY  // difference
+    };
+
+    /*
+     * Returns true if the keys of the given map are in strictly increasing
+     * order under this map's comparator.  This is immediate when both maps
+     * use the default std::less ordering and takes one pass otherwise.
+     */
+    bool hasSameKeyOrder(const Map& other) const {
+        if (hasDefaultComparator() && other.hasDefaultComparator()) {
+            return true;
+        }
+        KeyCursor cursor(other.root);
+        BSTNode* previous = nullptr;
+        while (!cursor.isDone()) {
+            BSTNode* np = cursor.next();
+            if (previous && !cmpp->lessThan(previous->key, np->key)) {
+                return false;
+            }
+            previous = np;
+        }
+        return true;
+    }
+
+    /*
+     * Replaces the contents of this map with the keys of first and second
+     * selected by mode, and rebuilds a balanced tree, in O(n + m) time.
+     * A key found in both maps keeps its value from first.  The result uses
+     * first's comparator.  If first is this map, its nodes are relinked in
+     * place rather than copied, so only keys taken from second allocate.
+     * Requires first.hasSameKeyOrder(second).
+     */
+    void mergeKeys(const Map& first, const Map& second, KeyMergeMode mode) {
+        bool inPlace = &first == this;
+        if (!inPlace) {
+            clear();
+            delete cmpp;
+            cmpp = first.cmpp->clone();
+        }
+        bool keepFirstOnly = mode != KEYS_IN_BOTH;
+        bool keepSecondOnly = mode == KEYS_IN_EITHER;
+        bool keepCommon = mode != KEYS_IN_FIRST_ONLY;
+
+        // each cursor moves past a node before that node is freed or relinked
+        std::vector<BSTNode*> nodes;
+        KeyCursor a(first.root);
+        KeyCursor b(second.root);
+        while (!a.isDone() || !b.isDone()) {
+            int sign = a.isDone() ? +1 : b.isDone() ? -1 : compareKeys(a.node()->key, b.node()->key);
+            if (sign > 0) {
+                BSTNode* np = b.next();
+                if (keepSecondOnly) {
+                    nodes.push_back(copyNode(np));
+                }
+                continue;
+            }
+            BSTNode* np = a.next();
+            bool keep = keepFirstOnly;
+            if (sign == 0) {
+                b.next();
+                keep = keepCommon;
+            }
+            if (keep) {
+                nodes.push_back(inPlace ? np : copyNode(np));
+            } else if (inPlace) {
+                delete np;
+            }
+        }
+
+        int height;
+        root = buildBalancedTree(nodes, 0, (int) nodes.size(), height);
+        nodeCount = (int) nodes.size();
+        m_version++;
+    }
+
+    /*
+     * Returns true if every key of this map is also a key of the given map,
+     * walking both maps in key order.  Requires hasSameKeyOrder(other).
+     */
+    bool isKeySubsetOf(const Map& other) const {
+        if (nodeCount > other.nodeCount) {
+            return false;
+        }
+        KeyCursor a(root);
+        KeyCursor b(other.root);
+        while (!a.isDone()) {
+            // every key of other that is less than this one can be skipped
+            while (!b.isDone() && cmpp->lessThan(b.node()->key, a.node()->key)) {
+                b.next();
+            }
+            if (b.isDone() || cmpp->lessThan(a.node()->key, b.node()->key)) {
+                return false;
+            }
+            a.next();
+            b.next();
+        }
+        return true;
+    }
+
     /*
      * Iterator support
      * ----------------
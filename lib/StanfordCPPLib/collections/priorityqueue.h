@@ -4,6 +4,12 @@
  * This file exports the <code>PriorityQueue</code> class, a
  * collection in which values are processed in priority order.
  * 
+ * @version 2026/10/17
+ * - heap is now 4-ary and tracks the position of every entry
+ * - added Handle, enqueueWithHandle, contains(handle) and
+ *   changePriority(handle, priority) for O(log N) priority changes
+ * - added enqueueAll, which heapifies in linear time
+ * - back() now stays correct after dequeues and priority changes
  * @version 2016/11/07
  * - small const-correctness bug fix in front() / back() (courtesy Truman Cranor)
  * @version 2016/10/14
@@ -45,9 +51,11 @@
 #ifndef _priorityqueue_h
 #define _priorityqueue_h
 
+#include <algorithm>
 #include <cmath>
 #include <initializer_list>
 #include <utility>
+#include <vector>
 #include "collections.h"
 #include "error.h"
 #include "gmath.h"
@@ -85,6 +93,21 @@ public:
      */
     PriorityQueue(std::initializer_list<std::pair<double, ValueType> > list);
 
+    /*
+     * Type: Handle
+     * ------------
+     * A handle identifies one value added by <code>enqueueWithHandle</code>,
+     * so that its priority can later be changed without searching the queue.
+     * A handle stays valid until its value is dequeued or the queue is
+     * cleared; after that, <code>contains</code> returns false for it.
+     */
+    struct Handle {
+        Handle() : slot(-1), sequence(-1) {}
+        Handle(int slot, long sequence) : slot(slot), sequence(sequence) {}
+        int slot;
+        long sequence;
+    };
+
     /*
      * Destructor: ~PriorityQueue
      * --------------------------
@@ -120,6 +143,18 @@ public:
      */
     void changePriority(ValueType value, double newPriority);
 
+    /*
+     * Method: changePriority
+     * Usage: pq.changePriority(handle, newPriority);
+     * ----------------------------------------------
+     * Like the version above, but finds the value through a handle returned
+     * by <code>enqueueWithHandle</code>, which takes O(log N) time instead of
+     * a search through the whole queue.
+     * Throws an error if the handle's value is no longer in the queue, or if
+     * the new priority is not at least as urgent as its current priority.
+     */
+    void changePriority(Handle handle, double newPriority);
+
     /*
      * Method: clear
      * Usage: pq.clear();
@@ -127,6 +162,15 @@ public:
      * Removes all elements from the priority queue.
      */
     void clear();
+
+    /*
+     * Method: contains
+     * Usage: if (pq.contains(handle)) ...
+     * -----------------------------------
+     * Returns <code>true</code> if the value with the given handle is still
+     * in the queue.
+     */
+    bool contains(Handle handle) const;
     
     /*
      * Method: dequeue
@@ -148,6 +192,27 @@ public:
      * priority 2 elements.
      */
     void enqueue(const ValueType& value, double priority);
+
+    /*
+     * Method: enqueueAll
+     * Usage: pq.enqueueAll(pairs);
+     * ----------------------------
+     * Adds each value in the given list of (priority, value) pairs to the
+     * queue, as if by calling <code>enqueue</code> on each in order.
+     * When many values are added at once, the heap is rebuilt in a single
+     * linear-time pass rather than one value at a time.
+     */
+    void enqueueAll(const Vector<std::pair<double, ValueType> >& list);
+    void enqueueAll(std::initializer_list<std::pair<double, ValueType> > list);
+
+    /*
+     * Method: enqueueWithHandle
+     * Usage: PriorityQueue<ValueType>::Handle handle = pq.enqueueWithHandle(value, priority);
+     * ----------------------------------------------------------------------------------------
+     * Adds <code>value</code> to the queue just like <code>enqueue</code>,
+     * and returns a handle that can be passed to <code>changePriority</code>.
+     */
+    Handle enqueueWithHandle(const ValueType& value, double priority);
     
     /*
      * Method: equals
@@ -262,7 +327,15 @@ public:
      * Implementation notes: PriorityQueue data structure
      * --------------------------------------------------
      * The PriorityQueue class is implemented using a data structure called
-     * a heap.
+     * a heap.  Each node of the heap has up to four children, which sit next
+     * to each other in the array, so a heap of a given size is half as deep
+     * as a binary heap and each level down touches a single cache line.
+     *
+     * Every entry lives in a slot, and the positions array records where
+     * each slot's entry currently is in the heap.  This lets a Handle find
+     * its entry directly.  Slots are reused once their entries are dequeued;
+     * a handle records its entry's sequence number so that it can tell when
+     * its slot has been reused.
      */
 private:
     /* Type used for each heap entry */
@@ -270,22 +343,33 @@ private:
         ValueType value;
         double priority;
         long sequence;
+        int slot;
     };
 
+    /* Number of children of each heap node */
+    static const int HEAP_ARITY = 4;
+
     /* Instance variables */
-    Vector<HeapEntry> heap;
+    std::vector<HeapEntry> heap;    // entries in heap order; size() == count
+    std::vector<int> positions;     // heap index of each slot's entry, or -1 if the slot is free
+    std::vector<int> freeSlots;     // slots available for reuse
     long enqueueCount;
-    int backIndex;
+    int backSlot;                   // slot of the last value in the queue
     int count;
-    int capacity;
 
     /* Private function prototypes */
+    void appendEntry(const ValueType& value, double priority);
+    static double checkPriority(double priority, const char* method);
+    void decreasePriority(int index, double newPriority);
+    void findBack();
     const HeapEntry& heapGet(int index) const;
+    void moveEntry(int index, HeapEntry& entry);
 #ifdef PQUEUE_COMPARISON_OPERATORS_ENABLED
     int pqCompare(const PriorityQueue& other) const;
 #endif // PQUEUE_COMPARISON_OPERATORS_ENABLED
-    bool takesPriority(int i1, int i2);
-    void swapHeapEntries(int i1, int i2);
+    void siftDown(int index);
+    void siftUp(int index);
+    bool takesPriority(const HeapEntry& entry1, const HeapEntry& entry2) const;
 
     /*
      * Iterator support
@@ -403,17 +487,17 @@ public:
 };
 
 template <typename ValueType>
-PriorityQueue<ValueType>::PriorityQueue() {
+PriorityQueue<ValueType>::PriorityQueue()
+        : enqueueCount(0) {
     clear();
 }
 
 template <typename ValueType>
 PriorityQueue<ValueType>::PriorityQueue(
-        std::initializer_list<std::pair<double, ValueType> > list) {
+        std::initializer_list<std::pair<double, ValueType> > list)
+        : enqueueCount(0) {
     clear();
-    for (std::pair<double, ValueType> pair : list) {
-        enqueue(pair.second, pair.first);
-    }
+    enqueueAll(list);
 }
 
 /*
@@ -437,7 +521,7 @@ ValueType & PriorityQueue<ValueType>::back() {
     if (count == 0) {
         error("PriorityQueue::back: Attempting to read back of an empty queue");
     }
-    return heap[backIndex].value;
+    return heap[positions[backSlot]].value;
 }
 
 /*
@@ -447,32 +531,12 @@ ValueType & PriorityQueue<ValueType>::back() {
  */
 template <typename ValueType>
 void PriorityQueue<ValueType>::changePriority(ValueType value, double newPriority) {
-    if (std::isnan(newPriority)) {
-        error("PriorityQueue::changePriority: Attempted to use NaN as a priority.");
-    }
-    if (floatingPointEqual(newPriority, -0.0)) {
-        newPriority = 0.0;
-    }
+    newPriority = checkPriority(newPriority, "changePriority");
 
     // find the element in the pqueue; must use a simple iteration over elements
     for (int i = 0; i < count; i++) {
         if (heap[i].value == value) {
-            if (heap[i].priority < newPriority) {
-                error("PriorityQueue::changePriority: new priority cannot be less urgent than current priority.");
-            }
-            heap[i].priority = newPriority;
-
-            // after changing the priority, must percolate up to proper level
-            // to maintain heap ordering
-            while (i > 0) {
-                int parent = (i - 1) / 2;
-                if (takesPriority(parent, i)) {
-                    break;
-                }
-                swapHeapEntries(parent, i);
-                i = parent;
-            }
-
+            decreasePriority(i, newPriority);
             return;
         }
     }
@@ -481,11 +545,37 @@ void PriorityQueue<ValueType>::changePriority(ValueType value, double newPriorit
     error("PriorityQueue::changePriority: Element value not found.");
 }
 
+template <typename ValueType>
+void PriorityQueue<ValueType>::changePriority(Handle handle, double newPriority) {
+    newPriority = checkPriority(newPriority, "changePriority");
+    if (!contains(handle)) {
+        error("PriorityQueue::changePriority: Handle does not refer to a value in the queue.");
+    }
+    decreasePriority(positions[handle.slot], newPriority);
+}
+
+/*
+ * Implementation notes: clear
+ * ---------------------------
+ * The sequence counter is not reset, so that handles from before the
+ * call can never match an entry added after it.
+ */
 template <typename ValueType>
 void PriorityQueue<ValueType>::clear() {
     heap.clear();
+    positions.clear();
+    freeSlots.clear();
+    backSlot = -1;
     count = 0;
-    enqueueCount = 0;   // BUGFIX 2014/10/10: was previously using garbage unassigned value
+}
+
+template <typename ValueType>
+bool PriorityQueue<ValueType>::contains(Handle handle) const {
+    if (handle.slot < 0 || handle.slot >= (int) positions.size()) {
+        return false;
+    }
+    int index = positions[handle.slot];
+    return index >= 0 && heap[index].sequence == handle.sequence;
 }
 
 /*
@@ -499,60 +589,69 @@ ValueType PriorityQueue<ValueType>::dequeue() {
     if (count == 0) {
         error("PriorityQueue::dequeue: Attempting to dequeue an empty queue");
     }
+    ValueType value = std::move(heap[0].value);
+    positions[heap[0].slot] = -1;
+    freeSlots.push_back(heap[0].slot);
     count--;
-    bool wasBack = (backIndex == count);
-    ValueType value = heap[0].value;
-    swapHeapEntries(0, count);
-    int index = 0;
-    while (true) {
-        int left = 2 * index + 1;
-        int right = 2 * index + 2;
-        if (left >= count) {
-            break;
-        }
-        int child = left;
-        if (right < count && takesPriority(right, left)) {
-            child = right;
-        }
-        if (takesPriority(index, child)) {
-            break;
-        }
-        swapHeapEntries(index, child);
-        index = child;
-    }
-    if (wasBack) {
-        backIndex = index;
+    if (count > 0) {
+        moveEntry(0, heap[count]);
+        heap.pop_back();
+        siftDown(0);
+    } else {
+        heap.pop_back();
     }
     return value;
 }
 
 template <typename ValueType>
 void PriorityQueue<ValueType>::enqueue(const ValueType& value, double priority) {
-    if (std::isnan(priority)) {
-        error("PriorityQueue::enqueue: Attempted to use NaN as a priority.");
-    }
-    if (floatingPointEqual(priority, -0.0)) {
-        priority = 0.0;
-    }
+    enqueueWithHandle(value, priority);
+}
 
-    if (count == heap.size()) {
-        heap.add(HeapEntry());
-    }
-    int index = count++;
-    heap[index].value = value;
-    heap[index].priority = priority;
-    heap[index].sequence = enqueueCount++;
-    if (index == 0 || takesPriority(backIndex, index)) {
-        backIndex = index;
+/*
+ * Implementation notes: enqueueAll
+ * --------------------------------
+ * Sifting each new entry up costs O(log N) apiece, while rebuilding the
+ * whole heap bottom-up costs O(N) in total, so the rebuild wins once the
+ * new entries are a sizable fraction of the queue.
+ */
+template <typename ValueType>
+void PriorityQueue<ValueType>::enqueueAll(const Vector<std::pair<double, ValueType> >& list) {
+    int oldCount = count;
+    heap.reserve(count + list.size());
+    for (const std::pair<double, ValueType>& pair : list) {
+        appendEntry(pair.second, checkPriority(pair.first, "enqueueAll"));
     }
-    while (index > 0) {
-        int parent = (index - 1) / 2;
-        if (takesPriority(parent, index)) {
-            break;
+    if (count - oldCount > oldCount / 4) {
+        for (int i = (count - 2) / HEAP_ARITY; i >= 0; i--) {
+            siftDown(i);
+        }
+    } else {
+        for (int i = oldCount; i < count; i++) {
+            siftUp(i);
         }
-        swapHeapEntries(parent, index);
-        index = parent;
     }
+    if (count > 0) {
+        findBack();
+    }
+}
+
+template <typename ValueType>
+void PriorityQueue<ValueType>::enqueueAll(std::initializer_list<std::pair<double, ValueType> > list) {
+    enqueueAll(Vector<std::pair<double, ValueType> >(list));
+}
+
+template <typename ValueType>
+typename PriorityQueue<ValueType>::Handle
+PriorityQueue<ValueType>::enqueueWithHandle(const ValueType& value, double priority) {
+    appendEntry(value, checkPriority(priority, "enqueue"));
+    const HeapEntry& entry = heap[count - 1];
+    Handle handle(entry.slot, entry.sequence);
+    if (count == 1 || takesPriority(heap[positions[backSlot]], entry)) {
+        backSlot = entry.slot;
+    }
+    siftUp(count - 1);
+    return handle;
 }
 
 template <typename ValueType>
@@ -595,7 +694,7 @@ ValueType PriorityQueue<ValueType>::peek() const {
     if (count == 0) {
         error("PriorityQueue::peek: Attempting to peek at an empty queue");
     }
-    return heap.get(0).value;
+    return heap[0].value;
 }
 
 template <typename ValueType>
@@ -603,7 +702,7 @@ double PriorityQueue<ValueType>::peekPriority() const {
     if (count == 0) {
         error("PriorityQueue::peekPriority: Attempting to peek at an empty queue");
     }
-    return heap.get(0).priority;
+    return heap[0].priority;
 }
 
 template <typename ValueType>
@@ -623,12 +722,85 @@ std::string PriorityQueue<ValueType>::toString() const {
     return os.str();
 }
 
+/*
+ * Adds an entry at the end of the heap array, in a free slot, without
+ * restoring the heap order.
+ */
+template <typename ValueType>
+void PriorityQueue<ValueType>::appendEntry(const ValueType& value, double priority) {
+    int slot;
+    if (freeSlots.empty()) {
+        slot = (int) positions.size();
+        positions.push_back(count);
+    } else {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        positions[slot] = count;
+    }
+    HeapEntry entry = {value, priority, enqueueCount++, slot};
+    heap.push_back(std::move(entry));
+    count++;
+}
+
+template <typename ValueType>
+double PriorityQueue<ValueType>::checkPriority(double priority, const char* method) {
+    if (std::isnan(priority)) {
+        error(std::string("PriorityQueue::") + method + ": Attempted to use NaN as a priority.");
+    }
+    if (floatingPointEqual(priority, -0.0)) {
+        priority = 0.0;
+    }
+    return priority;
+}
+
+/*
+ * Lowers the priority number of the entry at the given index and moves it
+ * up to its new place.  If that entry was the back of the queue, the new
+ * back has to be found again.
+ */
+template <typename ValueType>
+void PriorityQueue<ValueType>::decreasePriority(int index, double newPriority) {
+    if (heap[index].priority < newPriority) {
+        error("PriorityQueue::changePriority: new priority cannot be less urgent than current priority.");
+    }
+    heap[index].priority = newPriority;
+    int slot = heap[index].slot;
+    siftUp(index);
+    if (slot == backSlot) {
+        findBack();
+    }
+}
+
+/*
+ * Sets backSlot to the slot of the last entry in priority order.  That
+ * entry has no children, so only the leaves need to be searched.
+ */
+template <typename ValueType>
+void PriorityQueue<ValueType>::findBack() {
+    int back = count - 1;
+    for (int i = count > 1 ? (count - 2) / HEAP_ARITY + 1 : 0; i < count - 1; i++) {
+        if (takesPriority(heap[back], heap[i])) {
+            back = i;
+        }
+    }
+    backSlot = heap[back].slot;
+}
+
 template <typename ValueType>
 const typename PriorityQueue<ValueType>::HeapEntry&
 PriorityQueue<ValueType>::heapGet(int index) const {
     return heap[index];
 }
 
+/*
+ * Moves an entry into the given heap index and records its new position.
+ */
+template <typename ValueType>
+void PriorityQueue<ValueType>::moveEntry(int index, HeapEntry& entry) {
+    heap[index] = std::move(entry);
+    positions[heap[index].slot] = index;
+}
+
 #ifdef PQUEUE_COMPARISON_OPERATORS_ENABLED
 /*
  * Implementation note: Due to the complexity and unpredictable heap ordering of the elements,
@@ -671,22 +843,60 @@ int PriorityQueue<ValueType>::pqCompare(const PriorityQueue& pq2) const {
 }
 #endif // PQUEUE_COMPARISON_OPERATORS_ENABLED
 
+/*
+ * Implementation notes: siftDown, siftUp
+ * --------------------------------------
+ * Rather than swapping an entry with its parent or child at each level,
+ * these methods hold the entry aside and move the others into the hole,
+ * writing the entry once at its final position.
+ */
 template <typename ValueType>
-void PriorityQueue<ValueType>::swapHeapEntries(int i1, int i2) {
-    HeapEntry entry = heap[i1];
-    heap[i1] = heap[i2];
-    heap[i2] = entry;
+void PriorityQueue<ValueType>::siftDown(int index) {
+    HeapEntry entry = std::move(heap[index]);
+    while (true) {
+        int first = HEAP_ARITY * index + 1;
+        if (first >= count) {
+            break;
+        }
+        int last = std::min(first + HEAP_ARITY, count);
+        int child = first;
+        for (int i = first + 1; i < last; i++) {
+            if (takesPriority(heap[i], heap[child])) {
+                child = i;
+            }
+        }
+        if (takesPriority(entry, heap[child])) {
+            break;
+        }
+        moveEntry(index, heap[child]);
+        index = child;
+    }
+    moveEntry(index, entry);
+}
+
+template <typename ValueType>
+void PriorityQueue<ValueType>::siftUp(int index) {
+    HeapEntry entry = std::move(heap[index]);
+    while (index > 0) {
+        int parent = (index - 1) / HEAP_ARITY;
+        if (takesPriority(heap[parent], entry)) {
+            break;
+        }
+        moveEntry(index, heap[parent]);
+        index = parent;
+    }
+    moveEntry(index, entry);
 }
 
 template <typename ValueType>
-bool PriorityQueue<ValueType>::takesPriority(int i1, int i2) {
-    if (heap[i1].priority < heap[i2].priority) {
+bool PriorityQueue<ValueType>::takesPriority(const HeapEntry& entry1, const HeapEntry& entry2) const {
+    if (entry1.priority < entry2.priority) {
         return true;
     }
-    if (heap[i1].priority > heap[i2].priority) {
+    if (entry1.priority > entry2.priority) {
         return false;
     }
-    return (heap[i1].sequence < heap[i2].sequence);
+    return (entry1.sequence < entry2.sequence);
 }
 
 template <typename ValueType>
@@ -4,6 +4,10 @@
  * This file exports the <code>Set</code> class, which implements a
  * collection for storing a set of distinct elements.
  * 
+ * @version 2026/10/17
+ * - set operators, addAll, removeAll, retainAll, isSubsetOf, containsAll and
+ *   equals merge the two sets in order in O(n + m) time; the in-place forms
+ *   relink this set's own nodes instead of copying them
  * @version 2016/12/09
  * - added iterator version checking support (implicitly via Map)
  * @version 2016/12/06
@@ -409,6 +413,8 @@ private:
     Map<ValueType, bool> map;            /* Map used to store the element     */
     bool removeFlag;                     /* Flag to differentiate += and -=   */
 
+    static bool isSmallEnoughForLookups(int count, int size);
+
 public:
     /*
      * Hidden features
@@ -454,8 +460,8 @@ public:
             /* Empty */
         }
 
-        iterator(const iterator& it) {
-            mapit = it.mapit;
+        iterator(const iterator& it) : mapit(it.mapit) {
+            /* Empty */
         }
 
         iterator& operator ++() {
@@ -517,8 +523,12 @@ void Set<ValueType>::add(const ValueType& value) {
 
 template <typename ValueType>
 Set<ValueType>& Set<ValueType>::addAll(const Set& set2) {
-    for (const ValueType& value : set2) {
-        this->add(value);
+    if (!isSmallEnoughForLookups(set2.size(), size()) && map.hasSameKeyOrder(set2.map)) {
+        map.mergeKeys(map, set2.map, Map<ValueType, bool>::KEYS_IN_EITHER);
+    } else {
+        for (const ValueType& value : set2) {
+            this->add(value);
+        }
     }
     return *this;
 }
@@ -543,12 +553,7 @@ bool Set<ValueType>::contains(const ValueType& value) const {
 
 template <typename ValueType>
 bool Set<ValueType>::containsAll(const Set<ValueType>& set2) const {
-    for (const ValueType& value : set2) {
-        if (!contains(value)) {
-            return false;
-        }
-    }
-    return true;
+    return set2.isSubsetOf(*this);
 }
 
 template <typename ValueType>
@@ -597,6 +602,9 @@ bool Set<ValueType>::isEmpty() const {
 
 template <typename ValueType>
 bool Set<ValueType>::isSubsetOf(const Set& set2) const {
+    if (!isSmallEnoughForLookups(size(), set2.size()) && map.hasSameKeyOrder(set2.map)) {
+        return map.isKeySubsetOf(set2.map);
+    }
     auto it = begin();
     auto end = this->end();
     while (it != end) {
@@ -647,6 +655,16 @@ void Set<ValueType>::remove(const ValueType& value) {
 
 template <typename ValueType>
 Set<ValueType>& Set<ValueType>::removeAll(const Set& set2) {
+    if (map.hasSameKeyOrder(set2.map)) {
+        if (isSmallEnoughForLookups(set2.size(), size())) {
+            for (const ValueType& value : set2) {
+                remove(value);
+            }
+        } else {
+            map.mergeKeys(map, set2.map, Map<ValueType, bool>::KEYS_IN_FIRST_ONLY);
+        }
+        return *this;
+    }
     Vector<ValueType> toRemove;
     for (const ValueType& value : *this) {
         if (set2.map.containsKey(value)) {
@@ -669,6 +687,10 @@ Set<ValueType>& Set<ValueType>::removeAll(std::initializer_list<ValueType> list)
 
 template <typename ValueType>
 Set<ValueType>& Set<ValueType>::retainAll(const Set& set2) {
+    if (map.hasSameKeyOrder(set2.map)) {
+        map.mergeKeys(map, set2.map, Map<ValueType, bool>::KEYS_IN_BOTH);
+        return *this;
+    }
     Vector<ValueType> toRemove;
     for (ValueType value : *this) {
         if (!set2.map.containsKey(value)) {
@@ -708,11 +730,31 @@ std::string Set<ValueType>::toString() const {
     return os.str();
 }
 
+/*
+ * Implementation notes: isSmallEnoughForLookups
+ * ----------------------------------------------
+ * Returns true if searching a set of the given size once for each of count
+ * elements is likely to be faster than merging the two sets, which visits
+ * every element of both.  A search makes about log2(size) comparisons, so
+ * lookups win when count * log2(size) is well below size.
+ */
+template <typename ValueType>
+bool Set<ValueType>::isSmallEnoughForLookups(int count, int size) {
+    int depth = 1;
+    while (depth < 31 && (1 << depth) < size) {
+        depth++;
+    }
+    return count < size / depth;
+}
+
 /*
  * Implementation notes: set operators
  * -----------------------------------
  * The implementations for the set operators use iteration to walk
- * over the elements in one or both sets.
+ * over the elements in one or both sets.  When both sets order their
+ * elements the same way (always true unless a set was given its own
+ * comparator), +, * and - walk both sets in order at once and build the
+ * result's tree directly from the merged elements, in O(n + m) time.
  */
 template <typename ValueType>
 bool Set<ValueType>::operator ==(const Set& set2) const {
@@ -746,8 +788,13 @@ bool Set<ValueType>::operator >=(const Set& set2) const {
 
 template <typename ValueType>
 Set<ValueType> Set<ValueType>::operator +(const Set& set2) const {
-    Set<ValueType> set = *this;
-    set.addAll(set2);
+    Set<ValueType> set;
+    if (map.hasSameKeyOrder(set2.map)) {
+        set.map.mergeKeys(map, set2.map, Map<ValueType, bool>::KEYS_IN_EITHER);
+    } else {
+        set = *this;
+        set.addAll(set2);
+    }
     return set;
 }
 
@@ -767,7 +814,12 @@ Set<ValueType> Set<ValueType>::operator +(const ValueType& element) const {
 
 template <typename ValueType>
 Set<ValueType> Set<ValueType>::operator *(const Set& set2) const {
-    Set<ValueType> set = *this;
+    Set<ValueType> set;
+    if (map.hasSameKeyOrder(set2.map)) {
+        set.map.mergeKeys(map, set2.map, Map<ValueType, bool>::KEYS_IN_BOTH);
+        return set;
+    }
+    set = *this;
     return set.retainAll(set2);
 }
 
@@ -779,7 +831,12 @@ Set<ValueType> Set<ValueType>::operator *(std::initializer_list<ValueType> list)
 
 template <typename ValueType>
 Set<ValueType> Set<ValueType>::operator -(const Set& set2) const {
-    Set<ValueType> set = *this;
+    Set<ValueType> set;
+    if (map.hasSameKeyOrder(set2.map)) {
+        set.map.mergeKeys(map, set2.map, Map<ValueType, bool>::KEYS_IN_FIRST_ONLY);
+        return set;
+    }
+    set = *this;
     return set.removeAll(set2);
 }
 
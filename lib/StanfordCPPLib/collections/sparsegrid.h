@@ -9,6 +9,11 @@
  * Grid is recommended for use over SparseGrid.
  * 
  * @author Marty Stepp
+ * @version 2026/10/17
+ * - stores cells in a hash table of dense 16x16 tiles with occupancy masks,
+ *   so get/set/isSet take O(1) time and size takes constant time
+ * - get no longer marks the cell it reads as set
+ * - randomElement picks uniformly among the set cells
  * @version 2017/11/14
  * - added iterator version checking support
  * @version 2016/10/22
@@ -38,7 +43,11 @@
 #ifndef _sparsegrid_h
 #define _sparsegrid_h
 
+#include <algorithm>
+#include <cstdint>
 #include <initializer_list>
+#include <unordered_map>
+#include <vector>
 #include "collections.h"
 #include "error.h"
 #include "hashcode.h"
@@ -329,19 +338,43 @@ public:
     /*
      * Implementation notes: SparseGrid data structure
      * -----------------------------------------
-     * The SparseGrid is internally managed as a dynamic array of elements.
-     * The array itself is one-dimensional, the logical separation into
-     * rows and columns is done by arithmetic computation.  The layout
-     * is in row-major order, which is to say that the entire first row
-     * is laid out contiguously, followed by the entire second row,
-     * and so on.
+     * The grid is divided into square tiles of TILE_SIZE x TILE_SIZE cells,
+     * and only the tiles that contain at least one set cell are stored, in
+     * a hash table keyed by the tile's row and column.  Each tile is a
+     * dense row-major array of cells plus one bit mask per row that records
+     * which cells have been set.  Finding a cell therefore takes one hash
+     * lookup and some bit arithmetic, and cells that are near each other in
+     * the grid are near each other in memory.
+     *
+     * Row-major traversals sort the keys of the stored tiles, then walk each
+     * band of tiles that share a tile row one grid row at a time, using the
+     * row masks to skip unset cells.
      */
 
 private:
+    static const int TILE_BITS = 4;
+    static const int TILE_SIZE = 1 << TILE_BITS;
+    static const int TILE_MASK = TILE_SIZE - 1;
+
+    typedef std::uint64_t TileKey;
+
+    struct Tile {
+        ValueType cells[TILE_SIZE * TILE_SIZE];   // row-major
+        unsigned int rowMasks[TILE_SIZE];         // bit c of rowMasks[r] is set if cell (r, c) is set
+        int count;                                // number of set cells
+
+        Tile() : cells(), count(0) {
+            for (int r = 0; r < TILE_SIZE; r++) {
+                rowMasks[r] = 0;
+            }
+        }
+    };
+
     /* Instance variables */
-    Map<int, Map<int, ValueType> > elements;  // 2D map of the elements
+    std::unordered_map<TileKey, Tile> tiles;   // the tiles that have set cells
     int nRows;            // The number of rows in the grid
     int nCols;            // The number of columns in the grid
+    int count;            // The number of set cells
     unsigned int m_version;     // structure version for detecting invalid iterators
 
     /* Private method prototypes */
@@ -359,6 +392,50 @@ private:
                       std::string prefix) const;
     int gridCompare(const SparseGrid& grid2) const;
 
+    /*
+     * Returns the value that unset cells read as.
+     */
+    static const ValueType& emptyValue() {
+        static const ValueType value = ValueType();
+        return value;
+    }
+
+    /*
+     * Returns the tile containing the given cell, or nullptr if none of that
+     * tile's cells are set.
+     */
+    const Tile* findTile(int row, int col) const {
+        auto it = tiles.find(tileKey(row, col));
+        return it == tiles.end() ? nullptr : &it->second;
+    }
+
+    /*
+     * Calls fn(row, col, value) for every set cell, in row-major order.
+     */
+    template <typename FunctorType>
+    void forEachSetCell(FunctorType fn) const;
+
+    /*
+     * Returns a reference to the given cell, marking it as set first if it
+     * was not, and creating its tile if needed.
+     */
+    ValueType& setCell(int row, int col) {
+        Tile& tile = tiles[tileKey(row, col)];
+        unsigned int bit = 1u << (col & TILE_MASK);
+        unsigned int& mask = tile.rowMasks[row & TILE_MASK];
+        if (!(mask & bit)) {
+            mask |= bit;
+            tile.count++;
+            count++;
+        }
+        return tile.cells[(row & TILE_MASK) * TILE_SIZE + (col & TILE_MASK)];
+    }
+
+    static TileKey tileKey(int row, int col) {
+        return ((TileKey) (unsigned int) (row >> TILE_BITS) << 32)
+                | (TileKey) (unsigned int) (col >> TILE_BITS);
+    }
+
     /*
      * Hidden features
      * ---------------
@@ -382,9 +459,11 @@ private:
      * are supported.
      */
     void deepCopy(const SparseGrid& grid) {
-        elements = grid.elements;
+        tiles = grid.tiles;
         nRows = grid.nRows;
         nCols = grid.nCols;
+        count = grid.count;
+        m_version++;
     }
 
     template <typename T>
@@ -404,7 +483,7 @@ public:
         return *this;
     }
 
-    SparseGrid(const SparseGrid& src) {
+    SparseGrid(const SparseGrid& src) : m_version(0) {
         deepCopy(src);
     }
 
@@ -414,20 +493,27 @@ public:
      * The classes in the StanfordCPPLib collection implement input
      * iterators so that they work symmetrically with respect to the
      * corresponding STL classes.
+     *
+     * The iterator visits every cell, set or not, and remembers the last
+     * tile it looked up, so it needs one hash lookup per TILE_SIZE cells.
      */
     class iterator : public std::iterator<std::input_iterator_tag, ValueType> {
     public:
         iterator(const SparseGrid* gp, int index)
                 : gp(gp),
                   index(index),
-                  itr_version(gp->version()) {
+                  itr_version(gp->version()),
+                  tile(nullptr),
+                  key(~(TileKey) 0) {
             // empty
         }
 
         iterator(const iterator& it)
                 : gp(it.gp),
                   index(it.index),
-                  itr_version(it.itr_version) {
+                  itr_version(it.itr_version),
+                  tile(it.tile),
+                  key(it.key) {
             // empty
         }
 
@@ -454,16 +540,12 @@ public:
 
         ValueType operator *() {
             stanfordcpplib::collections::checkVersion(*gp, *this);
-            int row = index / gp->nCols;
-            int col = index % gp->nCols;
-            return gp->elements[row][col];
+            return cell();
         }
 
         ValueType* operator ->() {
             stanfordcpplib::collections::checkVersion(*gp, *this);
-            int row = index / gp->nCols;
-            int col = index % gp->nCols;
-            return &gp->elements[row][col];
+            return const_cast<ValueType*>(&cell());
         }
 
         unsigned int version() const {
@@ -471,9 +553,25 @@ public:
         }
 
     private:
+        const ValueType& cell() {
+            int row = index / gp->nCols;
+            int col = index % gp->nCols;
+            TileKey cellKey = tileKey(row, col);
+            if (cellKey != key) {
+                key = cellKey;
+                tile = gp->findTile(row, col);
+            }
+            if (!tile) {
+                return emptyValue();
+            }
+            return tile->cells[(row & TILE_MASK) * TILE_SIZE + (col & TILE_MASK)];
+        }
+
         const SparseGrid* gp;
         int index;
         unsigned int itr_version;
+        const Tile* tile;   // tile containing the last cell read, or nullptr
+        TileKey key;        // key of that tile
     };
 
     iterator begin() const {
@@ -504,12 +602,12 @@ public:
 
         ValueType& operator [](int col) {
             gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
-            return gp->elements[row][col];
+            return gp->setCell(row, col);
         }
 
         const ValueType& operator [](int col) const {
             gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
-            return gp->elements[row][col];
+            return gp->setCell(row, col);
         }
 
     private:
@@ -532,7 +630,8 @@ public:
 
         const ValueType operator [](int col) const {
             gp->checkIndexes(row, col, gp->nRows-1, gp->nCols-1, "operator [][]");
-            return gp->elements[row][col];
+            const Tile* tile = gp->findTile(row, col);
+            return tile ? tile->cells[(row & TILE_MASK) * TILE_SIZE + (col & TILE_MASK)] : ValueType();
         }
 
     private:
@@ -551,19 +650,26 @@ template <typename ValueType>
 SparseGrid<ValueType>::SparseGrid()
         : nRows(0),
           nCols(0),
+          count(0),
           m_version(0) {
     // empty
 }
 
 template <typename ValueType>
 SparseGrid<ValueType>::SparseGrid(int nRows, int nCols)
-        : m_version(0) {
+        : nRows(0),
+          nCols(0),
+          count(0),
+          m_version(0) {
     resize(nRows, nCols);
 }
 
 template <typename ValueType>
 SparseGrid<ValueType>::SparseGrid(int nRows, int nCols, const ValueType& value)
-        : m_version(0) {
+        : nRows(0),
+          nCols(0),
+          count(0),
+          m_version(0) {
     resize(nRows, nCols);
     fill(value);
 }
@@ -572,6 +678,7 @@ template <typename ValueType>
 SparseGrid<ValueType>::SparseGrid(std::initializer_list<std::initializer_list<ValueType> > list)
         : nRows(0),
           nCols(0),
+          count(0),
           m_version(0) {
     // create the grid at the proper size
     nRows = list.size();
@@ -607,19 +714,26 @@ bool SparseGrid<ValueType>::equals(const SparseGrid<ValueType>& grid2) const {
     if (this == &grid2) {
         return true;
     }
-    if (nRows != grid2.nRows || nCols != grid2.nCols) {
+    if (nRows != grid2.nRows || nCols != grid2.nCols || count != grid2.count) {
         return false;
     }
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            if (isSet(row, col)) {
-                // I have data there; he must, too, and it must be the same data
-                if (!grid2.isSet(row, col) || get(row, col) != grid2.get(row, col)) {
-                    return false;
-                }
-            } else {
-                // I don't have data there; he must also not have it there
-                if (grid2.isSet(row, col)) {
+
+    // both grids set the same number of cells, so if every cell set here
+    // is set there to the same value, they set the same cells
+    for (const auto& entry : tiles) {
+        const Tile& tile = entry.second;
+        auto it = grid2.tiles.find(entry.first);
+        if (it == grid2.tiles.end()) {
+            return false;
+        }
+        const Tile& tile2 = it->second;
+        for (int r = 0; r < TILE_SIZE; r++) {
+            if (tile.rowMasks[r] != tile2.rowMasks[r]) {
+                return false;
+            }
+            for (unsigned int mask = tile.rowMasks[r]; mask != 0; mask &= mask - 1) {
+                int i = r * TILE_SIZE + __builtin_ctz(mask);
+                if (tile.cells[i] != tile2.cells[i]) {
                     return false;
                 }
             }
@@ -628,25 +742,77 @@ bool SparseGrid<ValueType>::equals(const SparseGrid<ValueType>& grid2) const {
     return true;
 }
 
+/*
+ * Implementation notes: fill
+ * --------------------------
+ * Fills whole tiles at once rather than setting one cell at a time.
+ */
 template <typename ValueType>
 void SparseGrid<ValueType>::fill(const ValueType& value) {
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            set(row, col, value);
+    for (int tileRow = 0; tileRow < nRows; tileRow += TILE_SIZE) {
+        for (int tileCol = 0; tileCol < nCols; tileCol += TILE_SIZE) {
+            int rows = nRows - tileRow < TILE_SIZE ? nRows - tileRow : TILE_SIZE;
+            int cols = nCols - tileCol < TILE_SIZE ? nCols - tileCol : TILE_SIZE;
+            unsigned int fullMask = (1u << cols) - 1;
+            Tile& tile = tiles[tileKey(tileRow, tileCol)];
+            for (int r = 0; r < rows; r++) {
+                std::fill(tile.cells + r * TILE_SIZE, tile.cells + r * TILE_SIZE + cols, value);
+                tile.rowMasks[r] = fullMask;
+            }
+            count += rows * cols - tile.count;
+            tile.count = rows * cols;
+        }
+    }
+    m_version++;
+}
+
+template <typename ValueType>
+template <typename FunctorType>
+void SparseGrid<ValueType>::forEachSetCell(FunctorType fn) const {
+    std::vector<TileKey> keys;
+    keys.reserve(tiles.size());
+    for (const auto& entry : tiles) {
+        keys.push_back(entry.first);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<const Tile*> band;
+    for (int first = 0; first < (int) keys.size(); ) {
+        // gather the tiles in this tile row, which are sorted by tile column
+        int tileRow = (int) (keys[first] >> 32);
+        int last = first;
+        band.clear();
+        while (last < (int) keys.size() && (int) (keys[last] >> 32) == tileRow) {
+            band.push_back(&tiles.find(keys[last])->second);
+            last++;
         }
+        for (int r = 0; r < TILE_SIZE; r++) {
+            int row = (tileRow << TILE_BITS) + r;
+            for (int i = first; i < last; i++) {
+                const Tile* tile = band[i - first];
+                int colBase = (int) (unsigned int) keys[i] << TILE_BITS;
+                for (unsigned int mask = tile->rowMasks[r]; mask != 0; mask &= mask - 1) {
+                    int c = __builtin_ctz(mask);
+                    fn(row, colBase + c, tile->cells[r * TILE_SIZE + c]);
+                }
+            }
+        }
+        first = last;
     }
 }
 
 template <typename ValueType>
 ValueType SparseGrid<ValueType>::get(int row, int col) {
     checkIndexes(row, col, nRows-1, nCols-1, "get");
-    return elements[row][col];
+    const Tile* tile = findTile(row, col);
+    return tile ? tile->cells[(row & TILE_MASK) * TILE_SIZE + (col & TILE_MASK)] : ValueType();
 }
 
 template <typename ValueType>
 const ValueType& SparseGrid<ValueType>::get(int row, int col) const {
     checkIndexes(row, col, nRows-1, nCols-1, "get");
-    return elements[row][col];
+    const Tile* tile = findTile(row, col);
+    return tile ? tile->cells[(row & TILE_MASK) * TILE_SIZE + (col & TILE_MASK)] : emptyValue();
 }
 
 template <typename ValueType>
@@ -661,47 +827,38 @@ bool SparseGrid<ValueType>::inBounds(int row, int col) const {
 
 template <typename ValueType>
 bool SparseGrid<ValueType>::isEmpty() const {
-    return elements.isEmpty();
+    return count == 0;
 }
 
 template <typename ValueType>
 bool SparseGrid<ValueType>::isSet(int row, int col) const {
-    return inBounds(row, col) && elements.containsKey(row) &&
-            elements[row].containsKey(col);
+    if (!inBounds(row, col)) {
+        return false;
+    }
+    const Tile* tile = findTile(row, col);
+    return tile && (tile->rowMasks[row & TILE_MASK] & (1u << (col & TILE_MASK)));
 }
 
 template <typename ValueType>
 void SparseGrid<ValueType>::mapAll(void (*fn)(ValueType value)) const {
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            if (isSet(row, col)) {
-                fn(get(row, col));
-            }
-        }
-    }
+    forEachSetCell([fn](int, int, const ValueType& value) {
+        fn(value);
+    });
 }
 
 template <typename ValueType>
 void SparseGrid<ValueType>::mapAll(void (*fn)(const ValueType & value)) const {
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            if (isSet(row, col)) {
-                fn(get(row, col));
-            }
-        }
-    }
+    forEachSetCell([fn](int, int, const ValueType& value) {
+        fn(value);
+    });
 }
 
 template <typename ValueType>
 template <typename FunctorType>
 void SparseGrid<ValueType>::mapAll(FunctorType fn) const {
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            if (isSet(row, col)) {
-                fn(get(row, col));
-            }
-        }
-    }
+    forEachSetCell([&fn](int, int, const ValueType& value) {
+        fn(value);
+    });
 }
 
 template <typename ValueType>
@@ -729,24 +886,36 @@ void SparseGrid<ValueType>::resize(int nRows, int nCols, bool retain) {
     
     if (retain) {
         // if resizing to a smaller size, must evict any row/col entries
-        // that exceed the new grid's bounds
+        // that exceed the new grid's bounds; tiles that straddle the new
+        // edge keep their in-bounds cells
         if (nRows < oldnRows || nCols < oldnCols) {
-            Map<int, Map<int, ValueType> > newElements;
-            for (int row : elements) {
-                if (row >= nRows) {
-                    break;   // don't add any entries beyond this row
-                }
-                for (int col : elements[row]) {
-                    if (col >= nCols) {
-                        break;   // don't add any entries beyond this row
+            for (auto it = tiles.begin(); it != tiles.end(); ) {
+                int tileRow = (int) (it->first >> 32) << TILE_BITS;
+                int tileCol = (int) (unsigned int) it->first << TILE_BITS;
+                Tile& tile = it->second;
+                for (int r = 0; r < TILE_SIZE; r++) {
+                    unsigned int keep = 0;
+                    if (tileRow + r < nRows) {
+                        int cols = nCols - tileCol;
+                        keep = cols >= TILE_SIZE ? ~0u : cols <= 0 ? 0u : (1u << cols) - 1;
+                    }
+                    for (unsigned int mask = tile.rowMasks[r] & ~keep; mask != 0; mask &= mask - 1) {
+                        tile.cells[r * TILE_SIZE + __builtin_ctz(mask)] = ValueType();
+                        tile.count--;
+                        count--;
                     }
-                    newElements[row][col] = elements[row][col];
+                    tile.rowMasks[r] &= keep;
+                }
+                if (tile.count == 0) {
+                    it = tiles.erase(it);
+                } else {
+                    ++it;
                 }
             }
-            elements = newElements;
         }
     } else {
-        elements.clear();
+        tiles.clear();
+        count = 0;
     }
     m_version++;
 }
@@ -754,16 +923,12 @@ void SparseGrid<ValueType>::resize(int nRows, int nCols, bool retain) {
 template <typename ValueType>
 void SparseGrid<ValueType>::set(int row, int col, const ValueType& value) {
     checkIndexes(row, col, nRows-1, nCols-1, "set");
-    elements[row][col] = value;
+    setCell(row, col) = value;
     m_version++;
 }
 
 template <typename ValueType>
 int SparseGrid<ValueType>::size() const {
-    int count = 0;
-    for (int row : elements) {
-        count += elements[row].size();
-    }
     return count;
 }
 
@@ -778,12 +943,23 @@ template <typename ValueType>
 std::string SparseGrid<ValueType>::toString2D(
         std::string rowStart, std::string rowEnd,
         std::string colSeparator, std::string rowSeparator) const {
+    // note which rows have any cells set
+    std::vector<bool> rowIsSet(nRows, false);
+    for (const auto& entry : tiles) {
+        int tileRow = (int) (entry.first >> 32) << TILE_BITS;
+        for (int r = 0; r < TILE_SIZE; r++) {
+            if (entry.second.rowMasks[r]) {
+                rowIsSet[tileRow + r] = true;
+            }
+        }
+    }
+
     std::ostringstream os;
     os << rowStart;
     int nRows = numRows();
     int nCols = numCols();
     for (int i = 0; i < nRows; i++) {
-        if (!elements.containsKey(i) || elements[i].isEmpty()) {
+        if (!rowIsSet[i]) {
             continue;
         }
         if (i > 0) {
@@ -923,7 +1099,26 @@ bool SparseGrid<ValueType>::operator >=(const SparseGrid& grid2) const {
  */
 template <typename ValueType>
 std::ostream& operator <<(std::ostream& os, const SparseGrid<ValueType>& grid) {
-    os << grid.elements << ", " << grid.nRows << " x " << grid.nCols;
+    // same format as printing a Map<int, Map<int, ValueType> > of the set cells
+    os << "{";
+    int lastRow = -1;
+    grid.forEachSetCell([&os, &lastRow](int row, int col, const ValueType& value) {
+        if (row != lastRow) {
+            if (lastRow >= 0) {
+                os << "}, ";
+            }
+            os << row << ":{";
+            lastRow = row;
+        } else {
+            os << ", ";
+        }
+        os << col << ":";
+        writeGenericValue(os, value, /* forceQuotes */ true);
+    });
+    if (lastRow >= 0) {
+        os << "}";
+    }
+    os << "}, " << grid.nRows << " x " << grid.nCols;
     return os;
 }
 
@@ -932,7 +1127,8 @@ std::istream& operator >>(std::istream& is, SparseGrid<ValueType>& grid) {
     // "{...}, 4 x 3"
 
     // read "{...}" (map of elements)
-    if (!(is >> grid.elements)) {
+    Map<int, Map<int, ValueType> > elements;
+    if (!(is >> elements)) {
 #ifdef SPL_ERROR_ON_COLLECTION_PARSE
         error("SparseGrid::operator >>: Invalid elements");
 #endif
@@ -950,7 +1146,8 @@ std::istream& operator >>(std::istream& is, SparseGrid<ValueType>& grid) {
         return is;
     }
 
-    if (!(is >> grid.nRows)) {
+    int nRows;
+    if (!(is >> nRows)) {
 #ifdef SPL_ERROR_ON_COLLECTION_PARSE
         error("SparseGrid::operator >>: Invalid number of rows");
 #endif
@@ -961,13 +1158,28 @@ std::istream& operator >>(std::istream& is, SparseGrid<ValueType>& grid) {
     std::string x;
     is >> x;       // throw away 'x' token
 
-    if (!(is >> grid.nCols)) {
+    int nCols;
+    if (!(is >> nCols) || nRows < 0 || nCols < 0) {
 #ifdef SPL_ERROR_ON_COLLECTION_PARSE
         error("SparseGrid::operator >>: Invalid number of rows");
 #endif
         is.setstate(std::ios_base::failbit);
         return is;
     }
+
+    grid.resize(nRows, nCols);
+    for (int row : elements) {
+        for (int col : elements[row]) {
+            if (!grid.inBounds(row, col)) {
+#ifdef SPL_ERROR_ON_COLLECTION_PARSE
+                error("SparseGrid::operator >>: Element outside of grid");
+#endif
+                is.setstate(std::ios_base::failbit);
+                return is;
+            }
+            grid.set(row, col, elements[row][col]);
+        }
+    }
     return is;
 }
 
@@ -993,11 +1205,23 @@ const T& randomElement(const SparseGrid<T>& grid) {
         error("randomElement: empty sparse grid was passed");
     }
     
-    // pick a non-empty row, then pick a random element from it
-    // TODO: fix, this is NOT evenly distributed when rows/cols are unequal in size
-    int row = randomKey(grid.elements);
-    int col = randomKey(grid.elements[row]);
-    return grid.get(row, col);
+    // count off a random number of set cells, skipping whole tiles at a time
+    int index = randomInteger(0, grid.count - 1);
+    for (const auto& entry : grid.tiles) {
+        const typename SparseGrid<T>::Tile& tile = entry.second;
+        if (index >= tile.count) {
+            index -= tile.count;
+            continue;
+        }
+        for (int r = 0; r < SparseGrid<T>::TILE_SIZE; r++) {
+            for (unsigned int mask = tile.rowMasks[r]; mask != 0; mask &= mask - 1) {
+                if (index-- == 0) {
+                    return tile.cells[r * SparseGrid<T>::TILE_SIZE + __builtin_ctz(mask)];
+                }
+            }
+        }
+    }
+    return SparseGrid<T>::emptyValue();   // not reached
 }
 
 #include "private/init.h"   // ensure that Stanford C++ lib is initialized
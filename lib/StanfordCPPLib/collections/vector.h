@@ -4,6 +4,12 @@
  * This file exports the <code>Vector</code> class, which provides an
  * efficient, safe, convenient replacement for the array type in C++.
  *
+ * @version 2026/10/17
+ * - store elements in uninitialized storage; construct/destroy them in place
+ * - added move constructor/assignment, move overloads of add/insert/set,
+ *   and emplace_back
+ * - elements are moved rather than copied when the array grows or shifts
+ * - added SPL_UNCHECKED_VECTOR flag to skip index and iterator version checks
  * @version 2018/01/07
  * - added front, back, removeFront, removeBack, pop_front, pop_back, push_front
  * @version 2017/11/15
@@ -46,8 +52,11 @@
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <new>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 #include "collections.h"
 #include "error.h"
@@ -63,6 +72,11 @@
  * also supports inserting and deleting elements.  It is similar in
  * function to the STL <code>vector</code> type, but is simpler both
  * to use and to implement.
+ *
+ * If SPL_UNCHECKED_VECTOR is defined, the index range checks and the
+ * bookkeeping used to detect invalidated iterators are compiled out.
+ * This is meant for release builds of programs that are already known
+ * to use their vectors correctly.
  */
 template <typename ValueType>
 class Vector {
@@ -106,6 +120,7 @@ public:
      * Adds a new value to the end of this vector.
      */
     void add(const ValueType& value);
+    void add(ValueType&& value);
 
     /*
      * Method: addAll
@@ -146,6 +161,16 @@ public:
      */
     bool contains(const ValueType& value) const;
 
+    /*
+     * Method: emplace_back
+     * Usage: vec.emplace_back(arg1, arg2, ...);
+     * -----------------------------------------
+     * Adds a new value to the end of this vector, constructing it in place
+     * from the given constructor arguments rather than copying it.
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args);
+
     /*
      * Method: ensureCapacity
      * Usage: vec.ensureCapacity(n);
@@ -205,6 +230,7 @@ public:
      * up to and including the length of the vector.
      */
     void insert(int index, const ValueType& value);
+    void insert(int index, ValueType&& value);
 
     /*
      * Method: isEmpty
@@ -266,6 +292,7 @@ public:
      * with the <code>vector</code> class in the Standard Template Library.
      */
     void push_back(const ValueType& value);
+    void push_back(ValueType&& value);
 
     /*
      * Method: push_front
@@ -334,7 +361,8 @@ public:
      * This method signals an error if the index is not in the array range.
      */
     void set(int index, const ValueType& value);
-    
+    void set(int index, ValueType&& value);
+
     /*
      * Method: size
      * Usage: int nElems = vec.size();
@@ -486,6 +514,11 @@ private:
      * The elements of the Vector are stored in a dynamic array of
      * the specified element type.  If the space in the array is ever
      * exhausted, the implementation doubles the array capacity.
+     *
+     * The array is allocated as raw storage; only the first count slots
+     * hold constructed elements.  Growing the array or shifting elements
+     * moves them rather than copying them, and unused slots are never
+     * default-constructed.
      */
 
     /* Instance variables */
@@ -509,6 +542,27 @@ private:
     void expandCapacity();
     void deepCopy(const Vector& src);
 
+    /*
+     * Allocates raw storage for the given number of elements
+     * without constructing any of them.
+     */
+    static ValueType* allocate(int cap);
+
+    /*
+     * Destroys all elements and frees the array storage.
+     */
+    void freeElements();
+
+    /*
+     * Moves the elements into a new array of the given capacity.
+     */
+    void reallocate(int newCapacity);
+
+    /*
+     * Records a structural change so that existing iterators become invalid.
+     */
+    void updateVersion();
+
     /*
      * Hidden features
      * ---------------
@@ -529,6 +583,15 @@ public:
     Vector(const Vector& src);
     Vector& operator =(const Vector& src);
 
+    /*
+     * Move support
+     * ------------
+     * This move constructor and operator= take over the other vector's
+     * array, leaving the other vector empty.
+     */
+    Vector(Vector&& src);
+    Vector& operator =(Vector&& src);
+
     /*
      * Operator: ,
      * -----------
@@ -733,31 +796,29 @@ Vector<ValueType>::Vector(int n, ValueType value)
     if (n < 0) {
         error("Vector::constructor: n cannot be negative: " + integerToString(n));
     } else if (n > 0) {
-        elements = new ValueType[n];
-        for (int i = 0; i < n; i++) {
-            elements[i] = value;
-        }
+        elements = allocate(n);
+        std::uninitialized_fill(elements, elements + n, value);
     }
 }
 
 template <typename ValueType>
 Vector<ValueType>::Vector(const std::vector<ValueType>& v)
-        : m_version(0) {
-    count = v.size();
-    capacity = v.size();
-    elements = new ValueType[count];
-    for (int i = 0; i < count; i++) {
-        elements[i] = v[i];
-    }
+        : elements(nullptr),
+          capacity((int) v.size()),
+          count((int) v.size()),
+          m_version(0) {
+    elements = allocate(capacity);
+    std::uninitialized_copy(v.begin(), v.end(), elements);
 }
 
 template <typename ValueType>
 Vector<ValueType>::Vector(std::initializer_list<ValueType> list)
-        : count(0),
+        : elements(nullptr),
+          capacity((int) list.size()),
+          count((int) list.size()),
           m_version(0) {
-    capacity = list.size();
-    elements = new ValueType[capacity];
-    addAll(list);
+    elements = allocate(capacity);
+    std::uninitialized_copy(list.begin(), list.end(), elements);
 }
 
 /*
@@ -767,16 +828,29 @@ Vector<ValueType>::Vector(std::initializer_list<ValueType> list)
  * as described in the associated textbook.
  */
 template <typename ValueType>
-Vector<ValueType>::Vector(const Vector& src) {
+Vector<ValueType>::Vector(const Vector& src)
+        : elements(nullptr),
+          capacity(0),
+          count(0),
+          m_version(0) {
     deepCopy(src);
 }
 
+template <typename ValueType>
+Vector<ValueType>::Vector(Vector&& src)
+        : elements(src.elements),
+          capacity(src.capacity),
+          count(src.count),
+          m_version(0) {
+    src.elements = nullptr;
+    src.capacity = 0;
+    src.count = 0;
+    src.updateVersion();
+}
+
 template <typename ValueType>
 Vector<ValueType>::~Vector() {
-    if (elements) {
-        delete[] elements;
-        elements = nullptr;
-    }
+    freeElements();
 }
 
 /*
@@ -790,22 +864,41 @@ void Vector<ValueType>::add(const ValueType& value) {
     insert(count, value);
 }
 
+template <typename ValueType>
+void Vector<ValueType>::add(ValueType&& value) {
+    insert(count, std::move(value));
+}
+
+// implementation note: reserves room for all new elements up front, and
+// copies by index so that v.addAll(v) works
 template <typename ValueType>
 Vector<ValueType>& Vector<ValueType>::addAll(const Vector<ValueType>& v) {
-    for (const ValueType& value : v) {
-        add(value);
+    int n = v.count;
+    ensureCapacity(count + n);
+    for (int i = 0; i < n; i++) {
+        new (elements + count) ValueType(v.elements[i]);
+        count++;
     }
+    updateVersion();
     return *this;   // BUGFIX 2014/04/27
 }
 
 template <typename ValueType>
 Vector<ValueType>& Vector<ValueType>::addAll(std::initializer_list<ValueType> list) {
+    ensureCapacity(count + (int) list.size());
     for (const ValueType& value : list) {
-        add(value);
+        new (elements + count) ValueType(value);
+        count++;
     }
+    updateVersion();
     return *this;
 }
 
+template <typename ValueType>
+ValueType* Vector<ValueType>::allocate(int cap) {
+    return static_cast<ValueType*>(::operator new(sizeof(ValueType) * cap));
+}
+
 template <typename ValueType>
 ValueType& Vector<ValueType>::back() {
     if (isEmpty()) {
@@ -824,13 +917,8 @@ const ValueType& Vector<ValueType>::back() const {
 
 template <typename ValueType>
 void Vector<ValueType>::clear() {
-    if (elements) {
-        delete[] elements;
-    }
-    count = 0;
-    capacity = 0;
-    elements = nullptr;
-    m_version++;
+    freeElements();
+    updateVersion();
 }
 
 template <typename ValueType>
@@ -844,18 +932,21 @@ bool Vector<ValueType>::contains(const ValueType& value) const {
 template <typename ValueType>
 void Vector<ValueType>::ensureCapacity(int cap) {
     if (cap >= 1 && capacity < cap) {
-        capacity = std::max(cap, capacity * 2);
-        ValueType* array = new ValueType[capacity];
-        if (elements) {
-            for (int i = 0; i < count; i++) {
-                array[i] = elements[i];
-            }
-            delete[] elements;
-        }
-        elements = array;
+        reallocate(std::max(cap, capacity * 2));
     }
 }
 
+template <typename ValueType>
+template <typename... Args>
+void Vector<ValueType>::emplace_back(Args&&... args) {
+    if (count == capacity) {
+        expandCapacity();
+    }
+    new (elements + count) ValueType(std::forward<Args>(args)...);
+    count++;
+    updateVersion();
+}
+
 template <typename ValueType>
 bool Vector<ValueType>::equals(const Vector<ValueType>& v) const {
     return stanfordcpplib::collections::equals(*this, v);
@@ -864,21 +955,26 @@ bool Vector<ValueType>::equals(const Vector<ValueType>& v) const {
 /*
  * Implementation notes: expandCapacity
  * ------------------------------------
- * This function doubles the array capacity, copies the old elements
+ * This function doubles the array capacity, moves the old elements
  * into the new array, and then frees the old one.
  * See also: ensureCapacity
  */
 template <typename ValueType>
 void Vector<ValueType>::expandCapacity() {
-    capacity = std::max(1, capacity * 2);
-    ValueType* array = new ValueType[capacity];
+    reallocate(std::max(1, capacity * 2));
+}
+
+template <typename ValueType>
+void Vector<ValueType>::freeElements() {
     if (elements) {
         for (int i = 0; i < count; i++) {
-            array[i] = elements[i];
+            elements[i].~ValueType();
         }
-        delete[] elements;
+        ::operator delete(elements);
+        elements = nullptr;
     }
-    elements = array;
+    count = 0;
+    capacity = 0;
 }
 
 template <typename ValueType>
@@ -918,20 +1014,34 @@ int Vector<ValueType>::indexOf(const ValueType& value) const {
  * -----------------------------------------
  * These methods must shift the existing elements in the array to
  * make room for a new element or to close up the space left by a
- * deleted one.
+ * deleted one.  The last element is moved into the uninitialized slot
+ * past the end, and the rest are moved one slot over.
  */
 template <typename ValueType>
 void Vector<ValueType>::insert(int index, const ValueType& value) {
+    // copy first, in case value refers to an element of this vector
+    insert(index, ValueType(value));
+}
+
+template <typename ValueType>
+void Vector<ValueType>::insert(int index, ValueType&& value) {
     checkIndex(index, 0, count, "insert");
     if (count == capacity) {
+        // value may refer to an element of the old array; take it out first
+        ValueType temp(std::move(value));
         expandCapacity();
+        insert(index, std::move(temp));
+        return;
     }
-    for (int i = count; i > index; i--) {
-        elements[i] = elements[i - 1];
+    if (index == count) {
+        new (elements + count) ValueType(std::move(value));
+    } else {
+        new (elements + count) ValueType(std::move(elements[count - 1]));
+        std::move_backward(elements + index, elements + count - 1, elements + count);
+        elements[index] = std::move(value);
     }
-    elements[index] = value;
     count++;
-    m_version++;
+    updateVersion();
 }
 
 template <typename ValueType>
@@ -982,7 +1092,7 @@ ValueType Vector<ValueType>::pop_back() {
     if (isEmpty()) {
         error("Vector::pop_back: vector is empty");
     }
-    ValueType last = elements[count - 1];
+    ValueType last = std::move(elements[count - 1]);
     remove(count - 1);
     return last;
 }
@@ -992,7 +1102,7 @@ ValueType Vector<ValueType>::pop_front() {
     if (isEmpty()) {
         error("Vector::pop_front: vector is empty");
     }
-    ValueType first = elements[0];
+    ValueType first = std::move(elements[0]);
     remove(0);
     return first;
 }
@@ -1002,6 +1112,11 @@ void Vector<ValueType>::push_back(const ValueType& value) {
     insert(count, value);
 }
 
+template <typename ValueType>
+void Vector<ValueType>::push_back(ValueType&& value) {
+    insert(count, std::move(value));
+}
+
 template <typename ValueType>
 void Vector<ValueType>::push_front(const ValueType& value) {
     insert(0, value);
@@ -1010,11 +1125,10 @@ void Vector<ValueType>::push_front(const ValueType& value) {
 template <typename ValueType>
 void Vector<ValueType>::remove(int index) {
     checkIndex(index, 0, count-1, "remove");
-    for (int i = index; i < count - 1; i++) {
-        elements[i] = elements[i + 1];
-    }
+    std::move(elements + index + 1, elements + count, elements + index);
+    elements[count - 1].~ValueType();
     count--;
-    m_version++;
+    updateVersion();
 }
 
 template <typename ValueType>
@@ -1048,6 +1162,12 @@ void Vector<ValueType>::set(int index, const ValueType& value) {
     elements[index] = value;
 }
 
+template <typename ValueType>
+void Vector<ValueType>::set(int index, ValueType&& value) {
+    checkIndex(index, 0, count-1, "set");
+    elements[index] = std::move(value);
+}
+
 template <typename ValueType>
 int Vector<ValueType>::size() const {
     return count;
@@ -1076,19 +1196,18 @@ Vector<ValueType> Vector<ValueType>::subList(int start, int length) const {
         error("Vector::subList: length cannot be negative");
     }
     Vector<ValueType> result;
-    for (int i = start; i < start + length; i++) {
-        result.add(get(i));
+    if (length > 0) {
+        result.elements = allocate(length);
+        result.capacity = length;
+        std::uninitialized_copy(elements + start, elements + start + length, result.elements);
+        result.count = length;
     }
     return result;
 }
 
 template <typename ValueType>
 std::vector<ValueType> Vector<ValueType>::toStlVector() const {
-    std::vector<ValueType> v;
-    for (int i = 0; i < count; i++) {
-        v.push_back(elements[i]);
-    }
-    return v;
+    return std::vector<ValueType>(elements, elements + count);
 }
 
 template <typename ValueType>
@@ -1181,14 +1300,34 @@ bool Vector<ValueType>::operator >=(const Vector& v2) const {
 template <typename ValueType>
 Vector<ValueType> & Vector<ValueType>::operator =(const Vector& src) {
     if (this != &src) {
-        if (elements) {
-            delete[] elements;
-        }
+        freeElements();
         deepCopy(src);
     }
     return *this;
 }
 
+template <typename ValueType>
+Vector<ValueType> & Vector<ValueType>::operator =(Vector&& src) {
+    if (this != &src) {
+        freeElements();
+        elements = src.elements;
+        capacity = src.capacity;
+        count = src.count;
+        updateVersion();
+        src.elements = nullptr;
+        src.capacity = 0;
+        src.count = 0;
+        src.updateVersion();
+    }
+    return *this;
+}
+
+#ifdef SPL_UNCHECKED_VECTOR
+template <typename ValueType>
+void Vector<ValueType>::checkIndex(int, int, int, std::string) const {
+    // empty
+}
+#else // SPL_UNCHECKED_VECTOR
 template <typename ValueType>
 void Vector<ValueType>::checkIndex(int index, int min, int max, std::string prefix) const {
     if (index < min || index > max) {
@@ -1209,19 +1348,56 @@ void Vector<ValueType>::checkIndex(int index, int min, int max, std::string pref
         error(out.str());
     }
 }
+#endif // SPL_UNCHECKED_VECTOR
 
 // implementation notes:
 // doesn't free this->elements because deepCopy is only called in cases where
 // elements is either null (at construction) or has just been freed (operator =)
 template <typename ValueType>
 void Vector<ValueType>::deepCopy(const Vector& src) {
-    count = src.count;
+    elements = (src.count == 0) ? nullptr : allocate(src.count);
     capacity = src.count;
-    elements = (capacity == 0) ? nullptr : new ValueType[capacity];
-    for (int i = 0; i < count; i++) {
-        elements[i] = src.elements[i];
+    std::uninitialized_copy(src.elements, src.elements + src.count, elements);
+    count = src.count;
+    updateVersion();
+}
+
+/*
+ * Implementation notes: reallocate
+ * --------------------------------
+ * Elements are moved into the new array if their move constructor cannot
+ * throw, and copied otherwise, so a failed reallocation leaves the vector
+ * unchanged.
+ */
+template <typename ValueType>
+void Vector<ValueType>::reallocate(int newCapacity) {
+    ValueType* array = allocate(newCapacity);
+    int n = count;
+    if (elements) {
+        int i = 0;
+        try {
+            for (; i < n; i++) {
+                new (array + i) ValueType(std::move_if_noexcept(elements[i]));
+            }
+        } catch (...) {
+            for (int j = 0; j < i; j++) {
+                array[j].~ValueType();
+            }
+            ::operator delete(array);
+            throw;
+        }
+        freeElements();
     }
+    elements = array;
+    capacity = newCapacity;
+    count = n;
+}
+
+template <typename ValueType>
+void Vector<ValueType>::updateVersion() {
+#ifndef SPL_UNCHECKED_VECTOR
     m_version++;
+#endif // SPL_UNCHECKED_VECTOR
 }
 
 /*
@@ -5,6 +5,9 @@
  * See that file for documentation of each member.
  *
  * @author Marty Stepp
+ * @version 2026/10/17
+ * - constructor sets the location through setLocation only
+ * - gridToPixelString writes into a presized string instead of a stream
  * @version 2017/10/18
  * - fix compiler warnings
  * @version 2017/09/28
@@ -282,27 +285,26 @@ void GBufferedImage::fromGrid(const Grid<int>& grid) {
 
 std::string GBufferedImage::gridToPixelString(const Grid<int>& grid) {
     // output a base64-encoded version of the image pixels
-    std::ostringstream out;
-
-    // output width as 2 bytes, then height as 2 bytes
+    // (written straight into a presized string; this runs once per fromGrid)
     int w = grid.width();
     int h = grid.height();
-    out << (char) (((w & 0x0000ff00) >> 8) & 0x000000ff);
-    out << (char)  ((w & 0x000000ff));
-    out << (char) (((h & 0x0000ff00) >> 8) & 0x000000ff);
-    out << (char)  ((h & 0x000000ff));
-    
+    std::string out(4 + (size_t) w * h * 3, '\0');
+
+    // output width as 2 bytes, then height as 2 bytes
+    out[0] = (char) (((w & 0x0000ff00) >> 8) & 0x000000ff);
+    out[1] = (char)  ((w & 0x000000ff));
+    out[2] = (char) (((h & 0x0000ff00) >> 8) & 0x000000ff);
+    out[3] = (char)  ((h & 0x000000ff));
+
     // output each pixel as 3 bytes (R,G,B)
-    for (int row = 0; row < h; row++) {
-        for (int col = 0; col < w; col++) {
-            int rgb = grid[row][col];
-            out << (char) (((rgb & 0x00ff0000) >> 16) & 0x000000ff);
-            out << (char) (((rgb & 0x0000ff00) >> 8) & 0x000000ff);
-            out << (char)   (rgb & 0x000000ff);
-        }
+    size_t i = 4;
+    for (int rgb : grid) {
+        out[i++] = (char) (((rgb & 0x00ff0000) >> 16) & 0x000000ff);
+        out[i++] = (char) (((rgb & 0x0000ff00) >> 8) & 0x000000ff);
+        out[i++] = (char)   (rgb & 0x000000ff);
     }
 
-    return out.str();
+    return out;
 }
 
 double GBufferedImage::getHeight() const {
@@ -460,8 +462,8 @@ void GBufferedImage::init(double x, double y, double width, double height,
                           int rgb) {
     checkSize("constructor", width, height);
     checkColor("constructor", rgb);
-    this->x = x;
-    this->y = y;
+    this->x = 0;   // setLocation below moves it, and skips a move to where it already is
+    this->y = 0;
     this->m_width = width;
     this->m_height = height;
     if (width > 0 && height > 0) {
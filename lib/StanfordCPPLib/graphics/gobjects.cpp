@@ -3,6 +3,11 @@
  * ------------------
  * This file implements the gobjects.h interface.
  * 
+ * @version 2026/10/17
+ * - setters no longer send the back end a value the object already has
+ * - fixed setFilled(false) leaving the fill flag set
+ * - added uniform-grid spatial index and O(1) element lookup to GCompound
+ * - GArc::getFrameRectangle now returns the frame instead of an empty rectangle
  * @version 2017/10/25
  * - added members for get/setting center and bottom/right x/y coords/location
  * @version 2017/10/16
@@ -30,6 +35,7 @@
 #include <cmath>
 #include <iostream>
 #include <sstream>
+#include <typeinfo>
 #include "gevents.h"
 #include "gmath.h"
 #include "private/platform.h"
@@ -41,6 +47,13 @@ static const double ARC_TOLERANCE = 2.5;
 static const double DEFAULT_CORNER = 10;
 static const std::string DEFAULT_GLABEL_FONT = "Dialog-13";
 
+// GCompound spatial index parameters
+static const int INDEX_MIN_ELEMENTS = 32;     // build the index at this many elements
+static const double INDEX_CELL_SIZE = 64;     // width and height of a grid cell
+static const int INDEX_MAX_CELLS = 64;        // larger objects are tested linearly
+static const double INDEX_MARGIN = ARC_TOLERANCE + 1;   // slack for contains tolerances
+static const double INDEX_MAX_COORD = 1E9 * INDEX_CELL_SIZE;
+
 /*
  * Returns the square of the distance between two points.
  * Used when checking to see if a line touches a given point.
@@ -58,6 +71,13 @@ GObject::GObject() {
     transformed = false;
     visible = true;
     parent = nullptr;
+    compoundIndex = -1;
+}
+
+void GObject::boundsChanged() {
+    if (parent) {
+        parent->updateElement(this);
+    }
 }
 
 GObject::~GObject() {
@@ -149,6 +169,7 @@ void GObject::rotate(double theta) {
     // Apply local transform
     transformed = true;
     stanfordcpplib::getPlatform()->gobject_rotate(this, theta);
+    boundsChanged();
 }
 
 void GObject::scale(double sf) {
@@ -159,6 +180,7 @@ void GObject::scale(double sx, double sy) {
     // Apply local transform
     transformed = true;
     stanfordcpplib::getPlatform()->gobject_scale(this, sx, sy);
+    boundsChanged();
 }
 
 void GObject::sendBackward() {
@@ -222,8 +244,11 @@ void GObject::setCenterLocation(const GPoint& pt) {
 }
 
 void GObject::setColor(int rgb) {
-    this->color = convertRGBToColor(rgb);
-    stanfordcpplib::getPlatform()->gobject_setColor(this, this->color);
+    std::string newColor = convertRGBToColor(rgb);
+    if (newColor != this->color) {
+        this->color = newColor;
+        stanfordcpplib::getPlatform()->gobject_setColor(this, this->color);
+    }
 }
 
 void GObject::setColor(const std::string& color) {
@@ -231,14 +256,21 @@ void GObject::setColor(const std::string& color) {
 }
 
 void GObject::setLineWidth(double lineWidth) {
+    if (floatingPointEqual(this->lineWidth, lineWidth)) {
+        return;
+    }
     this->lineWidth = lineWidth;
     stanfordcpplib::getPlatform()->gobject_setLineWidth(this, lineWidth);
 }
 
 void GObject::setLocation(double x, double y) {
+    if (floatingPointEqual(this->x, x) && floatingPointEqual(this->y, y)) {
+        return;
+    }
     this->x = x;
     this->y = y;
     stanfordcpplib::getPlatform()->gobject_setLocation(this, x, y);
+    boundsChanged();
 }
 
 void GObject::setLocation(const GPoint& pt) {
@@ -246,8 +278,10 @@ void GObject::setLocation(const GPoint& pt) {
 }
 
 void GObject::setVisible(bool flag) {
-    visible = flag;
-    stanfordcpplib::getPlatform()->gobject_setVisible(this, flag);
+    if (flag != visible) {
+        visible = flag;
+        stanfordcpplib::getPlatform()->gobject_setVisible(this, flag);
+    }
 }
 
 void GObject::setX(double x) {
@@ -323,35 +357,47 @@ void GRect::setBounds(const GRectangle& bounds) {
 }
 
 void GRect::setFillColor(int rgb) {
-    fillColor = convertRGBToColor(rgb);
-    stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    std::string newColor = convertRGBToColor(rgb);
+    if (newColor != fillColor) {
+        fillColor = newColor;
+        stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    }
 }
 
 void GRect::setFillColor(const std::string& color) {
-    fillColor = color;
-    if (fillColor == "") {
+    std::string newColor = color;
+    if (newColor == "") {
         if (isFilled()) {
             setFilled(false);
         }
     } else {
-        fillColor = convertRGBToColor(convertColorToRGB(color));
+        newColor = convertRGBToColor(convertColorToRGB(color));
         if (!isFilled()) {
             setFilled(true);
         }
     }
-    stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    if (newColor != fillColor) {
+        fillColor = newColor;
+        stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    }
 }
 
 void GRect::setFilled(bool flag) {
-    fillFlag = true;
-    stanfordcpplib::getPlatform()->gobject_setFilled(this, flag);
+    if (flag != fillFlag) {
+        fillFlag = flag;
+        stanfordcpplib::getPlatform()->gobject_setFilled(this, flag);
+    }
 }
 
 void GRect::setSize(double width, double height) {
     if (transformed) error("setSize: Object has been transformed");
+    if (floatingPointEqual(this->width, width) && floatingPointEqual(this->height, height)) {
+        return;
+    }
     this->width = width;
     this->height = height;
     stanfordcpplib::getPlatform()->gobject_setSize(this, width, height);
+    boundsChanged();
 }
 
 void GRect::setSize(const GDimension& size) {
@@ -493,6 +539,9 @@ bool G3DRect::isRaised() const {
 }
 
 void G3DRect::setRaised(bool raised) {
+    if (raised == this->raised) {
+        return;
+    }
     this->raised = raised;
     stanfordcpplib::getPlatform()->g3drect_setRaised(this, raised);
 }
@@ -575,35 +624,47 @@ void GOval::setBounds(const GRectangle& bounds) {
 }
 
 void GOval::setFillColor(int color) {
-    fillColor = convertRGBToColor(color);
-    stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    std::string newColor = convertRGBToColor(color);
+    if (newColor != fillColor) {
+        fillColor = newColor;
+        stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    }
 }
 
 void GOval::setFillColor(const std::string& color) {
-    fillColor = color;
-    if (fillColor == "") {
+    std::string newColor = color;
+    if (newColor == "") {
         if (isFilled()) {
             setFilled(false);
         }
     } else {
-        fillColor = convertRGBToColor(convertColorToRGB(color));
+        newColor = convertRGBToColor(convertColorToRGB(color));
         if (!isFilled()) {
             setFilled(true);
         }
     }
-    stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    if (newColor != fillColor) {
+        fillColor = newColor;
+        stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    }
 }
 
 void GOval::setFilled(bool flag) {
-    fillFlag = true;
-    stanfordcpplib::getPlatform()->gobject_setFilled(this, flag);
+    if (flag != fillFlag) {
+        fillFlag = flag;
+        stanfordcpplib::getPlatform()->gobject_setFilled(this, flag);
+    }
 }
 
 void GOval::setSize(double width, double height) {
     if (transformed) error("setSize: Object has been transformed");
+    if (floatingPointEqual(this->width, width) && floatingPointEqual(this->height, height)) {
+        return;
+    }
     this->width = width;
     this->height = height;
     stanfordcpplib::getPlatform()->gobject_setSize(this, width, height);
+    boundsChanged();
 }
 
 void GOval::setSize(const GDimension& size) {
@@ -727,7 +788,7 @@ std::string GArc::getFillColor() const {
 }
 
 GRectangle GArc::getFrameRectangle() const {
-    return GRectangle(0, 0, 0, 0);
+    return GRectangle(x, y, frameWidth, frameHeight);
 }
 
 double GArc::getStartAngle() const {
@@ -751,28 +812,36 @@ bool GArc::isFilled() const {
 }
 
 void GArc::setFillColor(int color) {
-    fillColor = convertRGBToColor(color);
-    stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    std::string newColor = convertRGBToColor(color);
+    if (newColor != fillColor) {
+        fillColor = newColor;
+        stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    }
 }
 
 void GArc::setFillColor(const std::string& color) {
-    fillColor = color;
-    if (fillColor == "") {
+    std::string newColor = color;
+    if (newColor == "") {
         if (isFilled()) {
             setFilled(false);
         }
     } else {
-        fillColor = convertRGBToColor(convertColorToRGB(color));
+        newColor = convertRGBToColor(convertColorToRGB(color));
         if (!isFilled()) {
             setFilled(true);
         }
     }
-    stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    if (newColor != fillColor) {
+        fillColor = newColor;
+        stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    }
 }
 
 void GArc::setFilled(bool flag) {
-    fillFlag = true;
-    stanfordcpplib::getPlatform()->gobject_setFilled(this, flag);
+    if (flag != fillFlag) {
+        fillFlag = flag;
+        stanfordcpplib::getPlatform()->gobject_setFilled(this, flag);
+    }
 }
 
 void GArc::setFrameRectangle(double x, double y, double width, double height) {
@@ -781,6 +850,7 @@ void GArc::setFrameRectangle(double x, double y, double width, double height) {
     frameWidth = width;
     frameHeight = height;
     stanfordcpplib::getPlatform()->garc_setFrameRectangle(this, x, y, width, height);
+    boundsChanged();
 }
 
 void GArc::setFrameRectangle(const GRectangle& rect) {
@@ -789,11 +859,17 @@ void GArc::setFrameRectangle(const GRectangle& rect) {
 }
 
 void GArc::setStartAngle(double start) {
+    if (floatingPointEqual(this->start, start)) {
+        return;
+    }
     this->start = start;
     stanfordcpplib::getPlatform()->garc_setStartAngle(this, start);
 }
 
 void GArc::setSweepAngle(double sweep) {
+    if (floatingPointEqual(this->sweep, sweep)) {
+        return;
+    }
     this->sweep = sweep;
     stanfordcpplib::getPlatform()->garc_setSweepAngle(this, sweep);
 }
@@ -808,14 +884,48 @@ std::string GArc::toString() const {
 
 /* GCompound class */
 
+/*
+ * Implementation notes: GCompound class
+ * -------------------------------------
+ * Each element remembers its position in contents (compoundIndex), so
+ * finding it is O(1).  Removing an element leaves a nullptr hole behind
+ * instead of shifting the rest of the vector; the holes are squeezed out
+ * when they outnumber the elements or when an operation needs the
+ * positions to be consecutive (getElement and the z-order methods).
+ *
+ * Once the compound holds INDEX_MIN_ELEMENTS objects, it also keeps a
+ * uniform grid of INDEX_CELL_SIZE cells listing the objects whose bounds
+ * overlap each cell, so that getElementAt only tests the objects near the
+ * point.  Objects report bounds changes through GObject::boundsChanged.
+ * Only the built-in shapes whose contains method stays within their
+ * bounds (plus INDEX_MARGIN) are put in the grid; everything else goes in
+ * linearElements and is tested on every query.
+ */
+
+static std::uint64_t cellKey(int cellX, int cellY) {
+    return ((std::uint64_t) (unsigned int) cellX << 32) | (unsigned int) cellY;
+}
+
 GCompound::GCompound() {
+    holeCount = 0;
+    indexBuilt = false;
     stanfordcpplib::getPlatform()->gcompound_constructor(this);
 }
 
 void GCompound::add(GObject* gobj) {
     stanfordcpplib::getPlatform()->gcompound_add(this, gobj);
+    if (gobj->parent) {
+        // the back end has already taken it out of its old compound
+        gobj->parent->detach(gobj);
+    }
+    gobj->compoundIndex = contents.size();
     contents.add(gobj);
     gobj->parent = this;
+    if (indexBuilt) {
+        indexElement(gobj);
+    } else if (getElementCount() >= INDEX_MIN_ELEMENTS) {
+        buildIndex();
+    }
 }
 
 void GCompound::add(GObject* gobj, double x, double y) {
@@ -823,24 +933,110 @@ void GCompound::add(GObject* gobj, double x, double y) {
     add(gobj);
 }
 
+void GCompound::buildIndex() {
+    for (GObject* gobj : contents) {
+        if (gobj) {
+            indexElement(gobj);
+        }
+    }
+    indexBuilt = true;
+}
+
+void GCompound::compact() const {
+    if (holeCount == 0) {
+        return;
+    }
+    int n = 0;
+    for (int i = 0, sz = contents.size(); i < sz; i++) {
+        GObject* gobj = contents[i];
+        if (gobj) {
+            gobj->compoundIndex = n;
+            contents[n++] = gobj;
+        }
+    }
+    while (contents.size() > n) {
+        contents.removeBack();
+    }
+    holeCount = 0;
+}
+
 bool GCompound::contains(double x, double y) const {
     if (transformed) {
         return stanfordcpplib::getPlatform()->gobject_contains(this, x, y);
     }
     for (int i = 0, sz = contents.size(); i < sz; i++) {
-        if (contents[i]->contains(x, y)) return true;
+        if (contents[i] && contents[i]->contains(x, y)) return true;
     }
     return false;
 }
 
-int GCompound::findGObject(GObject* gobj) const {
-    int n = contents.size();
-    for (int i = 0; i < n; i++) {
-        if (contents.get(i) == gobj) {
-            return i;
+void GCompound::detach(GObject* gobj) {
+    if (indexBuilt) {
+        unindexElement(gobj);
+    }
+    int index = gobj->compoundIndex;
+    gobj->parent = nullptr;
+    gobj->compoundIndex = -1;
+    if (index == contents.size() - 1) {
+        contents.removeBack();
+        while (!contents.isEmpty() && !contents[contents.size() - 1]) {
+            contents.removeBack();
+            holeCount--;
+        }
+    } else {
+        contents[index] = nullptr;
+        holeCount++;
+        if (holeCount > INDEX_MIN_ELEMENTS && holeCount > contents.size() / 2) {
+            compact();
         }
     }
-    return -1;
+}
+
+GObject* GCompound::findElementAt(double x, double y, bool frontmost) const {
+    if (!indexBuilt) {
+        int n = contents.size();
+        for (int k = 0; k < n; k++) {
+            GObject* gobj = contents[frontmost ? n - 1 - k : k];
+            if (gobj && gobj->contains(x, y)) {
+                return gobj;
+            }
+        }
+        return nullptr;
+    }
+
+    // test the candidates, skipping any that could not beat the best hit so far
+    GObject* result = nullptr;
+    const std::vector<GObject*>* lists[2] = { nullptr, &linearElements };
+    if (std::fabs(x) < INDEX_MAX_COORD && std::fabs(y) < INDEX_MAX_COORD) {
+        auto it = indexCells.find(cellKey((int) std::floor(x / INDEX_CELL_SIZE),
+                                          (int) std::floor(y / INDEX_CELL_SIZE)));
+        if (it != indexCells.end()) {
+            lists[0] = &it->second;
+        }
+    }
+    for (const std::vector<GObject*>* list : lists) {
+        if (!list) {
+            continue;
+        }
+        for (GObject* gobj : *list) {
+            if (result && (frontmost ? gobj->compoundIndex < result->compoundIndex
+                                     : gobj->compoundIndex > result->compoundIndex)) {
+                continue;
+            }
+            if (gobj->contains(x, y)) {
+                result = gobj;
+            }
+        }
+    }
+    return result;
+}
+
+int GCompound::findGObject(GObject* gobj) const {
+    if (!gobj || gobj->parent != this) {
+        return -1;
+    }
+    compact();
+    return gobj->compoundIndex;
 }
 
 GRectangle GCompound::getBounds() const {
@@ -852,6 +1048,9 @@ GRectangle GCompound::getBounds() const {
     double xMax = -1E20;
     double yMax = -1E20;
     for (int i = 0; i < contents.size(); i++) {
+        if (!contents[i]) {
+            continue;
+        }
         GRectangle bounds = contents.get(i)->getBounds();
         xMin = std::min(xMin, bounds.getX());
         yMin = std::min(yMin, bounds.getY());
@@ -863,42 +1062,105 @@ GRectangle GCompound::getBounds() const {
 }
 
 GObject* GCompound::getElement(int index) const {
+    compact();
     return contents.get(index);
 }
 
 GObject* GCompound::getElementAt(double x, double y) const {
-    for (GObject* gobj : contents) {
-        if (gobj && gobj->contains(x, y)) {
-            return gobj;
-        }
-    }
-    return nullptr;
+    return findElementAt(x, y, /* frontmost */ false);
 }
 
 int GCompound::getElementCount() const {
-    return contents.size();
+    return contents.size() - holeCount;
+}
+
+/*
+ * Computes the range of grid cells that the given object must be listed in,
+ * or returns false if the object has to be tested on every query instead.
+ */
+bool GCompound::getIndexEntry(const GObject* gobj, IndexEntry& entry) {
+    if (gobj->transformed) {
+        return false;
+    }
+    GRectangle bounds;
+    const std::type_info& type = typeid(*gobj);
+    if (type == typeid(GArc)) {
+        // an unfilled arc's tolerance can reach outside its getBounds
+        bounds = static_cast<const GArc*>(gobj)->getFrameRectangle();
+    } else if (type == typeid(GRect) || type == typeid(GRoundRect)
+               || type == typeid(G3DRect) || type == typeid(GOval)
+               || type == typeid(GImage) || type == typeid(GLabel)
+               || type == typeid(GLine)) {
+        bounds = gobj->getBounds();
+    } else {
+        return false;
+    }
+    double x0 = std::min(bounds.getX(), bounds.getX() + bounds.getWidth()) - INDEX_MARGIN;
+    double y0 = std::min(bounds.getY(), bounds.getY() + bounds.getHeight()) - INDEX_MARGIN;
+    double x1 = std::max(bounds.getX(), bounds.getX() + bounds.getWidth()) + INDEX_MARGIN;
+    double y1 = std::max(bounds.getY(), bounds.getY() + bounds.getHeight()) + INDEX_MARGIN;
+    if (!(std::fabs(x0) < INDEX_MAX_COORD && std::fabs(y0) < INDEX_MAX_COORD
+          && std::fabs(x1) < INDEX_MAX_COORD && std::fabs(y1) < INDEX_MAX_COORD)) {
+        return false;   // huge or NaN coordinates
+    }
+    entry.cellX0 = (int) std::floor(x0 / INDEX_CELL_SIZE);
+    entry.cellY0 = (int) std::floor(y0 / INDEX_CELL_SIZE);
+    entry.cellX1 = (int) std::floor(x1 / INDEX_CELL_SIZE);
+    entry.cellY1 = (int) std::floor(y1 / INDEX_CELL_SIZE);
+    entry.linearSlot = -1;
+    return (entry.cellX1 - entry.cellX0 + 1) * (entry.cellY1 - entry.cellY0 + 1)
+            <= INDEX_MAX_CELLS;
 }
 
 std::string GCompound::getType() const {
     return "GCompound";
 }
 
-void GCompound::remove(GObject* gobj) {
-    int index = findGObject(gobj);
-    if (index != -1) removeAt(index);
+void GCompound::indexElement(GObject* gobj) {
+    IndexEntry entry;
+    if (getIndexEntry(gobj, entry)) {
+        for (int cellY = entry.cellY0; cellY <= entry.cellY1; cellY++) {
+            for (int cellX = entry.cellX0; cellX <= entry.cellX1; cellX++) {
+                indexCells[cellKey(cellX, cellY)].push_back(gobj);
+            }
+        }
+    } else {
+        entry.linearSlot = (int) linearElements.size();
+        linearElements.push_back(gobj);
+    }
+    indexEntries[gobj] = entry;
 }
 
-void GCompound::removeAll() {
-    while (!contents.isEmpty()) {
-        removeAt(0);
+void GCompound::moveElement(int from, int to) {
+    GObject* gobj = contents[from];
+    contents.remove(from);
+    contents.insert(to, gobj);
+    for (int i = std::min(from, to), last = std::max(from, to); i <= last; i++) {
+        contents[i]->compoundIndex = i;
     }
 }
 
-void GCompound::removeAt(int index) {
-    GObject* gobj = contents[index];
-    contents.remove(index);
-    stanfordcpplib::getPlatform()->gobject_remove(gobj);
-    gobj->parent = nullptr;
+void GCompound::remove(GObject* gobj) {
+    if (gobj && gobj->parent == this) {
+        detach(gobj);
+        stanfordcpplib::getPlatform()->gobject_remove(gobj);
+    }
+}
+
+void GCompound::removeAll() {
+    for (GObject* gobj : contents) {
+        if (gobj) {
+            stanfordcpplib::getPlatform()->gobject_remove(gobj);
+            gobj->parent = nullptr;
+            gobj->compoundIndex = -1;
+        }
+    }
+    contents.clear();
+    holeCount = 0;
+    indexBuilt = false;
+    indexCells.clear();
+    indexEntries.clear();
+    linearElements.clear();
 }
 
 void GCompound::sendBackward(GObject* gobj) {
@@ -907,8 +1169,7 @@ void GCompound::sendBackward(GObject* gobj) {
         return;
     }
     if (index != 0) {
-        contents.remove(index);
-        contents.insert(index - 1, gobj);
+        moveElement(index, index - 1);
         stanfordcpplib::getPlatform()->gobject_sendBackward(gobj);
     }
 }
@@ -919,8 +1180,7 @@ void GCompound::sendForward(GObject* gobj) {
         return;
     }
     if (index != contents.size() - 1) {
-        contents.remove(index);
-        contents.insert(index + 1, gobj);
+        moveElement(index, index + 1);
         stanfordcpplib::getPlatform()->gobject_sendForward(gobj);
     }
 }
@@ -931,8 +1191,7 @@ void GCompound::sendToBack(GObject* gobj) {
         return;
     }
     if (index != 0) {
-        contents.remove(index);
-        contents.insert(0, gobj);
+        moveElement(index, 0);
         stanfordcpplib::getPlatform()->gobject_sendToBack(gobj);
     }
 }
@@ -943,8 +1202,7 @@ void GCompound::sendToFront(GObject* gobj) {
         return;
     }
     if (index != contents.size() - 1) {
-        contents.remove(index);
-        contents.add(gobj);
+        moveElement(index, contents.size() - 1);
         stanfordcpplib::getPlatform()->gobject_sendToFront(gobj);
     }
 }
@@ -953,6 +1211,56 @@ std::string GCompound::toString() const {
     return "GCompound(...)";
 }
 
+void GCompound::unindexElement(GObject* gobj) {
+    auto it = indexEntries.find(gobj);
+    if (it == indexEntries.end()) {
+        return;
+    }
+    IndexEntry entry = it->second;
+    indexEntries.erase(it);
+    if (entry.linearSlot >= 0) {
+        GObject* last = linearElements.back();
+        linearElements[entry.linearSlot] = last;
+        linearElements.pop_back();
+        if (last != gobj) {
+            indexEntries[last].linearSlot = entry.linearSlot;
+        }
+        return;
+    }
+    for (int cellY = entry.cellY0; cellY <= entry.cellY1; cellY++) {
+        for (int cellX = entry.cellX0; cellX <= entry.cellX1; cellX++) {
+            auto cell = indexCells.find(cellKey(cellX, cellY));
+            std::vector<GObject*>& list = cell->second;
+            for (int i = 0, sz = (int) list.size(); i < sz; i++) {
+                if (list[i] == gobj) {
+                    list[i] = list.back();
+                    list.pop_back();
+                    break;
+                }
+            }
+            if (list.empty()) {
+                indexCells.erase(cell);
+            }
+        }
+    }
+}
+
+void GCompound::updateElement(GObject* gobj) {
+    if (!indexBuilt) {
+        return;
+    }
+    auto it = indexEntries.find(gobj);
+    IndexEntry entry;
+    if (it != indexEntries.end() && it->second.linearSlot < 0
+            && getIndexEntry(gobj, entry)
+            && entry.cellX0 == it->second.cellX0 && entry.cellY0 == it->second.cellY0
+            && entry.cellX1 == it->second.cellX1 && entry.cellY1 == it->second.cellY1) {
+        return;   // still in the same cells
+    }
+    unindexElement(gobj);
+    indexElement(gobj);
+}
+
 
 /* GImage class */
 
@@ -1045,6 +1353,9 @@ std::string GLabel::getType() const {
 }
 
 void GLabel::setFont(const std::string& font) {
+    if (font == this->font) {
+        return;
+    }
     this->font = font;
     stanfordcpplib::getPlatform()->glabel_setFont(this, font);
     GDimension size = stanfordcpplib::getPlatform()->glabel_getSize(this);
@@ -1052,14 +1363,19 @@ void GLabel::setFont(const std::string& font) {
     height = size.getHeight();
     ascent = stanfordcpplib::getPlatform()->glabel_getFontAscent(this);
     descent = stanfordcpplib::getPlatform()->glabel_getFontDescent(this);
+    boundsChanged();
 }
 
 void GLabel::setLabel(const std::string& str) {
+    if (str == this->str) {
+        return;
+    }
     this->str = str;
     stanfordcpplib::getPlatform()->glabel_setLabel(this, str);
     GDimension size = stanfordcpplib::getPlatform()->glabel_getSize(this);
     width = size.getWidth();
     height = size.getHeight();
+    boundsChanged();
 }
 
 void GLabel::setText(const std::string& str) {
@@ -1153,6 +1469,7 @@ void GLine::setEndPoint(double x, double y) {
     dx = x - this->x;
     dy = y - this->y;
     stanfordcpplib::getPlatform()->gline_setEndPoint(this, x, y);
+    boundsChanged();
 }
 
 void GLine::setStartPoint(double x, double y) {
@@ -1161,6 +1478,7 @@ void GLine::setStartPoint(double x, double y) {
     this->x = x;
     this->y = y;
     stanfordcpplib::getPlatform()->gline_setStartPoint(this, x, y);
+    boundsChanged();
 }
 
 std::string GLine::toString() const {
@@ -1321,28 +1639,36 @@ bool GPolygon::isFilled() const {
 }
 
 void GPolygon::setFillColor(int rgb) {
-    fillColor = convertRGBToColor(rgb);
-    stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    std::string newColor = convertRGBToColor(rgb);
+    if (newColor != fillColor) {
+        fillColor = newColor;
+        stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    }
 }
 
 void GPolygon::setFillColor(const std::string& color) {
-    fillColor = color;
-    if (fillColor == "") {
+    std::string newColor = color;
+    if (newColor == "") {
         if (isFilled()) {
             setFilled(false);
         }
     } else {
-        fillColor = convertRGBToColor(convertColorToRGB(color));
+        newColor = convertRGBToColor(convertColorToRGB(color));
         if (!isFilled()) {
             setFilled(true);
         }
     }
-    stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    if (newColor != fillColor) {
+        fillColor = newColor;
+        stanfordcpplib::getPlatform()->gobject_setFillColor(this, fillColor);
+    }
 }
 
 void GPolygon::setFilled(bool flag) {
-    fillFlag = true;
-    stanfordcpplib::getPlatform()->gobject_setFilled(this, flag);
+    if (flag != fillFlag) {
+        fillFlag = flag;
+        stanfordcpplib::getPlatform()->gobject_setFilled(this, flag);
+    }
 }
 
 std::string GPolygon::toString() const {
@@ -5,6 +5,9 @@
  * the model developed for the ACM Java Graphics.
  * <include src="pictures/ClassHierarchies/GObjectHierarchy-h.html">
  *
+ * @version 2026/10/17
+ * - added spatial index to GCompound for getElementAt and O(1) removal
+ * - GCompound::add now takes the object out of its previous compound
  * @version 2017/10/25
  * - added GPolygon initializer_list support
  * - added members for get/setting center and bottom/right x/y coords/location
@@ -24,7 +27,10 @@
 #ifndef _gobjects_h
 #define _gobjects_h
 
+#include <cstdint>
 #include <initializer_list>
+#include <unordered_map>
+#include <vector>
 #include "gtypes.h"
 #include "gwindow.h"
 #include "vector.h"
@@ -420,10 +426,17 @@ protected:
     bool visible;                   /* Indicates if object is visible     */
     bool transformed;               /* Indicates if object is transformed */
     GCompound* parent;              /* Pointer to the parent              */
+    int compoundIndex;              /* Position in the parent's contents  */
 
 protected:
     GObject();
 
+    /*
+     * Tells the parent compound (if any) that this object's bounds have
+     * changed, so that it can keep its spatial index up to date.
+     */
+    void boundsChanged();
+
     friend class G3DRect;
     friend class GArc;
     friend class GButton;
@@ -992,6 +1005,7 @@ public:
      * -----------------------------
      * Adds a new graphical object to the <code>GCompound</code>.  The second
      * form moves the object to the point (<code>x</code>, <code>y</code>) first.
+     * An object that is already in a compound is removed from it first.
      */
     void add(GObject* gobj);
     void add(GObject* gobj, double x, double y);
@@ -1046,18 +1060,51 @@ public:
     virtual std::string toString() const;
 
 private:
+    /*
+     * The cells of the spatial index that an object is listed in, or the
+     * object's slot in linearElements if it cannot be indexed by cell.
+     */
+    struct IndexEntry {
+        int cellX0;
+        int cellY0;
+        int cellX1;
+        int cellY1;
+        int linearSlot;
+    };
+
     void sendBackward(GObject* gobj);
     void sendForward(GObject* gobj);
     void sendToBack(GObject* gobj);
     void sendToFront(GObject* gobj);
+    void buildIndex();
+    void compact() const;
+    void detach(GObject* gobj);
+    GObject* findElementAt(double x, double y, bool frontmost) const;
     int findGObject(GObject* gobj) const;
-    void removeAt(int index);
+    static bool getIndexEntry(const GObject* gobj, IndexEntry& entry);
+    void indexElement(GObject* gobj);
+    void moveElement(int from, int to);
+    void unindexElement(GObject* gobj);
+    void updateElement(GObject* gobj);
 
     /* Instance variables */
-    Vector<GObject*> contents;
+    mutable Vector<GObject*> contents;  /* back to front; removed objects leave nullptr holes */
+    mutable int holeCount;              /* number of holes in contents */
+
+    /*
+     * Uniform grid over the compound's coordinate space, built once the
+     * compound holds enough objects.  Each cell lists the objects whose
+     * bounds overlap it; transformed, nested and very large objects are
+     * kept in linearElements and are always tested.
+     */
+    bool indexBuilt;
+    std::unordered_map<std::uint64_t, std::vector<GObject*> > indexCells;
+    std::unordered_map<const GObject*, IndexEntry> indexEntries;
+    std::vector<GObject*> linearElements;
 
     /* Friend declarations */
     friend class GObject;
+    friend class GWindow;
 };
 
 /*
@@ -6,6 +6,8 @@
  * This file exports the GTextArea class.
  *
  * @author Jeff Lutgen
+ * @version 2026/10/17
+ * - constructor sets the location through setLocation only
  * @version 2016/10/12
  * - taken from https://github.com/jlutgen/stanford-whittier-cpplib/
  * - Thanks, Jeff!
@@ -44,8 +46,8 @@ GTextArea::GTextArea(double width, double height) {
 }
 
 GTextArea::GTextArea(double x, double y, double width, double height) {
-    this->x = x;
-    this->y = y;
+    this->x = 0;
+    this->y = 0;
     this->width = width;
     this->height = height;
     stanfordcpplib::getPlatform()->gtextarea_create(this, width, height);
@@ -3,12 +3,16 @@
  * --------------
  * This file defines the <code>GTimer</code> class, which implements a
  * general interval timer.
+ *
+ * @version 2026/10/17
+ * - timers run in a native timer wheel instead of in the Java back-end
  */
 
 #ifndef _gtimer_h
 #define _gtimer_h
 
 #include <string>
+#include "private/timerwheel.h"
 
 namespace stanfordcpplib {
 class Platform;
@@ -19,10 +23,13 @@ class Platform;
  * -----------------------
  * This type maintains a reference count to determine when it is
  * possible to free the timer.  The address of this block is used
- * as the timer id.
+ * as the timer id.  A running timer is an entry in the platform's
+ * timer wheel, which holds one reference to it until it is stopped.
  */
-struct GTimerData {
+struct GTimerData : public stanfordcpplib::TimerEntry {
     int refCount;
+    double delay;      // milliseconds between events
+    double deadline;   // when the next event is due, on the timer clock
 };
 
 /*
@@ -5,6 +5,9 @@
  * to the appropriate methods in the Platform class, which is implemented
  * separately for each architecture.
  * 
+ * @version 2026/10/17
+ * - getGObjectAt uses the top compound's spatial index
+ * - repaint skips the back end when nothing has changed
  * @version 2017/12/18
  * - added drawImage
  * @version 2017/10/25
@@ -224,6 +227,7 @@ void GWindow::initGWindow(double width, double height, bool visible) {
     gwd->exitOnClose = false;
     gwd->repaintImmediately = true;
     gwd->autograderWindow = false;
+    gwd->repaintCommandCount = 0;
     stanfordcpplib::getPlatform()->gwindow_constructor(*this, width, height, gwd->top, visible);
     autograder::gwindowPrevDataAdd(gwd);
     setColor("BLACK");
@@ -635,13 +639,7 @@ GObject* GWindow::getGObject(int index) const {
 
 GObject* GWindow::getGObjectAt(double x, double y) const {
     if (gwd && gwd->top) {
-        int n = gwd->top->getElementCount();
-        for (int i = n - 1; i >= 0; i--) {
-            GObject* gobj = gwd->top->getElement(i);
-            if (gobj->contains(x, y)) {
-                return gobj;
-            }
-        }
+        return gwd->top->findElementAt(x, y, /* frontmost */ true);
     }
     return nullptr;
 }
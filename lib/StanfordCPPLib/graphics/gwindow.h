@@ -4,6 +4,8 @@
  * This file defines the <code>GWindow</code> class which supports
  * drawing graphical objects on the screen.
  * 
+ * @version 2026/10/17
+ * - repaint does nothing if nothing has changed since the last repaint
  * @version 2017/12/18
  * - added drawImage
  * @version 2017/10/25
@@ -42,6 +44,7 @@
 #ifndef _gwindow_h
 #define _gwindow_h
 
+#include <cstdint>
 #include <initializer_list>
 #include <string>
 #include "grid.h"
@@ -88,6 +91,7 @@ struct GWindowData {
     bool repaintImmediately;
     bool autograderWindow;
     GCompound* top;
+    std::uint64_t repaintCommandCount;   // back-end commands sent before the last repaint
 };
 
 /*
@@ -653,7 +657,8 @@ public:
      * Method: repaint
      * Usage: gw.repaint();
      * --------------------
-     * Schedule a repaint on this window.
+     * Schedule a repaint on this window.  Nothing is sent to the back end
+     * if no graphics command has been sent since the last repaint.
      */
     void repaint();
 
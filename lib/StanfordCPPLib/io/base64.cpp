@@ -5,7 +5,16 @@
  * in the base64 format, as declared in base64.h.  See:
  * http://en.wikipedia.org/wiki/Base64
  *
+ * On x86 processors with SSSE3 or AVX2, the bulk of the data is encoded and
+ * decoded 12/16 or 24/32 bytes at a time using the vectorized approach of
+ * Wojciech Mula and Daniel Lemire; the processor is checked once at runtime,
+ * and the output is identical to that of the scalar code on every machine.
+ * Define SPL_BASE64_NO_SIMD to build with the scalar code only.
+ *
  * @author Marty Stepp, based upon open-source Apache Base64 en/decoder
+ * @version 2026/10/17
+ * - added SSSE3/AVX2 encode and decode paths with runtime CPU dispatch
+ * - encode/decode build their std::string results directly
  * @version 2017/10/18
  * - fixed compiler warnings
  * @version 2014/10/08
@@ -16,8 +25,14 @@
  */
 
 #include "base64.h"
+#include <cstdlib>
 #include <cstring>
-#include <sstream>
+
+#if !defined(SPL_BASE64_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) \
+        && (defined(__x86_64__) || defined(__i386__))
+#define SPL_BASE64_X86
+#include <immintrin.h>
+#endif
 
 /* aaaack but it's fast and const should make it shared text page. */
 static const unsigned char pr2six[256] = {
@@ -40,15 +55,244 @@ static const unsigned char pr2six[256] = {
     64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64
 };
 
+#ifdef SPL_BASE64_X86
+/*
+ * Vectorized helpers.  Each one handles as many whole blocks as it safely
+ * can and leaves the rest to the scalar code, advancing the pointers and
+ * counts it is given.  They are compiled for their instruction set with
+ * target attributes, so the rest of the library needs no special flags,
+ * and are only called after simdLevel() has checked the processor.
+ *
+ * Encoding: 12 input bytes are shuffled so that each 32-bit lane holds one
+ * 3-byte group, the four 6-bit indices are pulled out with two multiplies,
+ * and the indices become ASCII by adding an offset looked up by range.
+ *
+ * Decoding: each character's nibbles index two small tables whose AND is
+ * nonzero exactly for characters outside the base64 alphabet (this is used
+ * to find where the encoded data ends), and a third table gives the offset
+ * that turns the character into its 6-bit value; multiply-adds then pack
+ * four 6-bit values into each 3-byte group.
+ */
+enum SimdLevel { SIMD_NONE, SIMD_SSSE3, SIMD_AVX2 };
+
+static SimdLevel detectSimdLevel() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SIMD_AVX2;
+    } else if (__builtin_cpu_supports("ssse3")) {
+        return SIMD_SSSE3;
+    } else {
+        return SIMD_NONE;
+    }
+}
+
+static SimdLevel simdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i encodeIndicesSSSE3(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i encodeCharsSSSE3(__m128i indices) {
+    const __m128i offsets = _mm_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(less, _mm_set1_epi8(13)));
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+}
+
+__attribute__((target("ssse3")))
+static int encodeBlocksSSSE3(char* encoded, const char* string, int len) {
+    int i = 0;
+    while (i + 16 <= len) {   // reads 16 bytes to use 12
+        __m128i in = _mm_loadu_si128((const __m128i*) (string + i));
+        __m128i out = encodeCharsSSSE3(encodeIndicesSSSE3(in));
+        _mm_storeu_si128((__m128i*) encoded, out);
+        encoded += 16;
+        i += 12;
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static int encodeBlocksAVX2(char* encoded, const char* string, int len) {
+    const __m256i shuffle = _mm256_set_epi8(
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m256i offsets = _mm256_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    int i = 0;
+    while (i + 28 <= len) {   // two 16-byte reads, 12 bytes apart
+        __m128i lo = _mm_loadu_si128((const __m128i*) (string + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*) (string + i + 12));
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        in = _mm256_shuffle_epi8(in, shuffle);
+        const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t1, t3);
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        range = _mm256_or_si256(range, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+        __m256i out = _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range));
+        _mm256_storeu_si256((__m256i*) encoded, out);
+        encoded += 32;
+        i += 24;
+    }
+    i += encodeBlocksSSSE3(encoded, string + i, len - i);
+    return i;
+}
+
+/*
+ * Returns the number of characters at the start of the n-character string
+ * that the vectorized check confirms are base64 characters; this stops at
+ * the first invalid character, or where fewer than a block remain.
+ */
+__attribute__((target("ssse3")))
+static int validPrefixSSSE3(const unsigned char* coded, int n) {
+    const __m128i lutLo = _mm_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi = _mm_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    int i = 0;
+    while (i + 16 <= n) {
+        __m128i in = _mm_loadu_si128((const __m128i*) (coded + i));
+        __m128i hi = _mm_shuffle_epi8(lutHi, _mm_and_si128(_mm_srli_epi32(in, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(lutLo, _mm_and_si128(in, mask));
+        int invalid = _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128()));
+        if (invalid != 0) {
+            return i + __builtin_ctz(invalid);
+        }
+        i += 16;
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static int validPrefixAVX2(const unsigned char* coded, int n) {
+    const __m256i lutLo = _mm256_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    int i = 0;
+    while (i + 32 <= n) {
+        __m256i in = _mm256_loadu_si256((const __m256i*) (coded + i));
+        __m256i hi = _mm256_shuffle_epi8(lutHi, _mm256_and_si256(_mm256_srli_epi32(in, 4), mask));
+        __m256i lo = _mm256_shuffle_epi8(lutLo, _mm256_and_si256(in, mask));
+        int invalid = _mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256()));
+        if (invalid != 0) {
+            return i + __builtin_ctz((unsigned int) invalid);
+        }
+        i += 32;
+    }
+    return i + validPrefixSSSE3(coded + i, n - i);
+}
+
+/*
+ * Decodes blocks of characters already known to be valid.  Each block
+ * stores a few bytes past its decoded output, so we stop while enough
+ * input remains that the scalar code will overwrite those bytes later.
+ */
+__attribute__((target("ssse3")))
+static void decodeBlocksSSSE3(const unsigned char*& bufin, unsigned char*& bufout, int& nprbytes) {
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    const __m128i slash = _mm_set1_epi8('/');
+    while (nprbytes >= 16 + 8) {
+        __m128i in = _mm_loadu_si128((const __m128i*) bufin);
+        __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask);
+        __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(in, slash), hiNibbles));
+        in = _mm_add_epi8(in, roll);
+        in = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+        in = _mm_madd_epi16(in, _mm_set1_epi32(0x00011000));
+        in = _mm_shuffle_epi8(in, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128((__m128i*) bufout, in);
+        bufin += 16;
+        bufout += 12;
+        nprbytes -= 16;
+    }
+}
+
+__attribute__((target("avx2")))
+static void decodeBlocksAVX2(const unsigned char*& bufin, unsigned char*& bufout, int& nprbytes) {
+    const __m256i lutRoll = _mm256_setr_epi8(
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    const __m256i slash = _mm256_set1_epi8('/');
+    while (nprbytes >= 32 + 16) {
+        __m256i in = _mm256_loadu_si256((const __m256i*) bufin);
+        __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask);
+        __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(in, slash), hiNibbles));
+        in = _mm256_add_epi8(in, roll);
+        in = _mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140));
+        in = _mm256_madd_epi16(in, _mm256_set1_epi32(0x00011000));
+        in = _mm256_shuffle_epi8(in, pack);
+        in = _mm256_permutevar8x32_epi32(in, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256((__m256i*) bufout, in);
+        bufin += 32;
+        bufout += 24;
+        nprbytes -= 32;
+    }
+    decodeBlocksSSSE3(bufin, bufout, nprbytes);
+}
+#endif // SPL_BASE64_X86
+
+/*
+ * Returns the number of base64 characters at the start of the given string,
+ * i.e. the index of its first character that is not in the base64 alphabet
+ * (the '=' padding, the null terminator, or anything else).
+ */
+static int countCodedChars(const char* bufcoded) {
+    const unsigned char* bufin = (const unsigned char *) bufcoded;
+    int nprbytes = 0;
+#ifdef SPL_BASE64_X86
+    SimdLevel level = simdLevel();
+    if (level != SIMD_NONE) {
+        // the terminator is not a base64 character, so never look past it
+        int n = (int) strlen(bufcoded);
+        nprbytes = level == SIMD_AVX2 ? validPrefixAVX2(bufin, n) : validPrefixSSSE3(bufin, n);
+    }
+#endif // SPL_BASE64_X86
+    while (pr2six[bufin[nprbytes]] <= 63) {
+        nprbytes++;
+    }
+    return nprbytes;
+}
+
 int Base64decode_len(const char *bufcoded) {
     int nbytesdecoded;
-    const unsigned char *bufin;
     int nprbytes;
 
-    bufin = (const unsigned char *) bufcoded;
-    while (pr2six[*(bufin++)] <= 63);
-
-    nprbytes = (bufin - (const unsigned char *) bufcoded) - 1;
+    nprbytes = countCodedChars(bufcoded);
     nbytesdecoded = ((nprbytes + 3) / 4) * 3;
 
     return nbytesdecoded + 1;
@@ -60,14 +304,20 @@ int Base64decode(char *bufplain, const char *bufcoded) {
     unsigned char *bufout;
     int nprbytes;
 
-    bufin = (const unsigned char *) bufcoded;
-    while (pr2six[*(bufin++)] <= 63);
-    nprbytes = (bufin - (const unsigned char *) bufcoded) - 1;
+    nprbytes = countCodedChars(bufcoded);
     nbytesdecoded = ((nprbytes + 3) / 4) * 3;
 
     bufout = (unsigned char *) bufplain;
     bufin = (const unsigned char *) bufcoded;
 
+#ifdef SPL_BASE64_X86
+    if (simdLevel() == SIMD_AVX2) {
+        decodeBlocksAVX2(bufin, bufout, nprbytes);
+    } else if (simdLevel() == SIMD_SSSE3) {
+        decodeBlocksSSSE3(bufin, bufout, nprbytes);
+    }
+#endif // SPL_BASE64_X86
+
     while (nprbytes > 4) {
         *(bufout++) =
                 (unsigned char) (pr2six[*bufin] << 2 | pr2six[bufin[1]] >> 4);
@@ -110,7 +360,16 @@ int Base64encode(char *encoded, const char *string, int len) {
     char *p;
 
     p = encoded;
-    for (i = 0; i < len - 2; i += 3) {
+    i = 0;
+#ifdef SPL_BASE64_X86
+    if (simdLevel() == SIMD_AVX2) {
+        i = encodeBlocksAVX2(p, string, len);
+    } else if (simdLevel() == SIMD_SSSE3) {
+        i = encodeBlocksSSSE3(p, string, len);
+    }
+    p += i / 3 * 4;
+#endif // SPL_BASE64_X86
+    for (; i < len - 2; i += 3) {
         *p++ = basis_64[(string[i] >> 2) & 0x3F];
         *p++ = basis_64[((string[i] & 0x3) << 4) | ((string[i + 1] & 0xF0) >> 4)];
         *p++ = basis_64[((string[i + 1] & 0xF) << 2) | ((string[i + 2] & 0xC0) >> 6)];
@@ -135,39 +394,23 @@ int Base64encode(char *encoded, const char *string, int len) {
 
 namespace Base64 {
 std::string encode(const std::string& s) {
-    // make C char* buffer to store the encoded output (for compatibility)
+    // encode straight into the C++ string's own buffer; its last char
+    // receives the C null terminator, which we then chop off
     int len = Base64encode_len(s.length());
-    char* buf = (char*) malloc(len);
-    memset(buf, 0, len);
-    Base64encode(buf, s.c_str(), s.length());
-    
-    // convert back into a C++ string, and return it
-    // (unlike below in decode(), I can just directly construct the C++
-    // string from the C one, because the Base64-encoded C string will
-    // not contain any intermediate null bytes by definition)
-    std::string result(buf);
-    free(buf);
+    std::string result(len, '\0');
+    Base64encode(&result[0], s.c_str(), s.length());
+    result.resize(len - 1);
     return result;
 }
 
 std::string decode(const std::string& s) {
-    // convert into C string and decode into that char* buffer
+    // decode into a zeroed buffer of the length Base64decode_len gives;
+    // the result is that whole buffer, including the null terminator and
+    // any padding after it, exactly as it always has been
     const char* cstr = s.c_str();
     int len = Base64decode_len(cstr);
-    char* buf = (char*) malloc(len);
-    memset(buf, 0, len);
-    Base64decode(buf, cstr);
-    
-    // read bytes from that buffer into a C++ string
-    // (cannot just construct/assign C++ string from C char* buffer,
-    // because that will terminate the string at the first null \0 byte)
-    std::ostringstream out;
-    for (int i = 0; i < len; i++) {
-        out << buf[i];
-    }
-    std::string result = out.str();
-    
-    free(buf);
+    std::string result(len, '\0');
+    Base64decode(&result[0], cstr);
     return result;
 }
 }
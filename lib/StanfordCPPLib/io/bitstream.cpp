@@ -7,6 +7,8 @@
  * how a client properly uses these classes.
  *
  * @author Keith Schwarz, Eric Roberts, Marty Stepp
+ * @version 2026/10/17
+ * - read/write bits through a buffered BitStreambuf; added readBits, writeBits
  * @version 2016/11/12
  * - made toPrintable non-static and visible
  * @version 2014/10/08
@@ -22,15 +24,7 @@
 #include "error.h"
 #include "strlib.h"
 
-static const int NUM_BITS_IN_BYTE = 8;
-
-inline int GetNthBit(int n, int fromByte) {
-    return ((fromByte & (1 << n)) != 0);
-}
-
-inline void SetNthBit(int n, int & inByte) {
-    inByte |= (1 << n);
-}
+static const int MAX_BITS_PER_CALL = 64;
 
 std::string toPrintable(int ch) {
     if (ch == '\n') {
@@ -60,23 +54,41 @@ std::string toPrintable(int ch) {
 
 /* Constructor ibitstream::ibitstream
  * ----------------------------------
- * Each ibitstream tracks 3 integers as private data.
- * "lastTell" is streampos of the last byte that was read (this is used
- * to detect when other non-readBit activity has changed the tell)
- * "curByte" contains contents of byte currently being read
- * "pos" is the bit position within curByte that is next to read
- * We set initial state for lastTell and curByte to 0, then pos is
- * set at 8 so that next readBit will trigger a fresh read.
+ * Each ibitstream reads through a BitStreambuf, which holds a large block
+ * of the underlying data along with the bits of the byte currently being
+ * read.  Subclasses attach their file or string buffer to it; the buffer
+ * itself notices when other (non-bit) reads have moved past that byte.
  */
-ibitstream::ibitstream() : std::istream(nullptr), lastTell(0), curByte(0), pos(NUM_BITS_IN_BYTE) {
+ibitstream::ibitstream() : std::istream(nullptr), bitbuf(std::ios::in) {
     this->fake = false;
 }
 
+/* Member function ibitstream::attach
+ * ----------------------------------
+ * Reads through our bit buffer from the given source.
+ */
+void ibitstream::attach(std::streambuf* source) {
+    bitbuf.setSource(source);
+    init(&bitbuf);
+}
+
+/* Member function ibitstream::bitBuffer
+ * -------------------------------------
+ * If a client has pointed the stream at some other buffer with rdbuf,
+ * wraps that buffer so bits can still be read from it.
+ */
+stanfordcpplib::BitStreambuf& ibitstream::bitBuffer() {
+    if (rdbuf() != &bitbuf) {
+        bitbuf.setSource(rdbuf());
+        rdbuf(&bitbuf);
+    }
+    return bitbuf;
+}
+
 /* Member function ibitstream::readBit
  * -----------------------------------
- * If bits remain in curByte, retrieve next and increment pos
- * Else if end of curByte (or some other read happened), then read next byte
- * and start reading from bit position 0 of that byte.
+ * Takes the next bit from the buffer, which reads a fresh byte when the
+ * current one is used up (or some other read happened).
  * If read byte from file at EOF, return EOF.
  */
 int ibitstream::readBit() {
@@ -92,19 +104,45 @@ int ibitstream::readBit() {
             return 1;
         }
     } else {
-        // if just finished bits from curByte or if data read from stream after last readBit()
-        if (lastTell != tellg() || pos == NUM_BITS_IN_BYTE) {
-            if ((curByte = get()) == EOF) {
-                // read next single byte from file
-                return EOF;
+        uint64_t bit;
+        if (!bitBuffer().readBits(1, bit)) {
+            setstate(std::ios::eofbit | std::ios::failbit);
+            return EOF;
+        }
+        return (int) bit;
+    }
+}
+
+/* Member function ibitstream::readBits
+ * ------------------------------------
+ * Reads n bits at once through the buffer's 64-bit accumulator.
+ * In fake mode, each bit is a '0' or '1' character, so we read them one
+ * at a time.
+ */
+uint64_t ibitstream::readBits(int n) {
+    if (n < 0 || n > MAX_BITS_PER_CALL) {
+        error("ibitstream::readBits: number of bits must be between 0 and 64; you passed "
+              + integerToString(n) + ".");
+    }
+    if (!is_open()) {
+        error("ibitstream::readBits: Cannot read bits from a stream that is not open.");
+    }
+
+    uint64_t value = 0;
+    if (this->fake) {
+        for (int i = 0; i < n; i++) {
+            int bit = readBit();
+            if (bit == EOF || fail()) {
+                setstate(std::ios::eofbit | std::ios::failbit);
+                return 0;
             }
-            pos = 0; // start reading from first bit of new byte
-            lastTell = tellg();
+            value |= (uint64_t) bit << i;
         }
-        int result = GetNthBit(pos, curByte);
-        pos++;   // advance bit position for next call to readBit
-        return result;
+    } else if (!bitBuffer().readBits(n, value)) {
+        setstate(std::ios::eofbit | std::ios::failbit);
+        return 0;
     }
+    return value;
 }
 
 /* Member function ibitstream::rewind
@@ -153,27 +191,43 @@ bool ibitstream::is_open() {
 
 /* Constructor obitstream::obitstream
  * ----------------------------------
- * Each obitstream tracks 3 integers as private data.
- * "lastTell" is streampos of the last byte that was written (this is used
- * to detect when other non-writeBit activity has changed the tell)
- * "curByte" contains contents of byte currently being written
- * "pos" is the bit position within curByte that is next to write
- * We set initial state for lastTell and curByte to 0, then pos is
- * set at 8 so that next writeBit will start a new byte.
+ * Each obitstream writes through a BitStreambuf, which collects a large
+ * block of output along with the bits of the byte currently being written.
+ * Subclasses attach their file or string buffer to it.
  */
-obitstream::obitstream() : std::ostream(nullptr), lastTell(0), curByte(0), pos(NUM_BITS_IN_BYTE) {
+obitstream::obitstream() : std::ostream(nullptr), bitbuf(std::ios::out) {
     this->fake = false;
 }
 
+/* Member function obitstream::attach
+ * ----------------------------------
+ * Writes through our bit buffer to the given destination.
+ */
+void obitstream::attach(std::streambuf* source) {
+    bitbuf.setSource(source);
+    init(&bitbuf);
+}
+
+/* Member function obitstream::bitBuffer
+ * -------------------------------------
+ * If a client has pointed the stream at some other buffer with rdbuf,
+ * wraps that buffer so bits can still be written to it.
+ */
+stanfordcpplib::BitStreambuf& obitstream::bitBuffer() {
+    if (rdbuf() != &bitbuf) {
+        bitbuf.setSource(rdbuf());
+        rdbuf(&bitbuf);
+    }
+    return bitbuf;
+}
+
 /* Member function obitstream::writeBit
  * ------------------------------------
- * If bits remain to be written in curByte, add bit into byte and increment pos
- * Else if end of curByte (or some other write happened), then start a fresh
- * byte at position 0.
- * We write the byte out for each bit (backing up to overwrite as needed), rather
- * than waiting for 8 bits.  This is because the client might make
- * 3 writeBit calls and then start using << so we can't wait til full-byte
- * boundary to flush any partial-byte bits.
+ * Adds the bit to the byte currently being written.
+ * The buffer keeps a partial byte in place (rewriting it as more bits are
+ * added) rather than waiting for 8 bits.  This is because the client might
+ * make 3 writeBit calls and then start using << so we can't wait til
+ * full-byte boundary to emit any partial-byte bits.
  */
 void obitstream::writeBit(int bit) {
     if (bit != 0 && bit != 1) {
@@ -187,26 +241,30 @@ void obitstream::writeBit(int bit) {
     if (this->fake) {
         put(bit == 1 ? '1' : '0');
     } else {
-        // if just filled curByte or if data written to stream after last writeBit()
-        if (lastTell != tellp() || pos == NUM_BITS_IN_BYTE) {
-            curByte = 0;   // zero out byte for next writes
-            pos = 0;       // start writing to first bit of new byte
-        }
+        bitBuffer().writeBits((uint64_t) bit, 1);
+    }
+}
 
-        if (bit) {
-            // only need to change if bit needs to be 1 (byte starts already zeroed)
-            SetNthBit(pos, curByte);
-        }
+/* Member function obitstream::writeBits
+ * -------------------------------------
+ * Writes n bits at once through the buffer's 64-bit accumulator.
+ * In fake mode, each bit becomes a '0' or '1' character.
+ */
+void obitstream::writeBits(uint64_t value, int n) {
+    if (n < 0 || n > MAX_BITS_PER_CALL) {
+        error("obitstream::writeBits: number of bits must be between 0 and 64; you passed "
+              + integerToString(n) + ".");
+    }
+    if (!is_open()) {
+        error("obitstream::writeBits: stream is not open");
+    }
 
-        if (pos == 0 || bit) {   // only write if first bit in byte or changing 0 to 1
-            if (pos != 0) {
-                seekp(-1, std::ios::cur);   // back up to overwite if pos > 0
-            }
-            put(curByte);
+    if (this->fake) {
+        for (int i = 0; i < n; i++) {
+            put((value >> i) & 1 ? '1' : '0');
         }
-
-        pos++; // advance to next bit position for next write
-        lastTell = tellp();
+    } else {
+        bitBuffer().writeBits(value, n);
     }
 }
 
@@ -247,7 +305,7 @@ bool obitstream::is_open() {
  * from disk.
  */
 ifbitstream::ifbitstream() {
-    init(&fb);
+    attach(&fb);
 }
 
 /* Constructor ifbitstream::ifbitstream
@@ -256,11 +314,11 @@ ifbitstream::ifbitstream() {
  * from disk, then opens the given file.
  */
 ifbitstream::ifbitstream(const char* filename) {
-    init(&fb);
+    attach(&fb);
     open(filename);
 }
 ifbitstream::ifbitstream(const std::string& filename) {
-    init(&fb);
+    attach(&fb);
     open(filename);
 }
 
@@ -270,6 +328,7 @@ ifbitstream::ifbitstream(const std::string& filename) {
  * to do so.
  */
 void ifbitstream::open(const char* filename) {
+    attach(&fb);   // forget anything buffered from a previous file
     if (!fb.open(filename, std::ios::in | std::ios::binary)) {
         setstate(std::ios::failbit);
     }
@@ -303,7 +362,7 @@ void ifbitstream::close() {
  * to disk.
  */
 ofbitstream::ofbitstream() {
-    init(&fb);
+    attach(&fb);
 }
 
 /* Constructor ofbitstream::ofbitstream
@@ -312,15 +371,25 @@ ofbitstream::ofbitstream() {
  * to disk, then opens the given file.
  */
 ofbitstream::ofbitstream(const char* filename) {
-    init(&fb);
+    attach(&fb);
     open(filename);
 }
 
 ofbitstream::ofbitstream(const std::string& filename) {
-    init(&fb);
+    attach(&fb);
     open(filename);
 }
 
+/* Destructor ofbitstream::~ofbitstream
+ * ------------------------------------
+ * Writes out buffered data before the file buffer closes the file.
+ */
+ofbitstream::~ofbitstream() {
+    if (fb.is_open()) {
+        flush();
+    }
+}
+
 /* Member function ofbitstream::open
  * ---------------------------------
  * Attempts to open the specified file, failing if unable
@@ -337,6 +406,7 @@ void ofbitstream::open(const char* filename) {
               + "different filename.");
         setstate(std::ios::failbit);
     } else {
+        attach(&fb);   // forget anything buffered for a previous file
         if (!fb.open(filename, std::ios::out | std::ios::binary)) {
             setstate(std::ios::failbit);
         }
@@ -356,9 +426,12 @@ bool ofbitstream::is_open() {
 
 /* Member function ofbitstream::close
  * ----------------------------------
- * Closes the given file.
+ * Writes out buffered data and closes the given file.
  */
 void ofbitstream::close() {
+    if (fb.is_open()) {
+        flush();
+    }
     if (!fb.close()) {
         setstate(std::ios::failbit);
     }
@@ -370,8 +443,8 @@ void ofbitstream::close() {
  * the initial string to the specified value.
  */
 istringbitstream::istringbitstream(const std::string& s) {
-    init(&sb);
     sb.str(s);
+    attach(&sb);
 }
 
 /* Member function istringbitstream::str
@@ -381,6 +454,7 @@ istringbitstream::istringbitstream(const std::string& s) {
  */
 void istringbitstream::str(const std::string& s) {
     sb.str(s);
+    attach(&sb);   // discard data read ahead from the old string
 }
 
 /* Member function ostringbitstream::ostringbitstream
@@ -388,13 +462,14 @@ void istringbitstream::str(const std::string& s) {
  * Sets the stream to use the string buffer.
  */
 ostringbitstream::ostringbitstream() {
-    init(&sb);
+    attach(&sb);
 }
 
 /* Member function ostringbitstream::str
  * -------------------------------------
- * Retrives the underlying string data.
+ * Retrives the underlying string data, including any buffered bits.
  */
 std::string ostringbitstream::str() {
+    flush();
     return sb.str();
 }
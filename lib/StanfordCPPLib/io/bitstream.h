@@ -18,7 +18,14 @@
  * obitstream class similarly has ofbitstream and ostringbitstream as
  * subclasses.
  *
+ * Both kinds of stream keep a large block of data in memory and pack bits
+ * into it through a 64-bit accumulator, so that the underlying file or string
+ * is only touched once per block rather than once per bit.  The readBits and
+ * writeBits member functions transfer up to 64 bits in a single call.
+ *
  * @author Keith Schwarz, Eric Roberts, Marty Stepp
+ * @version 2026/10/17
+ * - buffered bit I/O through a 64-bit accumulator; added readBits, writeBits
  * @version 2016/11/12
  * - made toPrintable non-static and visible
  */
@@ -30,6 +37,8 @@
 #include <ostream>
 #include <fstream>
 #include <sstream>
+#include <stdint.h>
+#include "private/bitstreambuf.h"
 
 /* Constant: PSEUDO_EOF
  * A constant representing the PSEUDO_EOF marker that you will
@@ -78,6 +87,20 @@ public:
      */
     int readBit();
 
+    /*
+     * Member function: readBits
+     * Usage: value = in.readBits(n);
+     * ------------------------------
+     * Reads the next n bits (0 <= n <= 64) from the ibitstream and returns
+     * them as an integer whose least significant bit is the first bit read,
+     * so that readBits(n) returns the same bits as n calls to readBit.
+     * If the stream runs out of bits, returns 0 and puts the stream into a
+     * fail state, which can be detected by calling in.fail().
+     * Raises an error if n is out of range or if this ibitstream has not been
+     * properly opened.
+     */
+    uint64_t readBits(int n);
+
     /*
      * Member function: rewind
      * Usage: in.rewind();
@@ -112,10 +135,21 @@ public:
      */
     virtual bool is_open();
 
+protected:
+    /*
+     * Attaches this ibitstream to read from the given stream buffer.
+     * Subclasses call this with their file or string buffer.
+     */
+    void attach(std::streambuf* source);
+
 private:
-    std::streampos lastTell;
-    int curByte;
-    int pos;
+    /*
+     * Returns the bit buffer that this stream reads through, wrapping
+     * any stream buffer that a client has attached with rdbuf.
+     */
+    stanfordcpplib::BitStreambuf& bitBuffer();
+
+    stanfordcpplib::BitStreambuf bitbuf;
     bool fake;
 };
 
@@ -151,6 +185,20 @@ public:
      */
     void writeBit(int bit);
 
+    /*
+     * Member function: writeBits
+     * Usage: out.writeBits(value, n);
+     * -------------------------------
+     * Writes the low n bits of the given value (0 <= n <= 64) to the
+     * obitstream, least significant bit first, so that writeBits(value, n)
+     * writes the same bits as n calls to writeBit.
+     * A partial final byte is padded with 0 bits if the stream is flushed or
+     * closed, or if ordinary byte output is written, before it is filled.
+     * Raises an error if n is out of range or if this obitstream has not been
+     * properly opened.
+     */
+    void writeBits(uint64_t value, int n);
+
     /*
      * Member function: size
      * Usage: sz = in.size();
@@ -175,10 +223,21 @@ public:
      */
     virtual bool is_open();
 
+protected:
+    /*
+     * Attaches this obitstream to write to the given stream buffer.
+     * Subclasses call this with their file or string buffer.
+     */
+    void attach(std::streambuf* source);
+
 private:
-    std::streampos lastTell;
-    int curByte;
-    int pos;
+    /*
+     * Returns the bit buffer that this stream writes through, wrapping
+     * any stream buffer that a client has attached with rdbuf.
+     */
+    stanfordcpplib::BitStreambuf& bitBuffer();
+
+    stanfordcpplib::BitStreambuf bitbuf;
     bool fake;
 };
 
@@ -282,6 +341,13 @@ public:
     ofbitstream(const char* filename);
     ofbitstream(const std::string& filename);
 
+    /*
+     * Destructor: ~ofbitstream();
+     * -------------------------
+     * Writes out any buffered bits and closes the file.
+     */
+    virtual ~ofbitstream();
+
     /*
      * Member function: open(const char* filename);
      * Member function: open(string filename);
@@ -4,6 +4,8 @@
  * This file implements the filelib.h interface.  All platform dependencies
  * are managed through the platform interface.
  * 
+ * @version 2026/10/17
+ * - added mapFile; files are mapped with mmap on Linux and Mac
  * @version 2016/11/20
  * - small bug fix in readEntireStream method (failed for non-text files)
  * @version 2016/11/12
@@ -26,11 +28,20 @@
 #include "filelib.h"
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <string>
 #include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "error.h"
 #include "private/platform.h"
 #include "simpio.h"
 #include "strlib.h"
@@ -221,6 +232,197 @@ Vector<std::string> listDirectory(const std::string& path) {
     return v;
 }
 
+MappedFile::MappedFile()
+        : m_data(nullptr),
+          m_size(0),
+          m_isMapped(false) {
+    // empty
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other)
+        : m_data(other.m_data),
+          m_size(other.m_size),
+          m_isMapped(other.m_isMapped) {
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_isMapped = false;
+}
+
+MappedFile& MappedFile::operator =(MappedFile&& other) {
+    if (this != &other) {
+        release();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_isMapped = other.m_isMapped;
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_isMapped = false;
+    }
+    return *this;
+}
+
+const char* MappedFile::data() const {
+    return m_data;
+}
+
+bool MappedFile::isEmpty() const {
+    return m_size == 0;
+}
+
+size_t MappedFile::size() const {
+    return m_size;
+}
+
+std::string MappedFile::toString() const {
+    return m_size == 0 ? std::string() : std::string(m_data, m_size);
+}
+
+#if __cplusplus >= 201703L
+MappedFile::LineRange MappedFile::lines() const {
+    return LineRange(m_data, m_data + m_size);
+}
+
+std::string_view MappedFile::view() const {
+    return std::string_view(m_data, m_size);
+}
+
+MappedFile::LineRange::LineRange(const char* start, const char* end)
+        : m_start(start),
+          m_end(end) {
+    // empty
+}
+
+MappedFile::LineRange::iterator MappedFile::LineRange::begin() const {
+    return iterator(m_start, m_end);
+}
+
+MappedFile::LineRange::iterator MappedFile::LineRange::end() const {
+    return iterator(m_end, m_end);
+}
+
+MappedFile::LineRange::iterator::iterator(const char* start, const char* end)
+        : m_next(start),
+          m_end(end) {
+    advance();
+}
+
+/*
+ * Moves m_line to the line that starts at m_next.  When no text is left,
+ * m_next becomes null, which is how the end iterator is recognized.
+ */
+void MappedFile::LineRange::iterator::advance() {
+    if (m_next == m_end) {
+        m_line = std::string_view();
+        m_next = nullptr;
+        return;
+    }
+    const char* start = m_next;
+    const char* newline = static_cast<const char*>(memchr(start, '\n', size_t(m_end - start)));
+    const char* stop = newline ? newline : m_end;
+    m_next = newline ? newline + 1 : m_end;
+    if (stop != start && stop[-1] == '\r') {
+        stop--;
+    }
+    m_line = std::string_view(start, size_t(stop - start));
+}
+
+std::string_view MappedFile::LineRange::iterator::operator *() const {
+    return m_line;
+}
+
+const std::string_view* MappedFile::LineRange::iterator::operator ->() const {
+    return &m_line;
+}
+
+MappedFile::LineRange::iterator& MappedFile::LineRange::iterator::operator ++() {
+    advance();
+    return *this;
+}
+
+MappedFile::LineRange::iterator MappedFile::LineRange::iterator::operator ++(int) {
+    iterator copy = *this;
+    advance();
+    return copy;
+}
+
+bool MappedFile::LineRange::iterator::operator ==(const iterator& other) const {
+    return m_next == other.m_next;
+}
+
+bool MappedFile::LineRange::iterator::operator !=(const iterator& other) const {
+    return m_next != other.m_next;
+}
+#endif // __cplusplus >= 201703L
+
+void MappedFile::release() {
+    if (m_isMapped) {
+#ifndef _WIN32
+        munmap(m_data, m_size);
+#endif
+    } else {
+        delete[] m_data;
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_isMapped = false;
+}
+
+MappedFile mapFile(const std::string& filename) {
+    std::string path = expandPathname(filename);
+    MappedFile file;
+#ifdef _WIN32
+    // no mmap; read the whole file into memory instead
+    std::ifstream input;
+    input.open(path.c_str(), std::ifstream::binary);
+    if (input.fail()) {
+        error("mapFile: input file not found or cannot be opened: " + filename);
+    }
+    input.seekg(0, std::ifstream::end);
+    std::streamoff size = input.tellg();
+    input.seekg(0, std::ifstream::beg);
+    if (size > 0) {
+        file.m_data = new char[size_t(size)];
+        file.m_size = size_t(size);
+        input.read(file.m_data, size);
+        if (input.gcount() != size) {
+            error("mapFile: unable to read file: " + filename);
+        }
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error("mapFile: input file not found or cannot be opened: " + filename);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)
+            || (std::uint64_t) info.st_size > SIZE_MAX) {
+        close(fd);
+        error("mapFile: not a regular file or too large to map: " + filename);
+    }
+    size_t size = size_t(info.st_size);
+    if (size > 0) {
+        // mmap cannot map zero bytes, so an empty file is left unmapped
+        void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            error("mapFile: unable to map file: " + filename);
+        }
+        // the file is usually scanned from front to back; let the kernel
+        // read ahead aggressively and drop pages behind the scan
+        madvise(data, size, MADV_SEQUENTIAL);
+        file.m_data = static_cast<char*>(data);
+        file.m_size = size;
+        file.m_isMapped = true;
+    }
+    close(fd);
+#endif // _WIN32
+    return file;
+}
+
 bool matchFilenamePattern(const std::string& filename, const std::string& pattern) {
     return recursiveMatch(filename, 0, pattern, 0);
 }
@@ -8,6 +8,8 @@
  * contain separators in any of the supported styles, which usually
  * makes it possible to use the same code on different platforms.
  * 
+ * @version 2026/10/17
+ * - added mapFile and MappedFile for reading files in place, line by line
  * @version 2016/11/12
  * - added fileSize, readEntireStream
  * @version 2016/08/12
@@ -23,10 +25,15 @@
 #ifndef _filelib_h
 #define _filelib_h
 
+#include <cstddef>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <vector>
+#if __cplusplus >= 201703L
+#include <iterator>
+#include <string_view>
+#endif
 #include "vector.h"
 
 /*
@@ -234,6 +241,170 @@ void listDirectory(const std::string& path, Vector<std::string>& list);
 void listDirectory(const std::string& path, std::vector<std::string>& list);
 Vector<std::string> listDirectory(const std::string& path);
 
+/*
+ * Class: MappedFile
+ * -----------------
+ * A read-only view of a file's entire contents, as returned by mapFile.
+ * On Linux and Mac the file is mapped into memory, so pages are read only
+ * as they are touched and nothing is copied; on Windows the contents are
+ * read into memory once.  The mapping is released when the object is
+ * destroyed, and any pointers or views into it become invalid then.
+ * A MappedFile can be moved but not copied.
+ *
+ *<pre>
+ *    MappedFile file = mapFile("bass.txt");
+ *    for (std::string_view line : file.lines()) {
+ *        ...
+ *    }
+ *</pre>
+ */
+class MappedFile {
+public:
+    /*
+     * Constructor: MappedFile
+     * Usage: MappedFile file;
+     * -----------------------
+     * Creates an empty MappedFile that refers to no file.
+     */
+    MappedFile();
+
+    /*
+     * Destructor: ~MappedFile
+     * -----------------------
+     * Releases the mapping.
+     */
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other);
+    MappedFile& operator =(MappedFile&& other);
+
+    /*
+     * Method: data
+     * Usage: const char* p = file.data();
+     * -----------------------------------
+     * Returns a pointer to the first byte of the file's contents.  The bytes
+     * are not null-terminated.  Returns nullptr for an empty file.
+     */
+    const char* data() const;
+
+    /*
+     * Method: isEmpty
+     * Usage: if (file.isEmpty()) ...
+     * ------------------------------
+     * Returns true if the file has no contents.
+     */
+    bool isEmpty() const;
+
+    /*
+     * Method: size
+     * Usage: size_t n = file.size();
+     * ------------------------------
+     * Returns the number of bytes in the file.
+     */
+    size_t size() const;
+
+    /*
+     * Method: toString
+     * Usage: string text = file.toString();
+     * -------------------------------------
+     * Returns a copy of the file's entire contents.
+     */
+    std::string toString() const;
+
+#if __cplusplus >= 201703L
+    /*
+     * Class: MappedFile::LineRange
+     * ----------------------------
+     * The sequence of lines returned by lines().  Lines are found one at a
+     * time as you iterate, and each one is a std::string_view into the
+     * mapping, so no memory is allocated.  Lines end at '\n', which is not
+     * part of the line, and a '\r' before it is dropped as well.  A final
+     * line without a newline is included; the empty text after a trailing
+     * newline is not.  So the lines are the ones getline would read, except
+     * that getline leaves the '\r' of a Windows line ending in the line.
+     */
+    class LineRange {
+    public:
+        class iterator {
+        public:
+            // operator * returns the line by value, so this is an input
+            // iterator, although the lines can be walked more than once
+            typedef std::input_iterator_tag iterator_category;
+            typedef std::string_view value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const std::string_view* pointer;
+            typedef std::string_view reference;
+
+            std::string_view operator *() const;
+            const std::string_view* operator ->() const;
+            iterator& operator ++();
+            iterator operator ++(int);
+            bool operator ==(const iterator& other) const;
+            bool operator !=(const iterator& other) const;
+
+        private:
+            iterator(const char* start, const char* end);
+            void advance();
+
+            std::string_view m_line;    // current line
+            const char* m_next;         // where the next line starts
+            const char* m_end;          // end of the file's contents
+            friend class LineRange;
+        };
+
+        iterator begin() const;
+        iterator end() const;
+
+    private:
+        LineRange(const char* start, const char* end);
+
+        const char* m_start;
+        const char* m_end;
+        friend class MappedFile;
+    };
+
+    /*
+     * Method: lines
+     * Usage: for (std::string_view line : file.lines()) ...
+     * -----------------------------------------------------
+     * Returns the file's lines as views into the mapping; see LineRange.
+     */
+    LineRange lines() const;
+
+    /*
+     * Method: view
+     * Usage: std::string_view text = file.view();
+     * -------------------------------------------
+     * Returns the file's entire contents as a view into the mapping.
+     */
+    std::string_view view() const;
+#endif // __cplusplus >= 201703L
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator =(const MappedFile&);
+
+    void release();
+
+    char* m_data;
+    size_t m_size;
+    bool m_isMapped;   // true if m_data was mapped rather than allocated
+
+    friend MappedFile mapFile(const std::string& filename);
+};
+
+/*
+ * Function: mapFile
+ * Usage: MappedFile file = mapFile(filename);
+ * -------------------------------------------
+ * Opens the given file for reading in place and returns a MappedFile that
+ * gives access to its contents without copying them, which is much faster
+ * than reading a large file through a stream.  The file should not be
+ * modified while it is mapped.
+ * Throws an error if the file is not found or cannot be read.
+ */
+MappedFile mapFile(const std::string& filename);
+
 /*
  * Function: matchFilenamePattern
  * Usage: if (matchFilenamePattern(filename, pattern)) ...
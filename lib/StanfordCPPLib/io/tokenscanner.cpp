@@ -3,6 +3,12 @@
  * ----------------------
  * Implementation for the TokenScanner class.
  * 
+ * @version 2026/10/17
+ * - string input is scanned directly from the buffer instead of an istringstream
+ * - character classes come from a 256-entry table; operators are kept in a trie
+ * - saved tokens are kept in a vector instead of a linked list
+ * - a number such as 1e or 1e+ with no exponent digits now stops before the e
+ * - added nextTokenView (C++17 and later)
  * @version 2016/11/26
  * - added getInput method
  * - replaced occurrences of string with const string& for efficiency
@@ -14,10 +20,9 @@
 
 #include "tokenscanner.h"
 #include <cctype>
+#include <cstring>
 #include <iostream>
 #include "error.h"
-#include "strlib.h"
-#include "stack.h"
 
 TokenScanner::TokenScanner() {
     initScanner();
@@ -35,23 +40,39 @@ TokenScanner::TokenScanner(const std::string& str) {
 }
 
 TokenScanner::~TokenScanner() {
-    if (stringInputFlag) {
-        delete isp;
-    }
+    // empty
 }
 
 void TokenScanner::addOperator(const std::string& op) {
-    StringCell* cp = new StringCell;
-    cp->str = op;
-    cp->link = operators;
-    operators = cp;
+    int node = 0;
+    for (char ch : op) {
+        int child = findOperatorChild(node, (unsigned char) ch);
+        if (child == -1) {
+            OperatorNode cell;
+            cell.ch = ch;
+            cell.isOperator = false;
+            cell.firstChild = -1;
+            cell.nextSibling = operators[node].firstChild;
+            child = int(operators.size());
+            operators.push_back(cell);
+            operators[node].firstChild = child;
+        }
+        node = child;
+    }
+    operators[node].isOperator = true;
 }
 
 void TokenScanner::addWordCharacters(const std::string& str) {
     wordChars += str;
+    for (char ch : str) {
+        charClasses[(unsigned char) ch] |= WORD_CLASS;
+    }
 }
 
 int TokenScanner::getChar() {
+    if (stringInputFlag) {
+        return readChar();
+    }
     return isp->get();
 }
 
@@ -60,10 +81,11 @@ std::string TokenScanner::getInput() const {
 }
 
 int TokenScanner::getPosition() const {
-    if (!savedTokens) {
-        return int(isp->tellg());
+    int pos = stringInputFlag ? int(bufferPos) : int(isp->tellg());
+    if (savedTokens.empty()) {
+        return pos;
     } else {
-        return int(isp->tellg()) - savedTokens->str.length();
+        return pos - int(savedTokens.back().length());
     }
 }
 
@@ -129,14 +151,14 @@ TokenType TokenScanner::getTokenType(const std::string& token) const {
         return TokenType(EOF);
     }
 
-    char ch = token[0];
-    if (isspace(ch)) {
+    int ch = (unsigned char) token[0];
+    if (isSpaceClass(ch)) {
         return SEPARATOR;
     } else if (ch == '"' || (ch == '\'' && token.length() > 1)) {
         return STRING;
-    } else if (isdigit(ch)) {
+    } else if (isDigitClass(ch)) {
         return NUMBER;
-    } else if (isWordCharacter(ch)) {
+    } else if (isWordClass(ch)) {
         return WORD;
     } else {
         return OPERATOR;
@@ -145,8 +167,9 @@ TokenType TokenScanner::getTokenType(const std::string& token) const {
 
 bool TokenScanner::hasMoreTokens() {
     std::string token = nextToken();
-    saveToken(token);
-    return !token.empty();
+    bool more = !token.empty();
+    savedTokens.push_back(std::move(token));
+    return more;
 }
 
 void TokenScanner::ignoreComments() {
@@ -158,85 +181,41 @@ void TokenScanner::ignoreWhitespace() {
 }
 
 bool TokenScanner::isWordCharacter(char ch) const {
-    return isalnum(ch) || wordChars.find(ch) != std::string::npos;
+    return isWordClass((unsigned char) ch);
 }
 
 std::string TokenScanner::nextToken() {
-    if (savedTokens) {
-        StringCell* cp = savedTokens;
-        std::string token = cp->str;
-        savedTokens = cp->link;
-        delete cp;
+    if (!savedTokens.empty()) {
+        std::string token = std::move(savedTokens.back());
+        savedTokens.pop_back();
         return token;
     }
+    scanNextToken();
+    if (stringInputFlag) {
+        return buffer.substr(tokenStart, bufferPos - tokenStart);
+    } else {
+        return streamToken;
+    }
+}
 
-    while (true) {
-        if (ignoreWhitespaceFlag) {
-            skipSpaces();
-        }
-        int ch = isp->get();
-        if (ch == '/' && ignoreCommentsFlag) {
-            ch = isp->get();
-            if (ch == '/') {
-                while (true) {
-                    ch = isp->get();
-                    if (ch == '\n' || ch == '\r' || ch == EOF) {
-                        break;
-                    }
-                }
-                continue;
-            } else if (ch == '*') {
-                int prev = EOF;
-                while (true) {
-                    ch = isp->get();
-                    if (ch == EOF || (prev == '*' && ch == '/')) {
-                        break;
-                    }
-                    prev = ch;
-                }
-                continue;
-            }
-            if (ch != EOF) {
-                isp->unget();
-            }
-            ch = '/';
-        }
-        if (ch == EOF) {
-            return "";
-        }
-        if ((ch == '"' || ch == '\'') && scanStringsFlag) {
-            isp->unget();
-            return scanString();
-        }
-        if (isdigit(ch) && scanNumbersFlag) {
-            isp->unget();
-            return scanNumber();
-        }
-        if (isWordCharacter(ch)) {
-            isp->unget();
-            return scanWord();
-        }
-        std::string op = std::string(1, ch);
-        while (isOperatorPrefix(op)) {
-            ch = isp->get();
-            if (ch == EOF) {
-                break;
-            }
-            op += ch;
-        }
-        while (op.length() > 1 && !isOperator(op)) {
-            isp->unget();
-            op.erase(op.length() - 1, 1);
-        }
-        return op;
+#if __cplusplus >= 201703L
+std::string_view TokenScanner::nextTokenView() {
+    if (!savedTokens.empty()) {
+        streamToken = std::move(savedTokens.back());
+        savedTokens.pop_back();
+        return streamToken;
+    }
+    scanNextToken();
+    if (stringInputFlag) {
+        return std::string_view(buffer).substr(tokenStart, bufferPos - tokenStart);
+    } else {
+        return streamToken;
     }
 }
+#endif
 
 void TokenScanner::saveToken(const std::string& token) {
-    StringCell* cp = new StringCell;
-    cp->str = token;
-    cp->link = savedTokens;
-    savedTokens = cp;
+    savedTokens.push_back(token);
 }
 
 void TokenScanner::scanNumbers() {
@@ -250,18 +229,24 @@ void TokenScanner::scanStrings() {
 void TokenScanner::setInput(std::istream& infile) {
     stringInputFlag = false;
     isp = &infile;
-    savedTokens = nullptr;
+    savedTokens.clear();
 }
 
 void TokenScanner::setInput(const std::string& str) {
     stringInputFlag = true;
     buffer = str;
-    isp = new std::istringstream(buffer);
-    savedTokens = nullptr;
+    isp = nullptr;
+    bufferPos = 0;
+    tokenStart = 0;
+    savedTokens.clear();
 }
 
 void TokenScanner::ungetChar(int) {
-    isp->unget();
+    if (stringInputFlag) {
+        unreadChar();
+    } else {
+        isp->unget();
+    }
 }
 
 void TokenScanner::verifyToken(const std::string& expected) {
@@ -278,38 +263,165 @@ void TokenScanner::verifyToken(const std::string& expected) {
 
 /* Private methods */
 
+/*
+ * Implementation notes: initScanner
+ * ---------------------------------
+ * The character class table records, for each possible character value,
+ * whether it is whitespace, a digit, or legal in a word, so that the
+ * scanner never has to call the <cctype> functions or search wordChars
+ * while it runs.  The default table is computed once and copied into
+ * each scanner.  The operator trie starts out with just its root.
+ */
 void TokenScanner::initScanner() {
     ignoreWhitespaceFlag = false;
     ignoreCommentsFlag = false;
     scanNumbersFlag = false;
     scanStringsFlag = false;
-    operators = nullptr;
+    isp = nullptr;
+    stringInputFlag = false;
+    bufferPos = 0;
+    tokenStart = 0;
+    struct ClassTable {
+        unsigned char classes[256];
+    };
+    static const ClassTable defaultTable = [] {
+        ClassTable table;
+        for (int ch = 0; ch < 256; ch++) {
+            table.classes[ch] = (unsigned char) ((isspace(ch) ? SPACE_CLASS : 0)
+                    | (isdigit(ch) ? DIGIT_CLASS : 0)
+                    | (isalnum(ch) ? WORD_CLASS : 0));
+        }
+        return table;
+    }();
+    memcpy(charClasses, defaultTable.classes, sizeof(charClasses));
+    OperatorNode root;
+    root.ch = '\0';
+    root.isOperator = false;
+    root.firstChild = -1;
+    root.nextSibling = -1;
+    operators.assign(1, root);
 }
 
 /*
- * Implementation notes: isOperator, isOperatorPrefix
- * --------------------------------------------------
- * These methods search the list of operators and return true if the
- * specified operator is either in the list or a prefix of an operator
- * in the list, respectively.  This code could be made considerably more
- * efficient by implementing operators as a trie.
+ * Implementation notes: findOperatorChild
+ * ---------------------------------------
+ * Returns the index of the child of the given trie node that is labeled
+ * with ch, or -1 if there is none.  Operators are short and few, so a
+ * sibling list is both smaller and faster than a table of children.
  */
-bool TokenScanner::isOperator(const std::string& op) {
-    for (StringCell *cp = operators; cp != nullptr; cp = cp->link) {
-        if (op == cp->str) {
-            return true;
+int TokenScanner::findOperatorChild(int node, int ch) const {
+    for (int child = operators[node].firstChild; child != -1;
+         child = operators[child].nextSibling) {
+        if ((unsigned char) operators[child].ch == ch) {
+            return child;
         }
     }
-    return false;
+    return -1;
+}
+
+bool TokenScanner::isDigitClass(int ch) const {
+    return ch != EOF && (charClasses[(unsigned char) ch] & DIGIT_CLASS);
+}
+
+bool TokenScanner::isSpaceClass(int ch) const {
+    return ch != EOF && (charClasses[(unsigned char) ch] & SPACE_CLASS);
 }
 
-bool TokenScanner::isOperatorPrefix(const std::string& op) {
-    for (StringCell* cp = operators; cp != nullptr; cp = cp->link) {
-        if (startsWith(cp->str, op)) {
-            return true;
+bool TokenScanner::isWordClass(int ch) const {
+    return ch != EOF && (charClasses[(unsigned char) ch] & WORD_CLASS);
+}
+
+/*
+ * Implementation notes: readChar, unreadChar
+ * ------------------------------------------
+ * All scanning goes through these two methods.  For string input they
+ * just move an index through the buffer, and the current token is the
+ * part of the buffer between tokenStart and that index.  For stream input
+ * they read from the stream and keep the characters of the current token
+ * in streamToken.
+ */
+int TokenScanner::readChar() {
+    if (stringInputFlag) {
+        if (bufferPos >= buffer.length()) {
+            return EOF;
+        }
+        return (unsigned char) buffer[bufferPos++];
+    }
+    int ch = isp->get();
+    if (ch != EOF) {
+        streamToken += char(ch);
+    }
+    return ch;
+}
+
+void TokenScanner::unreadChar() {
+    if (stringInputFlag) {
+        if (bufferPos > 0) {
+            bufferPos--;
+        }
+        return;
+    }
+    isp->unget();
+    if (!streamToken.empty()) {
+        streamToken.erase(streamToken.length() - 1);
+    }
+}
+
+/*
+ * Implementation notes: scanNextToken
+ * -----------------------------------
+ * Skips whitespace and comments as requested and then reads one token,
+ * leaving it in the buffer range or streamToken as described above.
+ * At the end of the input the token is empty.
+ */
+void TokenScanner::scanNextToken() {
+    while (true) {
+        if (ignoreWhitespaceFlag) {
+            skipSpaces();
+        }
+        tokenStart = bufferPos;
+        streamToken.clear();
+        int ch = readChar();
+        if (ch == '/' && ignoreCommentsFlag) {
+            ch = readChar();
+            if (ch == '/') {
+                while (true) {
+                    ch = readChar();
+                    if (ch == '\n' || ch == '\r' || ch == EOF) {
+                        break;
+                    }
+                }
+                continue;
+            } else if (ch == '*') {
+                int prev = EOF;
+                while (true) {
+                    ch = readChar();
+                    if (ch == EOF || (prev == '*' && ch == '/')) {
+                        break;
+                    }
+                    prev = ch;
+                }
+                continue;
+            }
+            if (ch != EOF) {
+                unreadChar();
+            }
+            ch = '/';
+        }
+        if (ch == EOF) {
+            return;
         }
+        if ((ch == '"' || ch == '\'') && scanStringsFlag) {
+            scanString();
+        } else if (isDigitClass(ch) && scanNumbersFlag) {
+            scanNumber();
+        } else if (isWordClass(ch)) {
+            scanWord();
+        } else {
+            scanOperator(ch);
+        }
+        return;
     }
-    return false;
 }
 
 /*
@@ -320,27 +432,21 @@ bool TokenScanner::isOperatorPrefix(const std::string& op) {
  * call a finite-state machine.  The program uses the variable
  * <code>state</code> to record the history of the process and
  * determine what characters would be legal at this point in time.
+ * The first digit has already been read.
  */
-std::string TokenScanner::scanNumber() {
-    std::string token = "";
-    NumberScannerState state = INITIAL_STATE;
+void TokenScanner::scanNumber() {
+    NumberScannerState state = BEFORE_DECIMAL_POINT;
     while (state != FINAL_STATE) {
-        int ch = isp->get();
+        int ch = readChar();
         switch (state) {
-        case INITIAL_STATE:
-            if (!isdigit(ch)) {
-                error("TokenScanner::scanNumber: internal error: illegal call");
-            }
-            state = BEFORE_DECIMAL_POINT;
-            break;
         case BEFORE_DECIMAL_POINT:
             if (ch == '.') {
                 state = AFTER_DECIMAL_POINT;
             } else if (ch == 'E' || ch == 'e') {
                 state = STARTING_EXPONENT;
-            } else if (!isdigit(ch)) {
+            } else if (!isDigitClass(ch)) {
                 if (ch != EOF) {
-                    isp->unget();
+                    unreadChar();
                 }
                 state = FINAL_STATE;
             }
@@ -348,9 +454,9 @@ std::string TokenScanner::scanNumber() {
         case AFTER_DECIMAL_POINT:
             if (ch == 'E' || ch == 'e') {
                 state = STARTING_EXPONENT;
-            } else if (!isdigit(ch)) {
+            } else if (!isDigitClass(ch)) {
                 if (ch != EOF) {
-                    isp->unget();
+                    unreadChar();
                 }
                 state = FINAL_STATE;
             }
@@ -358,32 +464,32 @@ std::string TokenScanner::scanNumber() {
         case STARTING_EXPONENT:
             if (ch == '+' || ch == '-') {
                 state = FOUND_EXPONENT_SIGN;
-            } else if (isdigit(ch)) {
+            } else if (isDigitClass(ch)) {
                 state = SCANNING_EXPONENT;
             } else {
                 if (ch != EOF) {
-                    isp->unget();
+                    unreadChar();
                 }
-                isp->unget();
+                unreadChar();
                 state = FINAL_STATE;
             }
             break;
         case FOUND_EXPONENT_SIGN:
-            if (isdigit(ch)) {
+            if (isDigitClass(ch)) {
                 state = SCANNING_EXPONENT;
             } else {
                 if (ch != EOF) {
-                    isp->unget();
+                    unreadChar();
                 }
-                isp->unget();
-                isp->unget();
+                unreadChar();
+                unreadChar();
                 state = FINAL_STATE;
             }
             break;
         case SCANNING_EXPONENT:
-            if (!isdigit(ch)) {
+            if (!isDigitClass(ch)) {
                 if (ch != EOF) {
-                    isp->unget();
+                    unreadChar();
                 }
                 state = FINAL_STATE;
             }
@@ -392,27 +498,52 @@ std::string TokenScanner::scanNumber() {
             state = FINAL_STATE;
             break;
         }
-        if (state != FINAL_STATE) {
-            token += char(ch);
+    }
+}
+
+/*
+ * Implementation notes: scanOperator
+ * ----------------------------------
+ * Follows the operator trie from the character ch, which has already been
+ * read, for as long as the input matches, remembering the length of the
+ * longest operator seen.  Characters read beyond that operator are pushed
+ * back.  A character that does not start an operator is returned by itself.
+ */
+void TokenScanner::scanOperator(int ch) {
+    int node = findOperatorChild(0, ch);
+    int length = 1;
+    int longest = 1;
+    while (node != -1) {
+        if (operators[node].isOperator) {
+            longest = length;
+        }
+        ch = readChar();
+        if (ch == EOF) {
+            break;
         }
+        length++;
+        node = findOperatorChild(node, ch);
+    }
+    while (length > longest) {
+        unreadChar();
+        length--;
     }
-    return token;
 }
 
 /*
  * Implementation notes: scanString
  * --------------------------------
- * Reads and returns a quoted string from the scanner, continuing until
- * it scans the matching delimiter.  The scanner generates an error if
- * there is no closing quotation mark before the end of the input.
+ * Reads a quoted string from the scanner, continuing until it scans the
+ * matching delimiter, which is the character that has already been read.
+ * The scanner generates an error if there is no closing quotation mark
+ * before the end of the input.
  */
-std::string TokenScanner::scanString() {
-    std::string token = "";
-    char delim = isp->get();
-    token += delim;
+void TokenScanner::scanString() {
+    int delim = stringInputFlag ? (unsigned char) buffer[tokenStart]
+                                : (unsigned char) streamToken[0];
     bool escape = false;
     while (true) {
-        int ch = isp->get();
+        int ch = readChar();
         if (ch == EOF) {
             error("TokenScanner::scanString: found unterminated string");
         }
@@ -420,9 +551,7 @@ std::string TokenScanner::scanString() {
             break;
         }
         escape = (ch == '\\') && !escape;
-        token += ch;
     }
-    return token + delim;
 }
 
 /*
@@ -431,20 +560,17 @@ std::string TokenScanner::scanString() {
  * Reads characters until the scanner reaches the end of a sequence
  * of word characters.
  */
-std::string TokenScanner::scanWord() {
-    std::string token = "";
+void TokenScanner::scanWord() {
     while (true) {
-        int ch = isp->get();
+        int ch = readChar();
         if (ch == EOF) {
             break;
         }
-        if (!isWordCharacter(ch)) {
-            isp->unget();
+        if (!isWordClass(ch)) {
+            unreadChar();
             break;
         }
-        token += char(ch);
     }
-    return token;
 }
 
 /*
@@ -454,12 +580,18 @@ std::string TokenScanner::scanWord() {
  * not a whitespace character.
  */
 void TokenScanner::skipSpaces() {
+    if (stringInputFlag) {
+        while (bufferPos < buffer.length() && isSpaceClass((unsigned char) buffer[bufferPos])) {
+            bufferPos++;
+        }
+        return;
+    }
     while (true) {
         int ch = isp->get();
         if (ch == EOF) {
             return;
         }
-        if (!isspace(ch)) {
+        if (!isSpaceClass(ch)) {
             isp->unget();
             return;
         }
@@ -4,6 +4,10 @@
  * This file exports a <code>TokenScanner</code> class that divides
  * a string into individual logical units called <b><i>tokens</i></b>.
  *
+ * @version 2026/10/17
+ * - string input is scanned directly from the buffer instead of an istringstream
+ * - character classes come from a 256-entry table; operators are kept in a trie
+ * - added nextTokenView (C++17 and later)
  * @version 2016/11/26
  * - added getInput method
  * - replaced occurrences of string with const string& for efficiency
@@ -16,6 +20,10 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 #include "private/tokenpatch.h"
 
 /*
@@ -207,6 +215,21 @@ public:
      */
     std::string nextToken();
 
+#if __cplusplus >= 201703L
+    /*
+     * Method: nextTokenView
+     * Usage: string_view token = scanner.nextTokenView();
+     * ----------------------------------------------------
+     * Returns the next token from this scanner, just like
+     * <code>nextToken</code>, but as a view instead of a new string.
+     * For string input the view points into the scanner's input buffer;
+     * otherwise it points into storage owned by the scanner.  The view
+     * is valid until the next call that reads from or changes the
+     * scanner's input.
+     */
+    std::string_view nextTokenView();
+#endif
+
     /*
      * Method: saveToken
      * Usage: scanner.saveToken(token);
@@ -294,21 +317,30 @@ public:
 
 private:
     /*
-     * Private type: StringCell
-     * ------------------------
-     * This type is used to construct linked lists of cells, which are used
-     * to represent both the stack of saved tokens and the set of defined
-     * operators.  These types cannot use the Stack and Lexicon classes
-     * directly because tokenscanner.h is an extremely low-level interface,
-     * and doing so would create circular dependencies in the .h files.
+     * Private type: OperatorNode
+     * --------------------------
+     * This type is used to build a trie of the defined operators.  Each
+     * node has a character and links to its first child and next sibling;
+     * the trie is stored in a vector whose first element is the root.
+     * These types cannot use the Map and Lexicon classes directly because
+     * tokenscanner.h is an extremely low-level interface, and doing so
+     * would create circular dependencies in the .h files.
      */
-    struct StringCell {
-        std::string str;
-        StringCell *link;
+    struct OperatorNode {
+        char ch;
+        bool isOperator;
+        int firstChild;
+        int nextSibling;
+    };
+
+    /* Bits of the character class table */
+    enum CharacterClass {
+        SPACE_CLASS = 1,
+        DIGIT_CLASS = 2,
+        WORD_CLASS = 4
     };
 
     enum NumberScannerState {
-        INITIAL_STATE,
         BEFORE_DECIMAL_POINT,
         AFTER_DECIMAL_POINT,
         STARTING_EXPONENT,
@@ -320,22 +352,32 @@ private:
     std::string buffer;              /* The original argument string */
     std::istream* isp;               /* The input stream for tokens  */
     bool stringInputFlag;            /* Flag indicating string input */
+    size_t bufferPos;                /* Read position in the buffer  */
+    size_t tokenStart;               /* Buffer position of the token */
+    std::string streamToken;         /* Token text for stream input  */
     bool ignoreWhitespaceFlag;       /* Scanner ignores whitespace   */
     bool ignoreCommentsFlag;         /* Scanner ignores comments     */
     bool scanNumbersFlag;            /* Scanner parses numbers       */
     bool scanStringsFlag;            /* Scanner parses strings       */
     std::string wordChars;           /* Additional word characters   */
-    StringCell* savedTokens;         /* Stack of saved tokens        */
-    StringCell* operators;           /* List of multichar operators  */
+    std::vector<std::string> savedTokens;  /* Stack of saved tokens  */
+    std::vector<OperatorNode> operators;   /* Trie of operators      */
+    unsigned char charClasses[256];  /* CharacterClass bits per char */
 
     /* Private method prototypes */
     void initScanner();
-    bool isOperator(const std::string& op);
-    bool isOperatorPrefix(const std::string& op);
-    std::string scanNumber();
-    std::string scanString();
-    std::string scanWord();
+    int findOperatorChild(int node, int ch) const;
+    bool isDigitClass(int ch) const;
+    bool isSpaceClass(int ch) const;
+    bool isWordClass(int ch) const;
+    int readChar();
+    void scanNextToken();
+    void scanNumber();
+    void scanOperator(int ch);
+    void scanString();
+    void scanWord();
     void skipSpaces();
+    void unreadChar();
 
     friend std::ostream& operator <<(std::ostream& out, const TokenScanner& scanner);
 };
@@ -0,0 +1,360 @@
+/*
+ * File: bitstreambuf.h
+ * --------------------
+ * This file defines the <code>BitStreambuf</code> class, which represents
+ * a buffered stream buffer that wraps another stream buffer and adds
+ * support for reading and writing several bits at a time.
+ * We use this to implement ibitstream and obitstream.
+ *
+ * @version 2026/10/17
+ * - initial version
+ * - a seek that returns to the position of an unfinished byte resumes it,
+ *   and so does a flush
+ */
+
+#ifndef _bitstreambuf_h
+#define _bitstreambuf_h
+
+#include <iostream>
+#include <stdint.h>
+#include <streambuf>
+#include <vector>
+
+namespace stanfordcpplib {
+
+/*
+ * A stream buffer that keeps a large block of bytes from (or for) its source
+ * stream buffer in memory, along with a 64-bit accumulator of bits.
+ * Bits are packed least significant bit first within each byte, and the
+ * source is only touched when the block must be refilled or flushed.
+ *
+ * Byte-level reads and writes made by the stream between bit operations go
+ * through the same block, so the two kinds of operations interleave the way
+ * they always have: a byte operation abandons the rest of a partially read
+ * byte, or ends a partially written byte (padding it with 0 bits).
+ *
+ * Seeking empties the block, but the unfinished byte is remembered along
+ * with its position, and a later seek straight back to that position picks
+ * it up again.  This lets size() seek to the end and back in mid-byte.
+ * Flushing in mid-byte writes the unfinished byte out but keeps it open,
+ * so later bits still go into the same byte.
+ */
+class BitStreambuf : public std::streambuf {
+public:
+    static const int BUFFER_SIZE = 64 * 1024;
+
+    BitStreambuf(std::ios_base::openmode mode)
+            : m_source(nullptr),
+              m_mode(mode),
+              m_buffer(BUFFER_SIZE),
+              m_bits(0),
+              m_bitCount(0),
+              m_bitEnd(nullptr),
+              m_generation(0),
+              m_bitGeneration(0),
+              m_savedBits(0),
+              m_savedBitCount(0),
+              m_savedPos(std::streamoff(-1)),
+              m_savedGeneration(0) {
+        reset();
+    }
+
+    virtual ~BitStreambuf() {
+        // empty; the owning stream flushes us while the source is still alive
+    }
+
+    /*
+     * Attaches this buffer to the given source, discarding any buffered data.
+     */
+    void setSource(std::streambuf* source) {
+        m_source = source;
+        reset();
+        m_savedBitCount = 0;
+    }
+
+    std::streambuf* source() const {
+        return m_source;
+    }
+
+    /*
+     * Reads the next n bits (0 <= n <= 64); the first bit read is the least
+     * significant bit of the result.  Returns false if the source runs out
+     * before n bits are read; the bits that were there are kept, so that
+     * shorter reads can still return them.
+     */
+    bool readBits(int n, uint64_t& value) {
+        m_savedBitCount = 0;   // the bits have moved on since any earlier seek
+        if (n > 56) {
+            // the accumulator can only absorb whole bytes up to 64 bits
+            uint64_t low;
+            uint64_t high;
+            if (!readBits(32, low)) {
+                return false;
+            }
+            if (!readBits(n - 32, high)) {
+                // fewer than n - 32 bits are left, so the low 32 fit back in front
+                m_bits = low | (m_bits << 32);
+                m_bitCount += 32;
+                return false;
+            }
+            value = low | (high << 32);
+            return true;
+        }
+        if (!bitsAreCurrent()) {
+            m_bits = 0;
+            m_bitCount = 0;
+        }
+        while (m_bitCount < n) {
+            int ch = sbumpc();
+            if (ch == EOF) {
+                markBits(gptr());
+                return false;
+            }
+            m_bits |= (uint64_t) (unsigned char) ch << m_bitCount;
+            m_bitCount += 8;
+        }
+        value = n == 64 ? m_bits : (m_bits & (((uint64_t) 1 << n) - 1));
+        m_bits = n == 64 ? 0 : (m_bits >> n);
+        m_bitCount -= n;
+        markBits(gptr());
+        return true;
+    }
+
+    /*
+     * Writes the low n bits of value (0 <= n <= 64), least significant first.
+     * A partially filled final byte is stored in the buffer right away
+     * (so byte-level writes and flushes see it) and is rewritten in place
+     * as more bits are added to it.
+     */
+    void writeBits(uint64_t value, int n) {
+        m_savedBitCount = 0;   // the bits have moved on since any earlier seek
+        if (n > 56) {
+            writeBits(value & 0xffffffffu, 32);
+            writeBits(value >> 32, n - 32);
+            return;
+        }
+        if (m_bitCount > 0) {
+            if (bitsAreCurrent()) {
+                pbump(-1);   // take back the partial byte so it can be finished
+            } else {
+                m_bits = 0;
+                m_bitCount = 0;
+            }
+        }
+        if (n < 64) {
+            value &= ((uint64_t) 1 << n) - 1;
+        }
+        m_bits |= value << m_bitCount;
+        m_bitCount += n;
+        while (m_bitCount >= 8) {
+            sputc((char) (m_bits & 0xff));
+            m_bits >>= 8;
+            m_bitCount -= 8;
+        }
+        if (m_bitCount > 0) {
+            sputc((char) (m_bits & 0xff));
+        }
+        markBits(pptr());
+    }
+
+protected:
+    /*
+     * Refills the block from the source when the stream runs out of bytes.
+     */
+    virtual int underflow() {
+        if (gptr() < egptr()) {
+            return (unsigned char) *gptr();
+        }
+        if (!m_source) {
+            return EOF;
+        }
+        std::streamsize n = m_source->sgetn(&m_buffer[0], BUFFER_SIZE);
+        if (n <= 0) {
+            // nothing was read, so leave the block and any partial byte alone
+            return EOF;
+        }
+        m_generation++;
+        setg(&m_buffer[0], &m_buffer[0], &m_buffer[0] + n);
+        return (unsigned char) *gptr();
+    }
+
+    /*
+     * Writes the block out to the source when the stream fills it up.
+     */
+    virtual int overflow(int ch = EOF) {
+        if (!flushBuffer()) {
+            return EOF;
+        }
+        if (ch != EOF) {
+            *pptr() = (char) ch;
+            pbump(1);
+            return ch;
+        }
+        return 0;
+    }
+
+    virtual int sync() {
+        if (!(m_mode & std::ios_base::out)) {
+            return 0;
+        }
+        bool partial = m_bitCount > 0 && bitsAreCurrent();
+        if (!flushBuffer()) {
+            return -1;
+        }
+        int result = m_source ? m_source->pubsync() : 0;
+        if (partial && m_source->pubseekoff(-1, std::ios_base::cur, std::ios_base::out)
+                != std::streampos(std::streamoff(-1))) {
+            // the partial byte has been written out; back up over it and keep
+            // it in the block so that writeBits can still finish it
+            sputc((char) (m_bits & 0xff));
+            markBits(pptr());
+        }
+        return result;
+    }
+
+    virtual std::streamsize showmanyc() {
+        return m_source ? m_source->in_avail() : -1;
+    }
+
+    virtual std::streampos seekoff(std::streamoff off, std::ios_base::seekdir way,
+                                   std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) {
+        if (!m_source) {
+            return std::streampos(std::streamoff(-1));
+        }
+        if (off == 0 && way == std::ios_base::cur) {
+            // just asking for the position (tellg/tellp); keep the block
+            return position(which);
+        }
+        saveBits(which);
+        if (m_mode & std::ios_base::in) {
+            if (way == std::ios_base::cur) {
+                // the source is ahead of us by the bytes still in the block
+                off -= egptr() - gptr();
+            }
+        } else if (!flushBuffer()) {
+            return std::streampos(std::streamoff(-1));
+        }
+        std::streampos result = m_source->pubseekoff(off, way, which);
+        reset();
+        restoreBits(result, which);
+        return result;
+    }
+
+    virtual std::streampos seekpos(std::streampos pos,
+                                   std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) {
+        if (!m_source) {
+            return std::streampos(std::streamoff(-1));
+        }
+        saveBits(which);
+        if (!(m_mode & std::ios_base::in) && !flushBuffer()) {
+            return std::streampos(std::streamoff(-1));
+        }
+        std::streampos result = m_source->pubseekpos(pos, which);
+        reset();
+        restoreBits(result, which);
+        return result;
+    }
+
+private:
+    // true if no byte-level operation or refill has happened since the last bit operation
+    bool bitsAreCurrent() const {
+        char* pos = (m_mode & std::ios_base::in) ? gptr() : pptr();
+        return pos == m_bitEnd && m_generation == m_bitGeneration;
+    }
+
+    // writes the bytes in the block to the source and empties the block
+    bool flushBuffer() {
+        std::streamsize n = pptr() - pbase();
+        if (n > 0 && (!m_source || m_source->sputn(pbase(), n) != n)) {
+            return false;
+        }
+        setp(&m_buffer[0], &m_buffer[0] + BUFFER_SIZE);
+        m_generation++;
+        return true;
+    }
+
+    void markBits(char* pos) {
+        m_bitEnd = pos;
+        m_bitGeneration = m_generation;
+    }
+
+    // the stream's position: the source's position, less the bytes read
+    // ahead into the block or plus the bytes not yet written out of it
+    std::streampos position(std::ios_base::openmode which) {
+        std::streampos pos = m_source->pubseekoff(0, std::ios_base::cur, which);
+        if (pos == std::streampos(std::streamoff(-1))) {
+            return pos;
+        } else if (m_mode & std::ios_base::in) {
+            return pos - (egptr() - gptr());
+        } else {
+            return pos + (pptr() - pbase());
+        }
+    }
+
+    // before a seek: remembers an unfinished byte and where it is.  A byte
+    // remembered at an earlier seek is kept only if nothing has been read
+    // or written since, so that seeking away and then back still finds it.
+    void saveBits(std::ios_base::openmode which) {
+        if (m_bitCount > 0 && bitsAreCurrent()) {
+            m_savedPos = position(which);
+            m_savedBits = m_bits;
+            m_savedBitCount = m_bitCount;
+        } else if (m_generation != m_savedGeneration
+                   || gptr() != egptr() || pptr() != pbase()) {
+            m_savedBitCount = 0;
+        }
+    }
+
+    // after a seek: if it landed where the remembered byte was, resumes it
+    void restoreBits(std::streampos pos, std::ios_base::openmode which) {
+        m_savedGeneration = m_generation;
+        if (m_savedBitCount == 0 || pos == std::streampos(std::streamoff(-1))
+                || pos != m_savedPos) {
+            return;
+        }
+        if (!(m_mode & std::ios_base::in)) {
+            // the byte has been flushed to the source; back up over it and
+            // put it in the block again so that writeBits can finish it
+            if (m_source->pubseekpos(pos - std::streamoff(1), which)
+                    == std::streampos(std::streamoff(-1))) {
+                return;
+            }
+            sputc((char) (m_savedBits & 0xff));
+        }
+        m_bits = m_savedBits;
+        m_bitCount = m_savedBitCount;
+        markBits((m_mode & std::ios_base::in) ? gptr() : pptr());
+    }
+
+    // empties the block and forgets any partial byte
+    void reset() {
+        if (m_mode & std::ios_base::in) {
+            setg(&m_buffer[0], &m_buffer[0], &m_buffer[0]);
+            setp(nullptr, nullptr);
+        } else {
+            setg(nullptr, nullptr, nullptr);
+            setp(&m_buffer[0], &m_buffer[0] + BUFFER_SIZE);
+        }
+        m_bits = 0;
+        m_bitCount = 0;
+        m_bitEnd = nullptr;
+        m_generation++;
+    }
+
+    std::streambuf* m_source;      // underlying file or string buffer
+    std::ios_base::openmode m_mode; // in for ibitstream, out for obitstream
+    std::vector<char> m_buffer;    // block of bytes read ahead / not yet written
+    uint64_t m_bits;               // accumulator of bits not yet returned/completed
+    int m_bitCount;                // number of valid bits in m_bits
+    char* m_bitEnd;                // buffer position just after the last bit operation
+    unsigned int m_generation;     // bumped whenever the block is refilled/flushed/reset
+    unsigned int m_bitGeneration;  // value of m_generation at the last bit operation
+    uint64_t m_savedBits;          // unfinished byte's bits as of the last seek
+    int m_savedBitCount;           // number of bits in m_savedBits; 0 if none
+    std::streampos m_savedPos;     // stream position just after the unfinished byte
+    unsigned int m_savedGeneration; // value of m_generation right after the last seek
+};
+
+} // namespace stanfordcpplib
+
+#endif // _bitstreambuf_h
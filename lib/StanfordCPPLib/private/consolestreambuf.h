@@ -5,6 +5,11 @@
  * represents a stream buffer that reads/writes to the Stanford graphical console
  * using a process pipe to a Java back-end process.
  *
+ * @version 2026/10/17
+ * - send all buffered text in one putConsole call per flush, with embedded
+ *   newlines, instead of one putConsole plus one endLineConsole per line
+ * - buffer stderr text separately so that it is not sent one character
+ *   at a time, and so that buffered stdout text is not sent as stderr
  * @version 2016/10/04
  * - initial version
  */
@@ -14,10 +19,10 @@
 
 #include <iostream>
 #include <streambuf>
+#include <string>
 
 namespace stanfordcpplib {
 
-extern void endLineConsole(bool isStderr);
 extern std::string getLineConsole();
 extern void putConsole(const std::string& str, bool isStderr);
 
@@ -29,8 +34,29 @@ private:
     /* Instance variables */
     char inBuffer[BUFFER_SIZE];
     char outBuffer[BUFFER_SIZE];
+    std::string errBuffer;   // stderr text not yet sent; cerr has no buffer of its own
     int blocked;
 
+    /*
+     * Sends the buffered stdout text to the console as a single command.
+     */
+    void flushOutput() {
+        if (pptr() > pbase()) {
+            putConsole(std::string(pbase(), pptr()), /* isStderr */ false);
+        }
+        setp(outBuffer, outBuffer + BUFFER_SIZE);
+    }
+
+    /*
+     * Sends the buffered stderr text to the console as a single command.
+     */
+    void flushError() {
+        if (!errBuffer.empty()) {
+            putConsole(errBuffer, /* isStderr */ true);
+            errBuffer.clear();
+        }
+    }
+
 public:
     ConsoleStreambuf() {
         setg(inBuffer, inBuffer, inBuffer);
@@ -50,24 +76,27 @@ public:
         return overflow(ch, /* isStderr */ false);
     }
 
+    /*
+     * Stdout text collects in outBuffer and stderr text (which arrives here
+     * one character at a time from the ForwardingStreambuf) in errBuffer.
+     * Either one is sent as a single print command, newlines and all, when
+     * its stream is flushed or when output switches to the other stream.
+     */
     virtual int overflow(int ch, bool isStderr) {
-        std::string line = "";
-        for (char *cp = pbase(); cp < pptr(); cp++) {
-            if (*cp == '\n') {
-                putConsole(line, isStderr);
-                endLineConsole(isStderr);
-                line = "";
+        if (isStderr) {
+            flushOutput();
+            if (ch != EOF) {
+                errBuffer += char(ch);
             } else {
-                line += *cp;
+                flushError();
+            }
+        } else {
+            flushError();
+            flushOutput();
+            if (ch != EOF) {
+                outBuffer[0] = char(ch);
+                pbump(1);
             }
-        }
-        if (line != "") {
-            putConsole(line, isStderr);
-        }
-        setp(outBuffer, outBuffer + BUFFER_SIZE);
-        if (ch != EOF) {
-            outBuffer[0] = ch;
-            pbump(1);
         }
         return ch != EOF;
     }
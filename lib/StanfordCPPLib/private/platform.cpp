@@ -4,6 +4,12 @@
  * This file implements the platform interface by passing commands to
  * a Java back end that manages the display.
  * 
+ * @version 2026/10/17
+ * - count the commands sent to the back end so that gwindow_repaint can
+ *   skip repainting a window when nothing has been sent since its last repaint
+ * - GTimers run in a native timer wheel; timer events are put straight into
+ *   the event queue instead of coming from the back end
+ * - pipe reads and writes are recorded as "pipe" trace spans (see trace.h)
  * @version 2017/10/12
  * - added gtextlabel_create
  * - added gwindow_setRepaintImmediately
@@ -148,6 +154,9 @@ static int& pout(bool check = true) {
 #include "platform.h"
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -158,10 +167,12 @@ static int& pout(bool check = true) {
 #include <signal.h>
 #include <sstream>
 #include <string>
+#include <time.h>
 #include <vector>
 #include "private/consolestreambuf.h"
 #include "private/forwardingstreambuf.h"
 #include "private/static.h"
+#include "private/timerwheel.h"
 #include "private/version.h"
 #include "base64.h"
 
@@ -181,6 +192,7 @@ static int& pout(bool check = true) {
 #include "stack.h"
 #include "strlib.h"
 #include "tokenscanner.h"
+#include "trace.h"
 #include "vector.h"
 
 // internal flag to emit a dump of every message sent to the Java back-end;
@@ -190,12 +202,18 @@ static int& pout(bool check = true) {
 // related: similar constant in Java back-end stanford.spl.SplPipeDecoder.java
 STATIC_CONST_VARIABLE_DECLARE(size_t, PIPE_MAX_COMMAND_LENGTH, 2048)
 
+// while a timer is running, waitForEvent can't block in the back end, so it
+// checks the back end for other events this often (in milliseconds)
+STATIC_CONST_VARIABLE_DECLARE(double, TIMER_POLL_INTERVAL, 10.0)
+
 /* Private data */
 STATIC_VARIABLE_DECLARE_COLLECTION_EMPTY(Queue<GEvent>, eventQueue)
-STATIC_VARIABLE_DECLARE_MAP_EMPTY(HashMap, std::string, GTimerData*, timerTable)
+STATIC_VARIABLE_DECLARE_BLANK(stanfordcpplib::TimerWheel, timerWheel)
+STATIC_VARIABLE_DECLARE(std::chrono::steady_clock::time_point, timerClockStart, std::chrono::steady_clock::now())
 STATIC_VARIABLE_DECLARE_MAP_EMPTY(HashMap, std::string, GWindowData*, windowTable)
 STATIC_VARIABLE_DECLARE_MAP_EMPTY(HashMap, std::string, GObject*, sourceTable)
 STATIC_VARIABLE_DECLARE(stanfordcpplib::ConsoleStreambuf*, cinout_new_buf, nullptr)
+STATIC_VARIABLE_DECLARE(std::uint64_t, pipeCommandCount, 0)
 
 #ifdef _WIN32
 STATIC_VARIABLE_DECLARE(HANDLE, rdFromJBE, nullptr)
@@ -215,6 +233,7 @@ static std::string getResult(bool consumeAcks = true, bool stopOnEvent = false,
                              const std::string& caller = "");
 static std::string getSplJarPath();
 static void getStatus();
+static double getTimerClock();
 static void initPipe();
 static GEvent parseActionEvent(TokenScanner& scanner, EventType type);
 static GEvent parseEvent(const std::string& line);
@@ -222,8 +241,8 @@ static GEvent parseKeyEvent(TokenScanner& scanner, EventType type);
 static GEvent parseMouseEvent(TokenScanner& scanner, EventType type);
 static GEvent parseServerEvent(TokenScanner& scanner, EventType type);
 static GEvent parseTableEvent(TokenScanner& scanner, EventType type);
-static GEvent parseTimerEvent(TokenScanner& scanner, EventType type);
 static GEvent parseWindowEvent(TokenScanner& scanner, EventType type);
+static void pollTimers();
 static std::string& programName();
 static void putPipe(const std::string& line);
 static void putPipeLongString(const std::string& line);
@@ -233,6 +252,7 @@ static double scanDouble(TokenScanner& scanner);
 static int scanInt(TokenScanner& scanner);
 static Point scanPoint(const std::string& str);
 static GRectangle scanRectangle(const std::string& str);
+static void sleepForTimers(double maxMilliseconds);
 
 
 /* Implementation of the Platform class */
@@ -743,9 +763,15 @@ void Platform::gwindow_clearCanvas(const GWindow& gw) {
 }
 
 void Platform::gwindow_repaint(const GWindow& gw) {
+    // every change to what the window shows is a command, so if none has been
+    // sent since this window's last repaint, the canvas is already up to date
+    if (gw.gwd->repaintCommandCount == STATIC_VARIABLE(pipeCommandCount)) {
+        return;
+    }
     std::ostringstream os;
     os << "GWindow.repaint(\"" << gw.gwd << "\")";
     putPipe(os.str());
+    gw.gwd->repaintCommandCount = STATIC_VARIABLE(pipeCommandCount);
 }
 
 void Platform::gwindow_saveCanvasPixels(const GWindow& gw, const std::string& filename) {
@@ -870,35 +896,40 @@ void Platform::gtimer_pause(double milliseconds) {
 }
 
 void Platform::gtimer_constructor(const GTimer& timer, double delay) {
-    std::ostringstream os;
-    os << timer.gtd;
-    std::string id = os.str();
-    STATIC_VARIABLE(timerTable).put(id, timer.gtd);
-    os.str("");
-    os << "GTimer.create(\"" << id << "\", " << delay << ")";
-    putPipe(os.str());
+    timer.gtd->delay = delay;
+    timer.gtd->deadline = 0;
 }
 
 void Platform::gtimer_delete(const GTimer& timer) {
-    std::ostringstream os;
-    os << timer.gtd;
-    std::string id = os.str();
-    STATIC_VARIABLE(timerTable).remove(id);
-    os.str("");
-    os << "GTimer.deleteTimer(\"" << id << "\")";
-    putPipe(os.str());
+    gtimer_stop(timer);
 }
 
 void Platform::gtimer_start(const GTimer& timer) {
-    std::ostringstream os;
-    os << "GTimer.startTimer(\"" << timer.gtd << "\")";
-    putPipe(os.str());
+    GTimerData* gtd = timer.gtd;
+    if (stanfordcpplib::TimerWheel::isScheduled(gtd)) {
+        return;   // already running
+    }
+    gtd->refCount++;   // held by the wheel until the timer is stopped
+    gtd->deadline = getTimerClock() + gtd->delay;
+    STATIC_VARIABLE(timerWheel).schedule(gtd, (stanfordcpplib::TimerWheel::Tick) std::ceil(gtd->deadline));
 }
 
 void Platform::gtimer_stop(const GTimer& timer) {
-    std::ostringstream os;
-    os << "GTimer.stopTimer(\"" << timer.gtd << "\")";
-    putPipe(os.str());
+    GTimerData* gtd = timer.gtd;
+    if (stanfordcpplib::TimerWheel::isScheduled(gtd)) {
+        STATIC_VARIABLE(timerWheel).cancel(gtd);
+        gtd->refCount--;   // the caller still holds a reference
+
+        // drop the events this timer has already queued; they don't hold a
+        // reference, so they could outlive the timer once it is stopped
+        Queue<GEvent>& queue = STATIC_VARIABLE(eventQueue);
+        for (int i = queue.size(); i > 0; i--) {
+            GEvent event = queue.dequeue();
+            if (event.getEventClass() != TIMER_EVENT || GTimerEvent(event).getGTimer() != timer) {
+                queue.enqueue(event);
+            }
+        }
+    }
 }
 
 void Platform::httpserver_sendResponse(int requestID, int httpErrorCode, const std::string& contentType, const std::string& responseText) {
@@ -2116,9 +2147,16 @@ GDimension Platform::glabel_getSize(const GObject* gobj) {
 }
 
 GEvent Platform::gevent_getNextEvent(int mask) {
+    if (mask & TIMER_EVENT) {
+        pollTimers();
+    }
     if (STATIC_VARIABLE(eventQueue).isEmpty()) {
-        putPipe("GEvent.getNextEvent(" + integerToString(mask) + ")");
-        getResult(/* consumeAcks */ true, /* stopOnEvent */ true);
+        // timer events never come from the back end, so a timer-only
+        // request doesn't need it (and works without one)
+        if (mask & ~TIMER_EVENT) {
+            putPipe("GEvent.getNextEvent(" + integerToString(mask) + ")");
+            getResult(/* consumeAcks */ true, /* stopOnEvent */ true);
+        }
         if (STATIC_VARIABLE(eventQueue).isEmpty()) {
             return GEvent();
         }
@@ -2127,12 +2165,34 @@ GEvent Platform::gevent_getNextEvent(int mask) {
 }
 
 GEvent Platform::gevent_waitForEvent(int mask) {
-    while (STATIC_VARIABLE(eventQueue).isEmpty()) {
-        putPipe("GEvent.waitForEvent(" + integerToString(mask) + ")");
+    bool wantsTimers = (mask & TIMER_EVENT) != 0;
+    while (true) {
+        if (wantsTimers) {
+            pollTimers();
+        }
+        if (!STATIC_VARIABLE(eventQueue).isEmpty()) {
+            break;
+        }
+        if (wantsTimers && STATIC_VARIABLE(timerWheel).size() > 0) {
+            // a timer is running, so don't block in the back end; check it for
+            // anything already waiting, then sleep until the next timer is due
+            if (mask & ~TIMER_EVENT) {
+                putPipe("GEvent.getNextEvent(" + integerToString(mask) + ")");
+                getResult(/* consumeAcks */ true, /* stopOnEvent */ true);
+                if (!STATIC_VARIABLE(eventQueue).isEmpty()) {
+                    break;
+                }
+                sleepForTimers(STATIC_VARIABLE(TIMER_POLL_INTERVAL));
+            } else {
+                sleepForTimers(-1);
+            }
+        } else {
+            putPipe("GEvent.waitForEvent(" + integerToString(mask) + ")");
 
-        // BUGBUG: Marty changing to consume ACKs because it was skipping an
-        // event on mouse click before
-        getResult(/* consumeAcks */ true, /* stopOnEvent */ true);
+            // BUGBUG: Marty changing to consume ACKs because it was skipping an
+            // event on mouse click before
+            getResult(/* consumeAcks */ true, /* stopOnEvent */ true);
+        }
     }
 
     GEvent event = STATIC_VARIABLE(eventQueue).dequeue();
@@ -2709,6 +2769,8 @@ static void putPipe(const std::string& line) {
         putPipeLongString(line);
         return;
     }
+    TRACE_SPAN("pipe", "putPipe");
+    STATIC_VARIABLE(pipeCommandCount)++;
     
     DWORD nch;
 #ifdef PIPE_DEBUG
@@ -2859,6 +2921,8 @@ static void putPipe(const std::string& line) {
         putPipeLongString(line);
         return;
     }
+    TRACE_SPAN("pipe", "putPipe");
+    STATIC_VARIABLE(pipeCommandCount)++;
 #ifdef PIPE_DEBUG
     fprintf(stderr, "putPipe(\"%s\")\n", line.c_str());  fflush(stderr);
 #endif
@@ -2897,6 +2961,7 @@ static std::string getPipe() {
 
 static std::string getResult(bool consumeAcks, bool stopOnEvent,
                              const std::string& caller) {
+    TRACE_SPAN("pipe", "getResult");
     while (true) {
 #ifdef PIPE_DEBUG
         fprintf(stderr, "getResult(consumeAcks=%s, stopOnEvent=%s, caller=%s)\n",
@@ -3090,6 +3155,17 @@ static void getStatus() {
     }
 }
 
+/*
+ * Returns the number of milliseconds since the timer clock started.
+ * This is a steady clock, so timers aren't disturbed when the wall-clock
+ * time changes; one timer wheel tick is one millisecond of it.
+ */
+static double getTimerClock() {
+    std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - STATIC_VARIABLE(timerClockStart);
+    return elapsed.count();
+}
+
 static std::string& programName() {
     static std::string __programName;
     return __programName;
@@ -3135,8 +3211,6 @@ static GEvent parseEvent(const std::string& line) {
         return parseTableEvent(scanner, TABLE_SELECTED);
     } else if (name == "tableUpdated") {
         return parseTableEvent(scanner, TABLE_UPDATED);
-    } else if (name == "timerTicked") {
-        return parseTimerEvent(scanner, TIMER_TICKED);
     } else if (name == "windowClosing") {
         return parseWindowEvent(scanner, WINDOW_CLOSING);
     } else if (name == "windowClosed") {
@@ -3263,17 +3337,6 @@ static GEvent parseTableEvent(TokenScanner& scanner, EventType type) {
     return e;
 }
 
-static GEvent parseTimerEvent(TokenScanner& scanner, EventType type) {
-    scanner.verifyToken("(");
-    std::string id = scanner.getStringValue(scanner.nextToken());
-    scanner.verifyToken(",");
-    double time = scanDouble(scanner);
-    scanner.verifyToken(")");
-    GTimerEvent e(type, GTimer(STATIC_VARIABLE(timerTable).get(id)));
-    e.setEventTime(time);
-    return e;
-}
-
 static GEvent parseWindowEvent(TokenScanner& scanner, EventType type) {
     scanner.verifyToken("(");
     std::string id = scanner.getStringValue(scanner.nextToken());
@@ -3285,6 +3348,40 @@ static GEvent parseWindowEvent(TokenScanner& scanner, EventType type) {
     return e;
 }
 
+/*
+ * Puts a GTimerEvent in the event queue for each running timer that has come
+ * due and schedules its next event.  The next deadline is measured from the
+ * previous one so that periodic timers don't drift; a timer that has fallen
+ * a whole period behind skips the events it missed, like a Java Swing timer.
+ */
+static void pollTimers() {
+    stanfordcpplib::TimerWheel& wheel = STATIC_VARIABLE(timerWheel);
+    if (wheel.size() == 0) {
+        return;
+    }
+    double now = getTimerClock();
+    std::vector<stanfordcpplib::TimerEntry*> expired;
+    wheel.advance((stanfordcpplib::TimerWheel::Tick) now, expired);
+    if (expired.empty()) {
+        return;
+    }
+
+    std::chrono::duration<double, std::milli> eventTime =
+            std::chrono::system_clock::now().time_since_epoch();
+    for (stanfordcpplib::TimerEntry* entry : expired) {
+        GTimerData* gtd = static_cast<GTimerData*>(entry);
+        GTimerEvent e(TIMER_TICKED, GTimer(gtd));
+        e.setEventTime(eventTime.count());
+        STATIC_VARIABLE(eventQueue).enqueue(e);
+
+        gtd->deadline += gtd->delay;
+        if (gtd->deadline <= now) {
+            gtd->deadline = now + gtd->delay;
+        }
+        wheel.schedule(gtd, (stanfordcpplib::TimerWheel::Tick) std::ceil(gtd->deadline));
+    }
+}
+
 static GEvent parseActionEvent(TokenScanner& scanner, EventType type) {
     scanner.verifyToken("(");
     std::string id = scanner.getStringValue(scanner.nextToken());
@@ -3370,6 +3467,29 @@ static GRectangle scanRectangle(const std::string& str) {
     return GRectangle(x, y, width, height);
 }
 
+/*
+ * Sleeps until the next running timer is due, but for no longer than the
+ * given number of milliseconds (if it is not negative).
+ */
+static void sleepForTimers(double maxMilliseconds) {
+    stanfordcpplib::TimerWheel::Tick next = STATIC_VARIABLE(timerWheel).getNextExpiry();
+    double delay = (double) next - getTimerClock();
+    if (maxMilliseconds >= 0 && delay > maxMilliseconds) {
+        delay = maxMilliseconds;
+    }
+    if (delay <= 0) {
+        return;
+    }
+#ifdef _WIN32
+    Sleep((DWORD) std::ceil(delay));
+#else // _WIN32
+    struct timespec duration;
+    duration.tv_sec = (time_t) (delay / 1000);
+    duration.tv_nsec = (long) ((delay - duration.tv_sec * 1000.0) * 1000000);
+    nanosleep(&duration, nullptr);
+#endif // _WIN32
+}
+
 namespace stanfordcpplib {
 std::string getLineConsole() {
     putPipe("JBEConsole.getLine()");
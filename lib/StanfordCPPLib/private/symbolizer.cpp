@@ -0,0 +1,586 @@
+/*
+ * File: symbolizer.cpp
+ * --------------------
+ * This file implements the symbolizer.h interface.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include "private/symbolizer.h"
+
+#if defined(__linux__)
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <dlfcn.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "private/static.h"
+
+namespace stanfordcpplib {
+
+namespace {
+
+// the file index of the row that ends a sequence of rows
+const unsigned int END_OF_SEQUENCE = ~0u;
+
+struct LineRow {
+    std::uint64_t address;   // link-time address, before relocation
+    unsigned int file;            // index into LineTable::files
+    unsigned int line;
+};
+
+/*
+ * The rows of every line program in one module, sorted by address, along
+ * with the base names of the source files they refer to.  A lookup finds the
+ * last row at or before an address; if that row ends a sequence, the address
+ * is not covered.
+ */
+struct LineTable {
+    std::string path;
+    std::uint64_t bias;      // load address minus link-time address
+    std::vector<LineRow> rows;
+    std::vector<std::string> files;
+    std::map<std::string, unsigned int> fileIndexes;
+
+    unsigned int addFile(const std::string& name) {
+        std::map<std::string, unsigned int>::const_iterator it = fileIndexes.find(name);
+        if (it != fileIndexes.end()) {
+            return it->second;
+        }
+        unsigned int index = (unsigned int) files.size();
+        files.push_back(name);
+        fileIndexes[name] = index;
+        return index;
+    }
+};
+
+/*
+ * Reads little-endian values from a block of bytes.  Reading past the end
+ * yields zeros and clears the ok flag, so a damaged section cannot crash the
+ * program that is trying to print a stack trace.
+ */
+struct ByteReader {
+    const unsigned char* pos;
+    const unsigned char* end;
+    bool ok;
+
+    ByteReader(const unsigned char* start, const unsigned char* end)
+            : pos(start), end(end), ok(true) {
+        // empty
+    }
+
+    bool atEnd() const {
+        return pos >= end;
+    }
+
+    bool canRead(std::uint64_t count) {
+        if (!ok || count > (std::uint64_t) (end - pos)) {
+            ok = false;
+            pos = end;
+            return false;
+        }
+        return true;
+    }
+
+    void skip(std::uint64_t count) {
+        if (canRead(count)) {
+            pos += count;
+        }
+    }
+
+    std::uint64_t fixed(int size) {
+        std::uint64_t value = 0;
+        if (canRead(size)) {
+            for (int i = size - 1; i >= 0; i--) {
+                value = (value << 8) | pos[i];
+            }
+            pos += size;
+        }
+        return value;
+    }
+
+    unsigned int u8() {
+        return (unsigned int) fixed(1);
+    }
+
+    std::uint64_t uleb() {
+        std::uint64_t value = 0;
+        for (int shift = 0; canRead(1); shift += 7) {
+            unsigned char byte = *pos++;
+            if (shift < 64) {
+                value |= (std::uint64_t) (byte & 0x7f) << shift;
+            }
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        return value;
+    }
+
+    std::int64_t sleb() {
+        std::uint64_t value = 0;
+        int shift = 0;
+        unsigned char byte = 0;
+        while (canRead(1)) {
+            byte = *pos++;
+            if (shift < 64) {
+                value |= (std::uint64_t) (byte & 0x7f) << shift;
+            }
+            shift += 7;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        if (shift < 64 && (byte & 0x40)) {
+            value |= ~(std::uint64_t) 0 << shift;
+        }
+        return (std::int64_t) value;
+    }
+
+    const char* cstr() {
+        const unsigned char* start = pos;
+        const void* nul = canRead(1) ? memchr(pos, 0, end - pos) : nullptr;
+        if (!nul) {
+            ok = false;
+            pos = end;
+            return "";
+        }
+        pos = static_cast<const unsigned char*>(nul) + 1;
+        return reinterpret_cast<const char*>(start);
+    }
+};
+
+struct Section {
+    const unsigned char* data;
+    std::uint64_t size;
+
+    Section() : data(nullptr), size(0) {
+        // empty
+    }
+};
+
+struct DebugSections {
+    Section line;
+    Section lineStr;     // .debug_line_str, for DWARF 5 file names
+    Section str;         // .debug_str
+};
+
+std::string baseName(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+std::string stringAt(const Section& section, std::uint64_t offset) {
+    if (!section.data || offset >= section.size) {
+        return "";
+    }
+    const char* start = reinterpret_cast<const char*>(section.data + offset);
+    const void* nul = memchr(start, 0, section.size - offset);
+    return nul ? std::string(start, static_cast<const char*>(nul) - start) : "";
+}
+
+/*
+ * Reads one attribute of a DWARF 5 directory or file name entry.  Strings
+ * are returned through str; other values are skipped.  Returns false for
+ * forms that cannot appear here or cannot be resolved from the line table
+ * alone, in which case the rest of the unit cannot be parsed.
+ */
+bool readEntryForm(ByteReader& in, std::uint64_t form, bool dwarf64,
+                   const DebugSections& sections, std::string& str) {
+    switch (form) {
+    case 0x08:   // DW_FORM_string
+        str = in.cstr();
+        return true;
+    case 0x0e:   // DW_FORM_strp
+        str = stringAt(sections.str, in.fixed(dwarf64 ? 8 : 4));
+        return true;
+    case 0x1f:   // DW_FORM_line_strp
+        str = stringAt(sections.lineStr, in.fixed(dwarf64 ? 8 : 4));
+        return true;
+    case 0x0b:   // DW_FORM_data1
+        in.skip(1);
+        return true;
+    case 0x05:   // DW_FORM_data2
+        in.skip(2);
+        return true;
+    case 0x06:   // DW_FORM_data4
+        in.skip(4);
+        return true;
+    case 0x07:   // DW_FORM_data8
+        in.skip(8);
+        return true;
+    case 0x1e:   // DW_FORM_data16
+        in.skip(16);
+        return true;
+    case 0x0f:   // DW_FORM_udata
+        in.uleb();
+        return true;
+    case 0x09:   // DW_FORM_block
+        in.skip(in.uleb());
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+ * Reads a DWARF 5 directory or file name table, appending the base name of
+ * each entry's path to names.
+ */
+bool readEntryTable(ByteReader& in, bool dwarf64, const DebugSections& sections,
+                    std::vector<std::string>& names) {
+    std::vector<std::uint64_t> contentTypes;
+    std::vector<std::uint64_t> forms;
+    for (unsigned int count = in.u8(); count > 0; count--) {
+        contentTypes.push_back(in.uleb());
+        forms.push_back(in.uleb());
+    }
+    for (std::uint64_t count = in.uleb(); count > 0 && in.ok; count--) {
+        std::string path;
+        for (size_t i = 0; i < forms.size(); i++) {
+            std::string str;
+            if (!readEntryForm(in, forms[i], dwarf64, sections, str)) {
+                return false;
+            }
+            if (contentTypes[i] == 1) {   // DW_LNCT_path
+                path = str;
+            }
+        }
+        names.push_back(baseName(path.c_str()));
+    }
+    return in.ok;
+}
+
+/*
+ * Runs the line number program of one unit, whose contents (everything after
+ * its length field) are in the given reader, and appends its rows to the
+ * table.  Sequences that start at address 0 belong to functions that the
+ * linker discarded, so they are dropped.
+ */
+void readLineProgram(ByteReader& in, bool dwarf64, const DebugSections& sections,
+                     LineTable& table) {
+    int version = (int) in.fixed(2);
+    if (version < 2 || version > 5) {
+        return;
+    }
+    if (version >= 5) {
+        in.skip(2);   // address_size, segment_selector_size
+    }
+    std::uint64_t headerLength = in.fixed(dwarf64 ? 8 : 4);
+    if (!in.canRead(headerLength)) {
+        return;
+    }
+    ByteReader program(in.pos + headerLength, in.end);
+
+    unsigned int minInstructionLength = in.u8();
+    if (version >= 4) {
+        in.skip(1);   // maximum_operations_per_instruction; only VLIW uses it
+    }
+    in.skip(1);       // default_is_stmt; every row is used
+    int lineBase = (signed char) in.u8();
+    unsigned int lineRange = in.u8();
+    unsigned int opcodeBase = in.u8();
+    if (lineRange == 0 || opcodeBase == 0) {
+        return;
+    }
+    std::vector<unsigned int> opcodeLengths(opcodeBase, 0);
+    for (unsigned int i = 1; i < opcodeBase; i++) {
+        opcodeLengths[i] = in.u8();
+    }
+
+    // file numbers are 0-based in DWARF 5 and 1-based before it
+    std::vector<std::string> names;
+    if (version >= 5) {
+        std::vector<std::string> directories;
+        if (!readEntryTable(in, dwarf64, sections, directories)
+                || !readEntryTable(in, dwarf64, sections, names)) {
+            return;
+        }
+    } else {
+        while (in.ok && *in.cstr() != '\0') {
+            // include_directories are not needed for base names
+        }
+        names.push_back("");
+        for (const char* name = in.cstr(); in.ok && *name != '\0'; name = in.cstr()) {
+            names.push_back(baseName(name));
+            in.uleb();   // directory index
+            in.uleb();   // modification time
+            in.uleb();   // file length
+        }
+    }
+    if (!in.ok) {
+        return;
+    }
+    std::vector<unsigned int> fileIndexes;
+    for (const std::string& name : names) {
+        fileIndexes.push_back(table.addFile(name));
+    }
+
+    std::uint64_t address = 0;
+    std::uint64_t file = 1;
+    unsigned int line = 1;
+    size_t sequenceStart = table.rows.size();
+    while (program.ok && !program.atEnd()) {
+        bool emitRow = false;
+        unsigned int opcode = program.u8();
+        if (opcode >= opcodeBase) {
+            // special opcode: advance the address and line together
+            unsigned int adjusted = opcode - opcodeBase;
+            address += (adjusted / lineRange) * minInstructionLength;
+            line += lineBase + (int) (adjusted % lineRange);
+            emitRow = true;
+        } else if (opcode == 0) {
+            // extended opcode
+            std::uint64_t length = program.uleb();
+            if (length == 0 || !program.canRead(length)) {
+                break;
+            }
+            const unsigned char* next = program.pos + length;
+            unsigned int extended = program.u8();
+            if (extended == 1) {          // DW_LNE_end_sequence
+                if (table.rows.size() > sequenceStart
+                        && table.rows[sequenceStart].address != 0) {
+                    LineRow row = {address, END_OF_SEQUENCE, 0};
+                    table.rows.push_back(row);
+                } else {
+                    table.rows.resize(sequenceStart);
+                }
+                sequenceStart = table.rows.size();
+                address = 0;
+                file = 1;
+                line = 1;
+            } else if (extended == 2) {   // DW_LNE_set_address
+                address = program.fixed((int) std::min(length - 1, (std::uint64_t) 8));
+            } else if (extended == 3) {   // DW_LNE_define_file
+                fileIndexes.push_back(table.addFile(baseName(program.cstr())));
+            }
+            program.pos = next;
+        } else {
+            // standard opcode
+            switch (opcode) {
+            case 1:    // DW_LNS_copy
+                emitRow = true;
+                break;
+            case 2:    // DW_LNS_advance_pc
+                address += program.uleb() * minInstructionLength;
+                break;
+            case 3:    // DW_LNS_advance_line
+                line += (int) program.sleb();
+                break;
+            case 4:    // DW_LNS_set_file
+                file = program.uleb();
+                break;
+            case 8:    // DW_LNS_const_add_pc
+                address += ((255 - opcodeBase) / lineRange) * minInstructionLength;
+                break;
+            case 9:    // DW_LNS_fixed_advance_pc
+                address += program.fixed(2);
+                break;
+            default:
+                // column, flags and opcodes from newer versions; skip operands
+                for (unsigned int i = 0; i < opcodeLengths[opcode]; i++) {
+                    program.uleb();
+                }
+                break;
+            }
+        }
+        if (emitRow) {
+            LineRow row = {address, END_OF_SEQUENCE, line};
+            if (file < fileIndexes.size()) {
+                row.file = fileIndexes[file];
+            }
+            if (row.file != END_OF_SEQUENCE) {
+                table.rows.push_back(row);
+            }
+        }
+    }
+
+    // a sequence without an end is not trustworthy
+    table.rows.resize(sequenceStart);
+}
+
+bool compareRows(const LineRow& a, const LineRow& b) {
+    // a sequence's end sorts before a sequence that starts at the same address
+    if (a.address != b.address) {
+        return a.address < b.address;
+    }
+    return (a.file == END_OF_SEQUENCE) > (b.file == END_OF_SEQUENCE);
+}
+
+/*
+ * Finds the debug sections in an ELF file that has been mapped into memory.
+ */
+template <typename Ehdr, typename Shdr>
+bool findSections(const unsigned char* file, size_t fileSize, DebugSections& sections) {
+    Ehdr header;
+    if (fileSize < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, file, sizeof(header));
+    if (header.e_shoff == 0 || header.e_shentsize != sizeof(Shdr)
+            || header.e_shstrndx >= header.e_shnum
+            || header.e_shoff > fileSize
+            || (fileSize - header.e_shoff) / sizeof(Shdr) < header.e_shnum) {
+        return false;
+    }
+    std::vector<Shdr> headers(header.e_shnum);
+    memcpy(headers.data(), file + header.e_shoff, header.e_shnum * sizeof(Shdr));
+    const Shdr& names = headers[header.e_shstrndx];
+    if (names.sh_offset > fileSize || names.sh_size > fileSize - names.sh_offset) {
+        return false;
+    }
+    Section nameSection;
+    nameSection.data = file + names.sh_offset;
+    nameSection.size = names.sh_size;
+    for (const Shdr& shdr : headers) {
+        if (shdr.sh_type == SHT_NOBITS || (shdr.sh_flags & SHF_COMPRESSED)
+                || shdr.sh_offset > fileSize || shdr.sh_size > fileSize - shdr.sh_offset) {
+            continue;
+        }
+        Section section;
+        section.data = file + shdr.sh_offset;
+        section.size = shdr.sh_size;
+        std::string name = stringAt(nameSection, shdr.sh_name);
+        if (name == ".debug_line") {
+            sections.line = section;
+        } else if (name == ".debug_line_str") {
+            sections.lineStr = section;
+        } else if (name == ".debug_str") {
+            sections.str = section;
+        }
+    }
+    return sections.line.data != nullptr;
+}
+
+/*
+ * Reads every line program in the given ELF file into the table.  Returns
+ * false if the file cannot be read or has no usable line table.
+ */
+bool loadLineTable(const std::string& path, LineTable& table) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < EI_NIDENT) {
+        close(fd);
+        return false;
+    }
+    size_t fileSize = (size_t) info.st_size;
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const unsigned char* file = static_cast<const unsigned char*>(mapping);
+    // the headers are copied into the host's structures, so only files that
+    // match a little-endian host are read
+    const unsigned short endianTest = 1;
+    bool littleEndianHost = *reinterpret_cast<const unsigned char*>(&endianTest) != 0;
+    DebugSections sections;
+    bool found = false;
+    if (memcmp(file, ELFMAG, SELFMAG) == 0 && file[EI_DATA] == ELFDATA2LSB && littleEndianHost) {
+        if (file[EI_CLASS] == ELFCLASS64) {
+            found = findSections<Elf64_Ehdr, Elf64_Shdr>(file, fileSize, sections);
+        } else if (file[EI_CLASS] == ELFCLASS32) {
+            found = findSections<Elf32_Ehdr, Elf32_Shdr>(file, fileSize, sections);
+        }
+    }
+
+    if (found) {
+        ByteReader in(sections.line.data, sections.line.data + sections.line.size);
+        while (in.ok && !in.atEnd()) {
+            std::uint64_t length = in.fixed(4);
+            bool dwarf64 = length == 0xffffffffu;
+            if (dwarf64) {
+                length = in.fixed(8);
+            }
+            if (!in.canRead(length)) {
+                break;
+            }
+            ByteReader unit(in.pos, in.pos + length);
+            readLineProgram(unit, dwarf64, sections, table);
+            in.pos += length;
+        }
+        std::stable_sort(table.rows.begin(), table.rows.end(), compareRows);
+    }
+    munmap(mapping, fileSize);
+    return !table.rows.empty();
+}
+
+} // namespace
+
+// line tables by module; a null table means the module has none
+STATIC_VARIABLE_DECLARE_BLANK(std::mutex, lineTableLock)
+STATIC_VARIABLE_DECLARE_MAP_EMPTY(std::map, const void*, LineTable*, lineTables)
+
+bool lookupSourceLine(void* address, std::string& lineStr) {
+    Dl_info dlinfo;
+    struct link_map* module = nullptr;
+    if (!dladdr1(address, &dlinfo, reinterpret_cast<void**>(&module), RTLD_DL_LINKMAP) || !module) {
+        return false;
+    }
+    // the main program's link map has an empty name
+    std::string path = module->l_name && module->l_name[0] ? module->l_name : "/proc/self/exe";
+    std::uint64_t bias = module->l_addr;
+
+    std::lock_guard<std::mutex> lock(STATIC_VARIABLE(lineTableLock));
+    LineTable*& table = STATIC_VARIABLE(lineTables)[module];
+    if (table && (table->path != path || table->bias != bias)) {
+        // the module was unloaded and another one was loaded in its place
+        delete table;
+        table = nullptr;
+    }
+    if (!table) {
+        table = new LineTable();
+        table->path = path;
+        table->bias = bias;
+        if (!loadLineTable(path, *table)) {
+            table->rows.clear();
+            table->files.clear();
+            table->fileIndexes.clear();
+        }
+    }
+    if (table->rows.empty()) {
+        return false;
+    }
+
+    // a return address points just past the call, which may be on a later line
+    LineRow key = {(uintptr_t) address - bias - 1, 0, 0};
+    std::vector<LineRow>::const_iterator it = std::upper_bound(
+                table->rows.begin(), table->rows.end(), key,
+                [](const LineRow& a, const LineRow& b) { return a.address < b.address; });
+    if (it == table->rows.begin()) {
+        return false;
+    }
+    --it;
+    if (it->file == END_OF_SEQUENCE || it->line == 0) {
+        return false;
+    }
+    lineStr = table->files[it->file] + ":" + std::to_string(it->line);
+    return true;
+}
+
+} // namespace stanfordcpplib
+
+#else // !__linux__
+
+namespace stanfordcpplib {
+
+bool lookupSourceLine(void* /*address*/, std::string& /*lineStr*/) {
+    return false;
+}
+
+} // namespace stanfordcpplib
+
+#endif // __linux__
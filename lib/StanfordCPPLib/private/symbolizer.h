@@ -0,0 +1,39 @@
+/*
+ * File: symbolizer.h
+ * ------------------
+ * This file declares the in-process source-line lookup used by the gcc
+ * implementation of call_stack.  Instead of running <code>addr2line</code>
+ * for every stack trace, the lookup reads the DWARF line table of the
+ * executable or shared library that contains an address, the first time an
+ * address in that module is looked up, and answers every later lookup from
+ * memory with a binary search.
+ *
+ * Line tables are only read on Linux, from ELF files with uncompressed
+ * <code>.debug_line</code> sections.  Everywhere else (or when a module was
+ * built without debug information) the lookup fails and call_stack falls
+ * back to the external tool.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#ifndef _symbolizer_h
+#define _symbolizer_h
+
+#include <string>
+
+namespace stanfordcpplib {
+
+/*
+ * Looks up the source line of the call that the given return address
+ * (as reported by backtrace) returns to.  On success, sets lineStr to the
+ * source file's name and the line number in the form "foo.cpp:123", as
+ * "addr2line -s" would print it, and returns true.  Returns false if the
+ * address's module has no usable line table or the table does not cover it.
+ * This function is thread-safe.
+ */
+bool lookupSourceLine(void* address, std::string& lineStr);
+
+} // namespace stanfordcpplib
+
+#endif // _symbolizer_h
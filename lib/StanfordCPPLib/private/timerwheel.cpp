@@ -0,0 +1,191 @@
+/*
+ * File: timerwheel.cpp
+ * --------------------
+ * This file implements the timerwheel.h interface.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include "private/timerwheel.h"
+
+namespace stanfordcpplib {
+
+TimerEntry::TimerEntry()
+        : prev(nullptr),
+          next(nullptr),
+          expiry(0),
+          level(-1),
+          slot(0) {
+    // empty
+}
+
+TimerWheel::TimerWheel() : current(0), count(0) {
+    for (int level = 0; level < LEVELS; level++) {
+        levelCounts[level] = 0;
+        for (int slot = 0; slot < SLOTS; slot++) {
+            slots[level][slot] = nullptr;
+        }
+    }
+}
+
+void TimerWheel::schedule(TimerEntry* entry, Tick expiry) {
+    if (isScheduled(entry)) {
+        unlink(entry);
+    }
+    entry->expiry = expiry < current ? current : expiry;
+    insert(entry);
+}
+
+void TimerWheel::cancel(TimerEntry* entry) {
+    if (isScheduled(entry)) {
+        unlink(entry);
+    }
+}
+
+void TimerWheel::advance(Tick tick, std::vector<TimerEntry*>& expired) {
+    while (current <= tick) {
+        if (count == 0) {
+            // nothing can expire; skip straight to the end
+            current = tick + 1;
+            return;
+        }
+
+        // if the lowest levels are empty, nothing can happen before the next
+        // tick at which the lowest non-empty level is cascaded; jump to it
+        int lowest = 0;
+        while (levelCounts[lowest] == 0) {
+            lowest++;
+        }
+        if (lowest > 0) {
+            Tick mask = ((Tick) 1 << (lowest * SLOT_BITS)) - 1;
+            Tick next = (current | mask) + 1;
+            if (current & mask) {
+                current = next <= tick ? next : tick + 1;
+                continue;
+            }
+        }
+
+        // when a level's index wraps around to 0, move the next slot of the
+        // level above it down into the lower levels
+        Tick index = current & SLOT_MASK;
+        for (int level = 1; index == 0 && level < LEVELS; level++) {
+            index = (current >> (level * SLOT_BITS)) & SLOT_MASK;
+            cascade(level);
+        }
+
+        // everything left in this level-0 slot is due now; the list is kept
+        // in scheduling order, so entries due on the same tick fire in order
+        int slot = (int) (current & SLOT_MASK);
+        while (slots[0][slot]) {
+            TimerEntry* entry = slots[0][slot];
+            unlink(entry);
+            expired.push_back(entry);
+        }
+        current++;
+    }
+}
+
+TimerWheel::Tick TimerWheel::getNextExpiry() const {
+    if (count == 0) {
+        return ~(Tick) 0;
+    }
+
+    // entries above level 0 cannot come due before the next level-0 wraparound
+    // (which is the current tick itself if it has not been processed yet)
+    Tick boundary = (current & SLOT_MASK) == 0 ? current : (current | SLOT_MASK) + 1;
+    for (Tick tick = current; tick < current + SLOTS; tick++) {
+        if (slots[0][tick & SLOT_MASK]) {
+            if (tick < boundary || count == levelCounts[0]) {
+                return tick;
+            }
+            break;
+        }
+    }
+    return boundary;
+}
+
+TimerWheel::Tick TimerWheel::getCurrentTick() const {
+    return current;
+}
+
+bool TimerWheel::isScheduled(const TimerEntry* entry) {
+    return entry->level >= 0;
+}
+
+int TimerWheel::size() const {
+    return count;
+}
+
+void TimerWheel::cascade(int level) {
+    int slot = (int) ((current >> (level * SLOT_BITS)) & SLOT_MASK);
+    TimerEntry* entry = slots[level][slot];
+    slots[level][slot] = nullptr;
+    while (entry) {
+        TimerEntry* next = entry->next;
+        levelCounts[level]--;
+        count--;
+        insert(entry);
+        entry = next;
+    }
+}
+
+/*
+ * Puts an entry that is not scheduled at the end of the slot for its expiry.
+ * The level is chosen so that the slot index cannot wrap around before the
+ * entry is due; entries too far away for the top level are parked in its
+ * furthest slot and placed again each time that slot is cascaded.
+ */
+void TimerWheel::insert(TimerEntry* entry) {
+    Tick expiry = entry->expiry < current ? current : entry->expiry;
+    Tick delta = expiry - current;
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= ((Tick) 1 << ((level + 1) * SLOT_BITS))) {
+        level++;
+    }
+    if (level == LEVELS - 1 && delta >= ((Tick) 1 << (LEVELS * SLOT_BITS))) {
+        expiry = current + ((Tick) 1 << (LEVELS * SLOT_BITS)) - 1;
+    }
+    int slot = (int) ((expiry >> (level * SLOT_BITS)) & SLOT_MASK);
+
+    // append, keeping each slot in the order its entries were scheduled;
+    // the head's prev pointer tracks the tail so appending is O(1)
+    TimerEntry* head = slots[level][slot];
+    entry->next = nullptr;
+    if (head) {
+        entry->prev = head->prev;
+        head->prev->next = entry;
+        head->prev = entry;
+    } else {
+        entry->prev = entry;
+        slots[level][slot] = entry;
+    }
+    entry->level = level;
+    entry->slot = slot;
+    levelCounts[level]++;
+    count++;
+}
+
+void TimerWheel::unlink(TimerEntry* entry) {
+    TimerEntry*& head = slots[entry->level][entry->slot];
+    if (entry == head) {
+        head = entry->next;
+        if (head) {
+            head->prev = entry->prev;
+        }
+    } else {
+        entry->prev->next = entry->next;
+        if (entry->next) {
+            entry->next->prev = entry->prev;
+        } else {
+            head->prev = entry->prev;
+        }
+    }
+    levelCounts[entry->level]--;
+    count--;
+    entry->prev = nullptr;
+    entry->next = nullptr;
+    entry->level = -1;
+}
+
+} // namespace stanfordcpplib
@@ -0,0 +1,113 @@
+/*
+ * File: timerwheel.h
+ * ------------------
+ * This file defines the <code>TimerWheel</code> class, a hierarchical
+ * timing wheel that the platform uses to run <code>GTimer</code>s natively
+ * in C++ instead of asking the Java back-end to send timer events.
+ *
+ * Time is measured in ticks of one millisecond.  The wheel has four levels
+ * of 256 slots each; level 0 holds the entries due in the next 256 ticks,
+ * level 1 the ones due in the next 65,536 ticks, and so on.  Scheduling and
+ * cancelling are O(1), and each entry is moved down a level at most three
+ * times before it expires, so thousands of timers cost almost nothing.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#ifndef _timerwheel_h
+#define _timerwheel_h
+
+#include <cstdint>
+#include <vector>
+
+namespace stanfordcpplib {
+
+/*
+ * An entry in a TimerWheel.  Clients embed this in (or derive from it in)
+ * their own timer record; the wheel links entries together through these
+ * fields and never allocates or frees them itself.
+ */
+struct TimerEntry {
+    TimerEntry* prev;
+    TimerEntry* next;
+    std::uint64_t expiry;        // tick at which the entry is due
+    int level;                   // -1 when the entry is not scheduled
+    int slot;
+
+    TimerEntry();
+};
+
+class TimerWheel {
+public:
+    typedef std::uint64_t Tick;
+
+    TimerWheel();
+
+    /*
+     * Adds the given entry so that it expires at the given tick.  Ticks that
+     * have already been processed are treated as the next tick.  If the entry
+     * was already scheduled, it is moved.
+     */
+    void schedule(TimerEntry* entry, Tick expiry);
+
+    /*
+     * Removes the given entry from the wheel; does nothing if it is not
+     * scheduled.
+     */
+    void cancel(TimerEntry* entry);
+
+    /*
+     * Processes every tick up to and including the given one, appending the
+     * entries that expire to the given vector in the order they expire.
+     * Expired entries are no longer scheduled when this returns.
+     */
+    void advance(Tick tick, std::vector<TimerEntry*>& expired);
+
+    /*
+     * Returns the earliest tick at which advance could return an entry.
+     * This is exact when that entry is in level 0 and a lower bound otherwise,
+     * so callers that sleep until this tick should ask again after waking up.
+     * Returns the largest possible tick if nothing is scheduled.
+     */
+    Tick getNextExpiry() const;
+
+    /*
+     * Returns the first tick that has not been processed yet.
+     */
+    Tick getCurrentTick() const;
+
+    /*
+     * Returns whether the given entry is scheduled in some wheel.
+     */
+    static bool isScheduled(const TimerEntry* entry);
+
+    /*
+     * Returns the number of scheduled entries.
+     */
+    int size() const;
+
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 8;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const Tick SLOT_MASK = SLOTS - 1;
+
+    void cascade(int level);
+    void insert(TimerEntry* entry);
+    void unlink(TimerEntry* entry);
+
+    TimerEntry* slots[LEVELS][SLOTS];
+    int levelCounts[LEVELS];
+    Tick current;
+    int count;
+
+    // entries are linked into and out of slots by pointer; copying a wheel
+    // would leave them pointing at the wrong one
+    TimerWheel(const TimerWheel&);
+    TimerWheel& operator =(const TimerWheel&);
+};
+
+} // namespace stanfordcpplib
+
+#endif // _timerwheel_h
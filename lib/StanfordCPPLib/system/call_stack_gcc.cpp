@@ -4,6 +4,9 @@
  * Linux/gcc implementation of the call_stack class.
  *
  * @author Marty Stepp, based on code from Fredrik Orderud
+ * @version 2026/10/17
+ * - look up line numbers in-process from the DWARF line tables and cache
+ *   resolved frames, so that only the first trace runs addr2line (if any)
  * @version 2017/10/18
  * - small bug fix for pointer comparison
  * @version 2017/09/02
@@ -40,13 +43,17 @@
 #endif // __GNUC__
 #include <iomanip>
 #include <iostream>
+#include <list>
+#include <mutex>
 #include <sstream>
 #include <stdlib.h>
+#include <unordered_map>
 #include "call_stack.h"
 #include "exceptions.h"
 #include "strlib.h"
 #include "private/platform.h"
 #include "private/static.h"
+#include "private/symbolizer.h"
 
 namespace stacktrace {
 
@@ -233,6 +240,104 @@ void*& fakeCallStackPointer() {
 namespace stacktrace {
 STATIC_CONST_VARIABLE_DECLARE(int, STACK_FRAMES_TO_SKIP, 0)
 STATIC_CONST_VARIABLE_DECLARE(int, STACK_FRAMES_MAX, 20)
+STATIC_CONST_VARIABLE_DECLARE(int, FRAME_CACHE_MAX, 1024)
+
+/*
+ * Frames that have already been resolved, most recently used first, so that
+ * printing the same trace again costs a few hash lookups.  An entry with an
+ * empty function name stands for an address that is not shown in traces.
+ */
+typedef std::list<std::pair<void*, entry> > FrameList;
+STATIC_VARIABLE_DECLARE_BLANK(std::mutex, frameCacheLock)
+STATIC_VARIABLE_DECLARE_BLANK(FrameList, frameCacheOrder)
+STATIC_VARIABLE_DECLARE_MAP_EMPTY(std::unordered_map, void*, FrameList::iterator, frameCache)
+
+static bool lookupFrame(void* address, entry& ent) {
+    std::lock_guard<std::mutex> lock(STATIC_VARIABLE(frameCacheLock));
+    auto it = STATIC_VARIABLE(frameCache).find(address);
+    if (it == STATIC_VARIABLE(frameCache).end()) {
+        return false;
+    }
+    FrameList& order = STATIC_VARIABLE(frameCacheOrder);
+    order.splice(order.begin(), order, it->second);
+    ent = it->second->second;
+    return true;
+}
+
+static void cacheFrame(void* address, const entry& ent) {
+    std::lock_guard<std::mutex> lock(STATIC_VARIABLE(frameCacheLock));
+    FrameList& order = STATIC_VARIABLE(frameCacheOrder);
+    auto& cache = STATIC_VARIABLE(frameCache);
+    auto it = cache.find(address);
+    if (it != cache.end()) {
+        // another thread resolved the same frame at the same time
+        order.splice(order.begin(), order, it->second);
+        return;
+    }
+    order.push_front(std::make_pair(address, ent));
+    cache[address] = order.begin();
+    if ((int) order.size() > STATIC_VARIABLE(FRAME_CACHE_MAX)) {
+        cache.erase(order.back().first);
+        order.pop_back();
+    }
+}
+
+/*
+ * Reads the linker symbol info for the given address into ent.
+ * Leaves the function name empty if the address can't be resolved.
+ */
+static void resolveFrame(void* address, entry& ent) {
+    // DL* = programmer API to dynamic linking loader
+
+    // https://linux.die.net/man/3/dladdr
+    // const char *dli_fname;   // pathname of shared object that contains address
+    // void       *dli_fbase;   // address at which shared object is loaded
+    // const char *dli_sname;   // name of nearest symbol with address lower than addr
+    // void       *dli_saddr;   // exact address of symbol named in dli_sname
+
+    Dl_info dlinfo;
+    if (!dladdr(address, &dlinfo)) {
+        return;
+    }
+
+    // debug code left in because we occasionally need to debug stack traces
+    // std::cout << "ptr=" << address << "  dlinfo: "
+    //           << " fname=" << (dlinfo.dli_fname ? dlinfo.dli_fname : "null")
+    //           << " fbase=" << dlinfo.dli_fbase
+    //           << " sname=" << (dlinfo.dli_sname ? dlinfo.dli_sname : "null")
+    //           << " saddr=" << dlinfo.dli_saddr << std::endl;
+
+    const char* symname = dlinfo.dli_sname;
+
+    int   status;
+    char* demangled = abi::__cxa_demangle(symname, /* buffer */ nullptr,
+                                          /* length pointer */ nullptr, &status);
+    if (status == 0 && demangled) {
+        symname = demangled;
+    }
+
+    if (dlinfo.dli_fname && symname) {
+        ent.file     = dlinfo.dli_fname;
+        ent.line     = 0;   // unsupported; use lineStr instead (later)
+        ent.function = symname;
+        ent.address  = address;
+
+        // The dli_fbase gives an overall offset into the file itself;
+        // the dli_saddr is the offset of that symbol/function/line.
+        // by subtracting them we get the offset of the function within the file
+        // which addr2line can use to look up function line numbers.
+
+        if (dlinfo.dli_fbase && address >= dlinfo.dli_fbase) {
+            ent.address2 = (void*) ((long) address - (long) dlinfo.dli_fbase);
+        } else {
+            ent.address2 = dlinfo.dli_saddr;
+        }
+    }
+
+    if (demangled) {
+        free(demangled);
+    }
+}
 
 std::ostream& operator <<(std::ostream& out, const entry& ent) {
     return out << ent.toString();
@@ -246,70 +351,25 @@ call_stack::call_stack(const size_t /*num_discard = 0*/) {
     }
     int stack_depth = backtrace(trace, STATIC_VARIABLE(STACK_FRAMES_MAX));
 
-    // First pass: read linker symbol info and get address offsets.
+    // First pass: take frames from the cache, or read linker symbol info and
+    // look up line numbers in the line tables (loaded once per module).
+    std::vector<entry> frames;
+    std::vector<int> uncached;        // indexes into frames
+    std::vector<int> needAddr2line;   // indexes into frames
     for (int i = STATIC_VARIABLE(STACK_FRAMES_TO_SKIP); i < stack_depth; i++) {
-        // DL* = programmer API to dynamic linking loader
-
-        // https://linux.die.net/man/3/dladdr
-        // const char *dli_fname;   // pathname of shared object that contains address
-        // void       *dli_fbase;   // address at which shared object is loaded
-        // const char *dli_sname;   // name of nearest symbol with address lower than addr
-        // void       *dli_saddr;   // exact address of symbol named in dli_sname
-
-        Dl_info dlinfo;
-        if (!dladdr(trace[i], &dlinfo)) {
-            continue;
-        }
-
-        // debug code left in because we occasionally need to debug stack traces
-        // std::cout << i << "  ptr=" << trace[i] << "  dlinfo: "
-        //           << " fname=" << (dlinfo.dli_fname ? dlinfo.dli_fname : "null")
-        //           << " fbase=" << dlinfo.dli_fbase
-        //           << " sname=" << (dlinfo.dli_sname ? dlinfo.dli_sname : "null")
-        //           << " saddr=" << dlinfo.dli_saddr << std::endl;
-
-        const char* symname = dlinfo.dli_sname;
-
-        int   status;
-        char* demangled = abi::__cxa_demangle(symname, /* buffer */ nullptr,
-                                              /* length pointer */ nullptr, &status);
-        if (status == 0 && demangled) {
-            symname = demangled;
-        }
-        
-        // store entry to stack
-        if (dlinfo.dli_fname && symname) {
-            entry e;
-            e.file     = dlinfo.dli_fname;
-            e.line     = 0;   // unsupported; use lineStr instead (later)
-            e.function = symname;
-            e.address  = trace[i];
-
-            // The dli_fbase gives an overall offset into the file itself;
-            // the dli_saddr is the offset of that symbol/function/line.
-            // by subtracting them we get the offset of the function within the file
-            // which addr2line can use to look up function line numbers.
-
-            if (dlinfo.dli_fbase && trace[i] >= dlinfo.dli_fbase) {
-                e.address2 = (void*) ((long) trace[i] - (long) dlinfo.dli_fbase);
-            } else {
-                e.address2 = dlinfo.dli_saddr;
+        entry e;
+        if (!lookupFrame(trace[i], e)) {
+            resolveFrame(trace[i], e);
+            if (!e.function.empty() && !stanfordcpplib::lookupSourceLine(trace[i], e.lineStr)) {
+                needAddr2line.push_back((int) frames.size());
             }
-            stack.push_back(e);
-        }
-
-        if (demangled) {
-            free(demangled);
+            uncached.push_back((int) frames.size());
         }
+        frames.push_back(e);
     }
 
-    if (stack_depth == 0 || stack.empty()) {
-        return;
-    }
-
-    // Second pass: try to look up line numbers.
-    //
-    // let's also try to get the line numbers via an 'addr2line' external process
+    // Second pass: for frames in modules without a usable line table,
+    // try to get the line numbers via an 'addr2line' external process
     // (for max compatibility with GCC and Clang, we look up the addresses 2 ways:
     // 1) by the raw void* given to us from backtrace(), and
     // 2) by the offsetted pointer where we subtract the addr of the exe file.
@@ -319,22 +379,32 @@ call_stack::call_stack(const size_t /*num_discard = 0*/) {
     // and to avoid running external addr2line process twice, we just look it up
     // both ways and then figure out which one is best by string length.
     // The failing one will emit a lot of short "??:?? 0" lines.
+    if (!needAddr2line.empty()) {
+        std::vector<void*> addrsToLookup;
+        for (int index : needAddr2line) {
+            addrsToLookup.push_back(frames[index].address);
+            addrsToLookup.push_back(frames[index].address2);
+        }
 
-    std::vector<void*> addrsToLookup;
-    for (const entry& e : stack) {
-        addrsToLookup.push_back(e.address);
-        addrsToLookup.push_back(e.address2);
+        std::string addr2lineOutput;
+        addr2line_all(addrsToLookup, addr2lineOutput);
+        std::vector<std::string> addr2lineLines = stringSplit(addr2lineOutput, "\n");
+        int numAddrLines = (int) addr2lineLines.size();
+        for (int i = 0, size = (int) needAddr2line.size(); i < size; i++) {
+            std::string opt1 = (2 * i < numAddrLines ? addr2lineLines[2 * i] : std::string());
+            std::string opt2 = (2 * i + 1 < numAddrLines ? addr2lineLines[2 * i + 1] : std::string());
+            std::string best = opt1.length() > opt2.length() ? opt1 : opt2;
+            frames[needAddr2line[i]].lineStr = addr2line_clean(best);
+        }
     }
 
-    std::string addr2lineOutput;
-    addr2line_all(addrsToLookup, addr2lineOutput);
-    std::vector<std::string> addr2lineLines = stringSplit(addr2lineOutput, "\n");
-    int numAddrLines = (int) addr2lineLines.size();
-    for (int i = 0, size = (int) stack.size(); i < size; i++) {
-        std::string opt1 = (2 * i < numAddrLines ? addr2lineLines[2 * i] : std::string());
-        std::string opt2 = (2 * i + 1 < numAddrLines ? addr2lineLines[2 * i + 1] : std::string());
-        std::string best = opt1.length() > opt2.length() ? opt1 : opt2;
-        stack[i].lineStr = addr2line_clean(best);
+    for (int index : uncached) {
+        cacheFrame(trace[STATIC_VARIABLE(STACK_FRAMES_TO_SKIP) + index], frames[index]);
+    }
+    for (const entry& e : frames) {
+        if (!e.function.empty()) {
+            stack.push_back(e);
+        }
     }
 }
 
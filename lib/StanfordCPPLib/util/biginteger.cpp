@@ -6,6 +6,9 @@
  * such as int and long.
  * See biginteger.h for declarations and documentation of each member.
  *
+ * @version 2026/10/17
+ * - reimplemented on 32-bit limbs with Karatsuba multiplication,
+ *   Knuth division, and square-and-multiply pow/modPow
  * @version 2017/11/05
  * - fixed compiler error on some older clang versions about string insert call
  * @version 2017/10/28
@@ -16,14 +19,22 @@
 #include <algorithm>
 #include <cctype>
 #include <climits>
-#include <cmath>
-#include <iomanip>
-#include <iostream>
-#include <sstream>
 #include "error.h"
 #include "strlib.h"
 
-static int STRING_SIZE_MAX = 10000;   // for strings
+// operands with fewer limbs than this are multiplied with the schoolbook
+// algorithm; above it, Karatsuba's O(n^1.585) algorithm wins
+static const size_t KARATSUBA_THRESHOLD = 40;
+
+// magnitudes with fewer limbs than this are converted to/from base-10 by
+// repeated short division/multiplication; larger ones are split in half
+static const size_t DECIMAL_SPLIT_THRESHOLD = 60;
+
+// largest power of 10 that fits in a limb, and its number of digits
+static const uint32_t DECIMAL_CHUNK = 1000000000;
+static const int DECIMAL_CHUNK_DIGITS = 9;
+
+static const char DIGIT_CHARS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
 
 const BigInteger BigInteger::NEGATIVE_ONE("-1");
 const BigInteger BigInteger::ZERO("0");
@@ -40,63 +51,188 @@ const BigInteger BigInteger::MAX_SHORT("32767");
 const BigInteger BigInteger::MIN_SHORT("-32768");
 const BigInteger BigInteger::MAX_USHORT("65535");
 
+/*
+ * Low-level kernels operating on raw limb arrays.
+ * All arrays are little-endian (least significant limb first).
+ */
+namespace {
+
+typedef std::vector<uint32_t> Limbs;
+
+// returns the number of limbs in a[0..n) ignoring high-order zeros
+size_t trimmedLength(const uint32_t* a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) {
+        n--;
+    }
+    return n;
+}
+
+// out[0..na+nb) = a * b; out must not alias a or b
+void multiplySchoolbook(const uint32_t* a, size_t na,
+                        const uint32_t* b, size_t nb,
+                        uint32_t* out) {
+    std::fill(out, out + na + nb, 0);
+    for (size_t i = 0; i < na; i++) {
+        uint64_t carry = 0;
+        uint64_t ai = a[i];
+        if (ai == 0) {
+            continue;
+        }
+        for (size_t j = 0; j < nb; j++) {
+            uint64_t t = ai * b[j] + out[i + j] + carry;
+            out[i + j] = (uint32_t) t;
+            carry = t >> 32;
+        }
+        out[i + nb] = (uint32_t) carry;
+    }
+}
+
+// r[offset..] += a[0..na); r must be long enough to absorb the carry
+void addInto(uint32_t* r, size_t rn, size_t offset, const uint32_t* a, size_t na) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < na; i++) {
+        uint64_t t = (uint64_t) r[offset + i] + a[i] + carry;
+        r[offset + i] = (uint32_t) t;
+        carry = t >> 32;
+    }
+    for (size_t k = offset + i; carry != 0 && k < rn; k++) {
+        uint64_t t = (uint64_t) r[k] + carry;
+        r[k] = (uint32_t) t;
+        carry = t >> 32;
+    }
+}
+
+// r[0..rn) -= a[0..na); requires r >= a
+void subtractFrom(uint32_t* r, size_t rn, const uint32_t* a, size_t na) {
+    int64_t borrow = 0;
+    size_t i = 0;
+    for (; i < na; i++) {
+        int64_t t = (int64_t) r[i] - a[i] - borrow;
+        borrow = t < 0 ? 1 : 0;
+        r[i] = (uint32_t) t;
+    }
+    for (; borrow != 0 && i < rn; i++) {
+        int64_t t = (int64_t) r[i] - borrow;
+        borrow = t < 0 ? 1 : 0;
+        r[i] = (uint32_t) t;
+    }
+}
+
+// out[0..na+nb) = a * b using Karatsuba's algorithm above the threshold
+void multiplyKaratsuba(const uint32_t* a, size_t na,
+                       const uint32_t* b, size_t nb,
+                       uint32_t* out) {
+    std::fill(out, out + na + nb, 0);
+    na = trimmedLength(a, na);
+    nb = trimmedLength(b, nb);
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb == 0) {
+        return;
+    } else if (nb < KARATSUBA_THRESHOLD) {
+        multiplySchoolbook(a, na, b, nb, out);
+        return;
+    }
+
+    if (na >= 2 * nb) {
+        // unbalanced; multiply b by each nb-limb slice of a
+        Limbs partial(2 * nb);
+        for (size_t i = 0; i < na; i += nb) {
+            size_t len = std::min(nb, na - i);
+            multiplyKaratsuba(a + i, len, b, nb, partial.data());
+            addInto(out, na + nb, i, partial.data(), len + nb);
+        }
+        return;
+    }
+
+    // a = a1 * B^h + a0, b = b1 * B^h + b0  (with nb > h)
+    size_t h = na / 2;
+    const uint32_t* a0 = a;
+    const uint32_t* a1 = a + h;
+    const uint32_t* b0 = b;
+    const uint32_t* b1 = b + h;
+    size_t na0 = trimmedLength(a0, h);
+    size_t nb0 = trimmedLength(b0, h);
+    size_t na1 = na - h;
+    size_t nb1 = nb - h;
+
+    // z0 = a0 * b0 and z2 = a1 * b1 go directly into their places in out
+    multiplyKaratsuba(a0, na0, b0, nb0, out);
+    multiplyKaratsuba(a1, na1, b1, nb1, out + 2 * h);
+
+    // z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+    Limbs sa(std::max(na0, na1) + 1, 0);
+    std::copy(a1, a1 + na1, sa.begin());
+    addInto(sa.data(), sa.size(), 0, a0, na0);
+    Limbs sb(std::max(nb0, nb1) + 1, 0);
+    std::copy(b1, b1 + nb1, sb.begin());
+    addInto(sb.data(), sb.size(), 0, b0, nb0);
+    size_t nsa = trimmedLength(sa.data(), sa.size());
+    size_t nsb = trimmedLength(sb.data(), sb.size());
+    Limbs z1(nsa + nsb);
+    multiplyKaratsuba(sa.data(), nsa, sb.data(), nsb, z1.data());
+    subtractFrom(z1.data(), z1.size(), out, trimmedLength(out, na0 + nb0));
+    subtractFrom(z1.data(), z1.size(), out + 2 * h, trimmedLength(out + 2 * h, na1 + nb1));
+
+    addInto(out, na + nb, h, z1.data(), trimmedLength(z1.data(), z1.size()));
+}
+
+} // namespace
+
 BigInteger::BigInteger()
-    : number("0"),
-      sign(false) {
+    : sign(false) {
     // empty
 }
 
 BigInteger::BigInteger(const BigInteger& other)
-    : number(other.number),
+    : mag(other.mag),
       sign(other.sign) {
     // empty
 }
 
+BigInteger::BigInteger(BigInteger&& other)
+    : mag(std::move(other.mag)),
+      sign(other.sign) {
+    other.mag.clear();
+    other.sign = false;
+}
+
 BigInteger::BigInteger(const std::string& s, int radix) {
     setValue(s, radix);
 }
 
-BigInteger::BigInteger(const std::string& s, bool sin) {
-    setValue(s);
-    setSign(sin);
+BigInteger::BigInteger(const Limbs& m, bool sin)
+    : mag(m),
+      sign(sin) {
+    removeLeadingZeros(mag);
+    fixNegativeZero();
 }
 
-BigInteger::BigInteger(long n) {
-    setValue(toString(n));
+BigInteger::BigInteger(long n)
+    : sign(n < 0) {
+    // negate as unsigned so that LONG_MIN does not overflow
+    unsigned long u = n < 0 ? 0UL - (unsigned long) n : (unsigned long) n;
+    while (u != 0) {
+        mag.push_back((uint32_t) u);
+        u = u >> 16 >> 16;   // two shifts, since long may be only 32 bits wide
+    }
 }
 
 BigInteger BigInteger::abs() const {
-    return BigInteger(getNumber());
-}
-
-std::string BigInteger::add(const std::string& n1, const std::string& n2) {
-    // sum variable to store result;
-    // left-pad numbers with 0s to be the same length as needed
-    int digits = (int) (n1.length() > n2.length() ? n1.length() : n2.length());
-    std::string sum = padLeft("", digits);
-    std::string n1copy = padLeft(n1, digits);
-    std::string n2copy = padLeft(n2, digits);
-
-    // add each digit pair
-    int carry = 0;
-    for (int i = n1copy.length() - 1; i >= 0; --i) {
-        sum[i] = (carry + (n1copy[i] - '0') + (n2copy[i] - '0')) + '0';
-        if (i != 0) {
-            if (sum[i] > '9') {
-                sum[i] -= 10;
-                carry = 1;
-            } else {
-                carry = 0;
-            }
-        }
-    }
-
-    if (sum[0] > '9') {
-        // top digit carried over; make an additional digit at front
-        sum[0] -= 10;
-        sum.insert(0, (size_t) 1, '1');
-    }
+    return BigInteger(mag, false);
+}
 
+BigInteger::Limbs BigInteger::add(const Limbs& a, const Limbs& b) {
+    const Limbs& longer = a.size() >= b.size() ? a : b;
+    const Limbs& shorter = a.size() >= b.size() ? b : a;
+    Limbs sum(longer.size() + 1);
+    std::copy(longer.begin(), longer.end(), sum.begin());
+    sum.back() = 0;
+    addInto(sum.data(), sum.size(), 0, shorter.data(), shorter.size());
+    removeLeadingZeros(sum);
     return sum;
 }
 
@@ -112,6 +248,9 @@ void BigInteger::checkStringIsNumeric(const std::string& s, int radix) {
     if (scopy[0] == '+' || scopy[0] == '-') {
         start++;
     }
+    if (start >= (int) scopy.length()) {
+        error("Non-numeric string passed: \"" + scopy + "\"");
+    }
     for (int i = start, len = (int) scopy.length(); i < len; i++) {
         char ch = tolower(scopy[i]);
         bool good = false;
@@ -119,11 +258,8 @@ void BigInteger::checkStringIsNumeric(const std::string& s, int radix) {
             good = ch == '1';
         } else if (radix <= 10) {
             good = ch >= '0' && ch < '0' + radix;
-        } else if (radix <= 16) {
-            good = isdigit(ch) || (ch >= 'a' && ch < radix - 10 + 'a');
         } else {
-            // don't know how to verify other bases very well
-            good = isalnum(ch);
+            good = isdigit(ch) || (ch >= 'a' && ch < radix - 10 + 'a');
         }
 
         if (!good) {
@@ -132,86 +268,147 @@ void BigInteger::checkStringIsNumeric(const std::string& s, int radix) {
     }
 }
 
-std::pair<std::string, long> BigInteger::divide(const std::string& n, long den) {
-    long rem = 0;
-    std::string result;
-    result.resize(STRING_SIZE_MAX);
+int BigInteger::compare(const Limbs& a, const Limbs& b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    for (size_t i = a.size(); i-- > 0; ) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
 
-    for (int indx = 0, len = (int) n.length(); indx < len; ++indx) {
-        rem = (rem * 10) + (n[indx] - '0');
-        result[indx] = rem / den + '0';
-        rem %= den;
+/*
+ * Implementation notes: divide
+ * ----------------------------
+ * Long division of magnitudes using Knuth's Algorithm D
+ * (The Art of Computer Programming, vol. 2, section 4.3.1).
+ * The divisor is first shifted left so that its top limb has its high bit
+ * set; each quotient limb can then be estimated from the top two limbs of the
+ * remainder and is off by at most 2, which the add-back step corrects.
+ */
+void BigInteger::divide(const Limbs& a, const Limbs& b, Limbs& quotient, Limbs& remainder) {
+    if (compare(a, b) < 0) {
+        quotient.clear();
+        remainder = a;
+        return;
+    }
+    if (b.size() == 1) {
+        quotient = a;
+        uint32_t rem = divideSmall(quotient, b[0]);
+        remainder.clear();
+        if (rem != 0) {
+            remainder.push_back(rem);
+        }
+        return;
     }
 
-    result.resize(n.length());
-    result = removeLeadingZeros(result);
+    size_t n = b.size();
+    size_t m = a.size() - n;
+    int s = 0;
+    for (uint32_t top = b.back(); (top & 0x80000000u) == 0; top <<= 1) {
+        s++;
+    }
 
-    return make_pair(result, rem);
-}
+    // normalize: vn = b << s, un = a << s (with one extra high limb)
+    Limbs vn(n);
+    for (size_t i = n - 1; i > 0; i--) {
+        vn[i] = (b[i] << s) | (s == 0 ? 0 : (uint32_t) ((uint64_t) b[i - 1] >> (32 - s)));
+    }
+    vn[0] = b[0] << s;
+    Limbs un(a.size() + 1);
+    un[a.size()] = s == 0 ? 0 : (uint32_t) ((uint64_t) a.back() >> (32 - s));
+    for (size_t i = a.size() - 1; i > 0; i--) {
+        un[i] = (a[i] << s) | (s == 0 ? 0 : (uint32_t) ((uint64_t) a[i - 1] >> (32 - s)));
+    }
+    un[0] = a[0] << s;
+
+    const uint64_t base = UINT64_C(0x100000000);
+    quotient.assign(m + 1, 0);
+    for (size_t j = m + 1; j-- > 0; ) {
+        // estimate quotient limb qhat from the top two limbs of the remainder
+        uint64_t numer = ((uint64_t) un[j + n] << 32) | un[j + n - 1];
+        uint64_t qhat = numer / vn[n - 1];
+        uint64_t rhat = numer % vn[n - 1];
+        while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if (rhat >= base) {
+                break;
+            }
+        }
 
-// Returns (quotient, remainder) as a pair 2-tuple.
-// Implementation note: This is a stupid implementation.
-// It is quite slow and there are much better algorithms.  But it works.
-// see also:
-// https://en.wikipedia.org/wiki/Division_algorithm#Division_by_repeated_subtraction
-// pre: b2 != 0
-std::pair<BigInteger, BigInteger> BigInteger::divideBig(const BigInteger& numerator, const BigInteger& denominator) {
-    if (denominator.isNegative()) {
-        std::pair<BigInteger, BigInteger> result = divideBig(numerator, -denominator);
-        result.second = -result.second;
-        return result;
-    } else if (numerator.isNegative()) {
-        std::pair<BigInteger, BigInteger> result = divideBig(-numerator, denominator);
-        if (result.second == ZERO) {
-            result.first = -result.first;
-        } else {
-            result.first = -result.first - 1;
-            result.second = denominator - result.second;
+        // multiply and subtract qhat * vn from un[j..j+n]
+        int64_t borrow = 0;
+        uint64_t carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t p = qhat * vn[i] + carry;
+            carry = p >> 32;
+            int64_t t = (int64_t) un[i + j] - (int64_t) (uint32_t) p - borrow;
+            un[i + j] = (uint32_t) t;
+            borrow = t < 0 ? 1 : 0;
         }
-        return result;
-    } else {
-        // TODO: implement a proper division algorithm
-        error("Denominator too large to divide: " + denominator.toString());
+        int64_t t = (int64_t) un[j + n] - (int64_t) carry - borrow;
+        un[j + n] = (uint32_t) t;
+
+        if (t < 0) {
+            // qhat was one too large; add the divisor back
+            qhat--;
+            uint64_t c = 0;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t sum = (uint64_t) un[i + j] + vn[i] + c;
+                un[i + j] = (uint32_t) sum;
+                c = sum >> 32;
+            }
+            un[j + n] = (uint32_t) (un[j + n] + c);
+        }
+        quotient[j] = (uint32_t) qhat;
     }
+    removeLeadingZeros(quotient);
 
-    // now b1 >= 0 && b2 > 0
-    BigInteger quotient(ZERO);
-    BigInteger remainder(numerator);
-    while (remainder >= denominator) {
-        ++quotient;
-        remainder -= denominator;
+    // un-normalize the remainder
+    remainder.assign(n, 0);
+    for (size_t i = 0; i < n; i++) {
+        remainder[i] = (un[i] >> s) | (s == 0 ? 0 : (uint32_t) ((uint64_t) un[i + 1] << (32 - s)));
     }
-    std::pair<BigInteger, BigInteger> result {quotient, remainder};
-    return result;
+    removeLeadingZeros(remainder);
+}
+
+uint32_t BigInteger::divideSmall(Limbs& a, uint32_t d) {
+    uint64_t rem = 0;
+    for (size_t i = a.size(); i-- > 0; ) {
+        uint64_t cur = (rem << 32) | a[i];
+        a[i] = (uint32_t) (cur / d);
+        rem = cur % d;
+    }
+    removeLeadingZeros(a);
+    return (uint32_t) rem;
 }
 
 bool BigInteger::equals(const BigInteger& n1, const BigInteger& n2) {
-    return n1.getNumber() == n2.getNumber()
-        && n1.getSign() == n2.getSign();
+    return n1.sign == n2.sign && n1.mag == n2.mag;
 }
 
 void BigInteger::fixNegativeZero() {
-    if (number == "0") {
+    if (mag.empty()) {
         // avoid (-0) problem
         sign = false;
     }
 }
 
 BigInteger BigInteger::gcd(const BigInteger& other) const {
-    BigInteger a(*this);
-    BigInteger b(other);
-    while (b != ZERO) {
+    BigInteger a(this->abs());
+    BigInteger b(other.abs());
+    while (b.isPositive()) {
         BigInteger temp(b);
         b = a % b;
-        a = temp;
+        a = std::move(temp);
     }
     return a;
 }
 
-const std::string& BigInteger::getNumber() const {
-    return number;
-}
-
 bool BigInteger::getSign() const {
     return sign;
 }
@@ -221,11 +418,11 @@ bool BigInteger::greater(const BigInteger& n1, const BigInteger& n2) {
 }
 
 bool BigInteger::isInt() const {
-    return stringIsInteger(toString());
+    return MIN_INT <= *this && *this <= MAX_INT;
 }
 
 bool BigInteger::isLong() const {
-    return stringIsLong(toString());
+    return MIN_LONG <= *this && *this <= MAX_LONG;
 }
 
 bool BigInteger::isNegative() const {
@@ -237,38 +434,19 @@ bool BigInteger::isNonNegative() const {
 }
 
 bool BigInteger::isPositive() const {
-    return !sign && number[0] != '0';
+    return !sign && !mag.empty();
 }
 
 bool BigInteger::less(const BigInteger& n1, const BigInteger& n2) {
-    bool sign1 = n1.getSign();
-    bool sign2 = n2.getSign();
-
-    if (sign1 && ! sign2) {
-        // n1 is -ve and n2 is +ve
-        return true;
-    } else if (!sign1 && sign2) {
-        // n1 is +ve and n2 is -ve
-        return false;
-    } else if (!sign1) {
+    if (n1.sign != n2.sign) {
+        // exactly one is negative
+        return n1.sign;
+    } else if (!n1.sign) {
         // both +ve
-        if (n1.getNumber().length() < n2.getNumber().length()) {
-            return true;
-        } else if (n1.getNumber().length() > n2.getNumber().length()) {
-            return false;
-        } else {
-            return n1.getNumber() < n2.getNumber();
-        }
+        return compare(n1.mag, n2.mag) < 0;
     } else {
-        // both -ve
-        if (n1.getNumber().length() > n2.getNumber().length()) {
-            return true;
-        } else if (n1.getNumber().length() < n2.getNumber().length()) {
-            return false;
-        } else {
-            // greater with -ve sign is LESS
-            return n1.getNumber().compare(n2.getNumber()) > 0;
-        }
+        // both -ve; greater magnitude with -ve sign is LESS
+        return compare(n1.mag, n2.mag) > 0;
     }
 }
 
@@ -289,123 +467,129 @@ const BigInteger& BigInteger::min(const BigInteger& other) const {
 }
 
 BigInteger BigInteger::modPow(const BigInteger& exp, const BigInteger& m) const {
-    BigInteger result = ONE;
-    for (BigInteger i = ZERO; i < exp; i++) {
-        result = (result * *this) % m;
-    }
-    return result;
-}
-
-std::string BigInteger::multiply(const std::string& n1, const std::string& n2) {
-    std::string n1copy = n1;
-    std::string n2copy = n2;
-
-    if (n1copy.length() > n2copy.length()) {
-        n1copy.swap(n2copy);
+    if (exp.isNegative()) {
+        error("negative exponent: " + exp.toString());
+    } else if (!m.isPositive()) {
+        error("non-positive modulus: " + m.toString());
     }
 
-    std::string product = "0";
-    for (int i = n1copy.length() - 1; i >= 0; --i) {
-        std::string temp = n2copy;
-        int currentDigit = n1copy[i] - '0';
-        int carry = 0;
-        for (int j = temp.length() - 1; j >= 0; --j) {
-            temp[j] = ((temp[j] - '0') * currentDigit) + carry;
-            if (temp[j] > 9) {
-                carry = (temp[j] / 10);
-                temp[j] -= (carry * 10);
-            } else {
-                carry = 0;
+    // left-to-right binary exponentiation, reducing mod m after every step
+    Limbs quotient;
+    Limbs base;
+    divide(mag, m.mag, quotient, base);
+    bool negativeBase = sign;
+    Limbs result;
+    divide(ONE.mag, m.mag, quotient, result);
+    for (size_t i = exp.mag.size(); i-- > 0; ) {
+        for (int bit = 31; bit >= 0; bit--) {
+            divide(multiply(result, result), m.mag, quotient, result);
+            if ((exp.mag[i] >> bit) & 1) {
+                divide(multiply(result, base), m.mag, quotient, result);
             }
-
-            temp[j] += '0';   // back to string mode
-        }
-
-        if (carry > 0) {
-            temp.insert(0, (size_t) 1, (char) (carry + '0'));
         }
+    }
 
-        // as like mult by 10, 100, 1000, 10000 and so on
-        temp.append((n1copy.length() - i - 1), '0');
-
-        product = add(product, temp);   // O(n)
+    // a negative base raised to an odd power stays negative; bring into [0, m)
+    bool oddExp = !exp.mag.empty() && (exp.mag[0] & 1);
+    if (negativeBase && oddExp && !result.empty()) {
+        result = subtract(m.mag, result);
     }
+    return BigInteger(result, false);
+}
 
-    // erase leading zeros
-    product = removeLeadingZeros(product);
+BigInteger::Limbs BigInteger::multiply(const Limbs& a, const Limbs& b) {
+    if (a.empty() || b.empty()) {
+        return Limbs();
+    }
+    Limbs product(a.size() + b.size());
+    multiplyKaratsuba(a.data(), a.size(), b.data(), b.size(), product.data());
+    removeLeadingZeros(product);
     return product;
 }
 
-std::string BigInteger::padLeft(const std::string& s, int length) {
-    size_t lenS = s.length();
-    if ((int) lenS < length) {
-        // left-pad numbers with 0s to be the same length as needed
-        std::string scopy = s;
-        scopy.insert(0, (length - lenS), '0');
-        return scopy;
-    } else {
-        return s;
+void BigInteger::multiplyAddSmall(Limbs& a, uint32_t m, uint32_t addend) {
+    uint64_t carry = addend;
+    for (size_t i = 0; i < a.size(); i++) {
+        uint64_t t = (uint64_t) a[i] * m + carry;
+        a[i] = (uint32_t) t;
+        carry = t >> 32;
+    }
+    if (carry != 0) {
+        a.push_back((uint32_t) carry);
     }
 }
 
+/*
+ * Implementation notes: parseDecimal
+ * ----------------------------------
+ * Short strings are accumulated nine digits at a time.  Long strings are
+ * split so that value = high * 10^k + low, which lets the Karatsuba multiply
+ * do most of the work instead of a quadratic digit-by-digit loop.
+ */
+BigInteger::Limbs BigInteger::parseDecimal(const std::string& s) {
+    if (s.length() <= DECIMAL_SPLIT_THRESHOLD * DECIMAL_CHUNK_DIGITS) {
+        Limbs result;
+        size_t first = s.length() % DECIMAL_CHUNK_DIGITS;
+        if (first == 0) {
+            first = DECIMAL_CHUNK_DIGITS;
+        }
+        for (size_t i = 0; i < s.length(); ) {
+            size_t len = i == 0 ? first : DECIMAL_CHUNK_DIGITS;
+            uint32_t chunk = 0;
+            uint32_t scale = 1;
+            for (size_t k = 0; k < len; k++) {
+                chunk = chunk * 10 + (uint32_t) (s[i + k] - '0');
+                scale *= 10;
+            }
+            multiplyAddSmall(result, scale, chunk);
+            i += len;
+        }
+        removeLeadingZeros(result);
+        return result;
+    }
+
+    size_t lowDigits = s.length() / 2;
+    Limbs high = parseDecimal(s.substr(0, s.length() - lowDigits));
+    Limbs low = parseDecimal(s.substr(s.length() - lowDigits));
+    Limbs result = multiply(high, TEN.pow((long) lowDigits).mag);
+    return add(result, low);
+}
+
 BigInteger BigInteger::pow(long exp) const {
     if (exp < 0) {
         error("negative exponent: " + longToString(exp));
-    } else if (exp == 0) {
-        return ONE;
-    } else if (exp == 1) {
-        return *this;
     }
-
-    // optimization for even exponents
-    BigInteger thisCopy(*this);
-    BigInteger result(ONE);
-    while (exp > 0) {
-        if (exp % 2 == 0) {
-            thisCopy *= thisCopy;
-            exp /= 2;
-        } else {
-            result *= thisCopy;
-            exp--;
-        }
-    }
-    return result;
+    return pow(BigInteger(exp));
 }
 
 BigInteger BigInteger::pow(const BigInteger& exp) const {
-    if (exp < ZERO) {
+    if (exp.isNegative()) {
         error("negative exponent: " + exp.toString());
-    } else if (exp == ZERO) {
-        return ONE;
-    } else if (exp == ONE) {
-        return *this;
     }
 
-    // optimization for even exponents
-    BigInteger thisCopy(*this);
-    BigInteger expCopy(exp);
-    BigInteger result(ONE);
-    while (expCopy > ZERO) {
-        if (expCopy % TWO == ZERO) {
-            thisCopy *= thisCopy;
-            expCopy /= TWO;
-        } else {
-            result *= thisCopy;
-            expCopy--;
+    // left-to-right binary exponentiation
+    Limbs result(1, 1);
+    bool started = false;
+    for (size_t i = exp.mag.size(); i-- > 0; ) {
+        for (int bit = 31; bit >= 0; bit--) {
+            bool set = (exp.mag[i] >> bit) & 1;
+            if (started) {
+                result = multiply(result, result);
+            }
+            if (set) {
+                result = multiply(result, mag);
+                started = true;
+            }
         }
     }
-    return result;
+    bool oddExp = !exp.mag.empty() && (exp.mag[0] & 1);
+    return BigInteger(result, sign && oddExp);
 }
 
-std::string BigInteger::removeLeadingZeros(const std::string& s) {
-    std::string result = s;
-    while (result[0] == '0' && (int) result.length() > 1) {
-        result.erase(0, 1);
-    }
-    if ((int) result.length() == 0) {
-        result = "0";
+void BigInteger::removeLeadingZeros(Limbs& a) {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
     }
-    return result;
 }
 
 void BigInteger::setValue(const std::string& s, int radix) {
@@ -423,35 +607,40 @@ void BigInteger::setValue(const std::string& s, int radix) {
     fixNegativeZero();
 }
 
-// TODO: throw error on negative/too-large radixes
-
 void BigInteger::setNumber(const std::string& s, int radix) {
+    if (radix <= 0 || radix > 36) {
+        error("Illegal radix value: " + integerToString(radix));
+    }
+
     // accept hex as 0x???, bin as 0b???, oct as 0o???
     std::string scopy = stripNumberPrefix(s, radix);
     checkStringIsNumeric(scopy, radix);
     if (radix == 10) {
-        number = scopy;
-    } else if (scopy == "0") {
-        number = scopy;   // 0 is 0 in any base
+        mag = parseDecimal(scopy);
     } else if (radix == 1) {
-        std::ostringstream out;
-        for (int i = 0; i < radix; i++) {
-            out << '1';
-        }
-        *this = BigInteger(out.str());
+        // unary; the value is the number of 1s
+        mag = BigInteger((long) scopy.length()).mag;
     } else {
-        // convert to base-10 by plucking off a "digit" char,
-        // and adding it to a cumulative sum BigInteger variable
-        BigInteger result(ZERO);
-        BigInteger power(ONE);
-        BigInteger biRadix(integerToString(radix));
-        for (int i = (int) scopy.length() - 1; i >= 0; i--) {
-            std::string ch = scopy.substr(i, 1);
-            int val = stringToInteger(ch, radix);
-            result += power * BigInteger(integerToString(val));
-            power *= biRadix;
+        // accumulate as many digits at a time as fit into one limb
+        uint32_t maxScale = UINT32_MAX / (uint32_t) radix;
+        mag.clear();
+        uint32_t chunk = 0;
+        uint32_t scale = 1;
+        for (size_t i = 0; i < scopy.length(); i++) {
+            char ch = tolower(scopy[i]);
+            uint32_t digit = (uint32_t) (isdigit(ch) ? ch - '0' : ch - 'a' + 10);
+            chunk = chunk * radix + digit;
+            scale *= radix;
+            if (scale > maxScale) {
+                multiplyAddSmall(mag, scale, chunk);
+                chunk = 0;
+                scale = 1;
+            }
         }
-        *this = result;
+        if (scale > 1) {
+            multiplyAddSmall(mag, scale, chunk);
+        }
+        removeLeadingZeros(mag);
     }
     fixNegativeZero();
 }
@@ -461,6 +650,40 @@ void BigInteger::setSign(bool s) {
     fixNegativeZero();
 }
 
+BigInteger::Limbs BigInteger::shiftLeft(const Limbs& a, unsigned int shift) {
+    if (a.empty()) {
+        return Limbs();
+    }
+    size_t limbShift = shift / 32;
+    unsigned int bitShift = shift % 32;
+    Limbs result(a.size() + limbShift + 1, 0);
+    for (size_t i = 0; i < a.size(); i++) {
+        uint64_t v = (uint64_t) a[i] << bitShift;
+        result[i + limbShift] |= (uint32_t) v;
+        result[i + limbShift + 1] |= (uint32_t) (v >> 32);
+    }
+    removeLeadingZeros(result);
+    return result;
+}
+
+BigInteger::Limbs BigInteger::shiftRight(const Limbs& a, unsigned int shift) {
+    size_t limbShift = shift / 32;
+    unsigned int bitShift = shift % 32;
+    if (limbShift >= a.size()) {
+        return Limbs();
+    }
+    Limbs result(a.size() - limbShift);
+    for (size_t i = 0; i < result.size(); i++) {
+        uint64_t v = a[i + limbShift];
+        if (i + limbShift + 1 < a.size()) {
+            v |= (uint64_t) a[i + limbShift + 1] << 32;
+        }
+        result[i] = (uint32_t) (v >> bitShift);
+    }
+    removeLeadingZeros(result);
+    return result;
+}
+
 std::string BigInteger::stripNumberPrefix(const std::string& num, int radix) {
     std::string result;
     if (radix == 2 && (int) num.length() >= 2 && num[0] == '0' && tolower(num[1]) == 'b') {
@@ -472,102 +695,140 @@ std::string BigInteger::stripNumberPrefix(const std::string& num, int radix) {
     } else {
         result = num;
     }
-    result = stringReplace(result, ",", "");
-    result = stringReplace(result, "_", "");
-    result = stringReplace(result, " ", "");
+    result.erase(std::remove_if(result.begin(), result.end(),
+                                [](char ch) { return ch == ',' || ch == '_' || ch == ' '; }),
+                 result.end());
     return result;
 }
 
-std::string BigInteger::subtract(const std::string& n1, const std::string& n2) {
-    // sub variable to store result;
-    // left-pad numbers with 0s to be the same length as needed
-    int digits = (int) (n1.length() > n2.length() ? n1.length() : n2.length());
-    std::string sub = padLeft("", digits);
-    std::string n1copy = padLeft(n1, digits);
-    std::string n2copy = padLeft(n2, digits);
+BigInteger::Limbs BigInteger::subtract(const Limbs& a, const Limbs& b) {
+    Limbs diff(a);
+    subtractFrom(diff.data(), diff.size(), b.data(), b.size());
+    removeLeadingZeros(diff);
+    return diff;
+}
 
-    for (int i = (int) n1copy.length() - 1; i >= 0; --i) {
-        if (n1copy[i] < n2copy[i]) {
-            n1copy[i] += 10;
-            n1copy[i - 1]--;
+/*
+ * Implementation notes: toDecimal
+ * -------------------------------
+ * Small magnitudes are converted by repeated division by 10^9.
+ * Large magnitudes are divided by a power of ten with about half as many
+ * limbs, and the quotient and (zero-padded) remainder are converted
+ * recursively, so that the long divisions are done on large limbs.
+ */
+std::string BigInteger::toDecimal(const Limbs& a) {
+    if (a.empty()) {
+        return "0";
+    }
+    if (a.size() <= DECIMAL_SPLIT_THRESHOLD) {
+        std::string result;
+        Limbs copy(a);
+        while (!copy.empty()) {
+            uint32_t chunk = divideSmall(copy, DECIMAL_CHUNK);
+            for (int i = 0; i < DECIMAL_CHUNK_DIGITS; i++) {
+                result += (char) ('0' + chunk % 10);
+                chunk /= 10;
+            }
+        }
+        while (result.length() > 1 && result[result.length() - 1] == '0') {
+            result.erase(result.length() - 1);
         }
-        sub[i] = ((n1copy[i] - '0') - (n2copy[i] - '0')) + '0';
+        std::reverse(result.begin(), result.end());
+        return result;
     }
 
-    // erase leading zeros
-    sub = removeLeadingZeros(sub);
-
-    return sub;
+    // 10^k has about k * log2(10) / 32 limbs; aim for half of a's limbs
+    long splitDigits = (long) (a.size() * 16 * 0.30102999566398);
+    Limbs quotient;
+    Limbs remainder;
+    divide(a, TEN.pow(splitDigits).mag, quotient, remainder);
+    std::string low = toDecimal(remainder);
+    std::string high = toDecimal(quotient);
+    if (high == "0") {
+        return low;
+    }
+    return high + std::string(splitDigits - low.length(), '0') + low;
 }
 
-long BigInteger::toLong(const std::string& s) {
-    long sum = 0;
-    long prevSum = 0;
-    for (int i = 0; i < (int) s.length(); i++) {
-        prevSum = sum;
-        sum = (sum * 10) + (s[i] - '0');
-        if (sum < prevSum) {
-            error("numeric overflow when converting string to long: \"" + s + "\"");
-        }
+unsigned long BigInteger::toUnsignedLong(const Limbs& a) {
+    if (a.size() * 32 > sizeof(unsigned long) * CHAR_BIT) {
+        error("numeric overflow when converting BigInteger to long");
     }
-    return sum;
+    unsigned long result = 0;
+    for (size_t i = a.size(); i-- > 0; ) {
+        result = (result << 16 << 16) | a[i];
+    }
+    return result;
 }
 
 int BigInteger::toInt() const {
-    return (int) toLong(number);
+    if (!isInt()) {
+        error("numeric overflow when converting BigInteger to int: " + toString());
+    }
+    return (int) toLong();
 }
 
 long BigInteger::toLong() const {
-    return toLong(number);
+    if (!isLong()) {
+        error("numeric overflow when converting BigInteger to long: " + toString());
+    }
+    unsigned long u = toUnsignedLong(mag);
+    return sign ? (long) (0UL - u) : (long) u;
 }
 
 std::string BigInteger::toString(int radix) const {
     if (radix == 10) {
         return std::string(*this);
-    } else if (radix <= 0) {
+    } else if (radix <= 0 || radix > 36) {
         error("Illegal radix value: " + integerToString(radix));
-    } else if (number == "0") {
+    } else if (mag.empty()) {
         return "0";
     } else if (radix == 1) {
-        std::ostringstream out;
-        for (BigInteger i = ZERO; i < *this; i++) {
-            out << "1";
-        }
-        return out.str();
-    } else {
-        // write string (reversed) into an output stream, digit by digit
-        std::ostringstream out;
-        out << std::setbase(radix);
-        BigInteger copy(this->abs());
-        BigInteger biRadix(integerToString(radix));
-        while (copy.isPositive()) {
-            int lastDigit = (copy % biRadix).toInt();
-            out << lastDigit;
-            copy /= biRadix;
-        }
-        if (isNegative()) {
-            out << '-';
-        }
+        // unary; the value is the number of 1s
+        return (sign ? "-" : "") + std::string(toUnsignedLong(mag), '1');
+    }
 
-        // reverse and return the string
-        std::string str = out.str();
-        std::reverse(str.begin(), str.end());
-        return str;
+    // peel off as many digits at a time as fit into one limb
+    uint32_t chunkScale = 1;
+    int chunkDigits = 0;
+    while (chunkScale <= UINT32_MAX / (uint32_t) radix) {
+        chunkScale *= radix;
+        chunkDigits++;
+    }
+    std::string str;
+    Limbs copy(mag);
+    while (!copy.empty()) {
+        uint32_t chunk = divideSmall(copy, chunkScale);
+        for (int i = 0; i < chunkDigits; i++) {
+            str += DIGIT_CHARS[chunk % radix];
+            chunk /= radix;
+        }
+    }
+    while (str.length() > 1 && str[str.length() - 1] == '0') {
+        str.erase(str.length() - 1);
+    }
+    if (isNegative()) {
+        str += '-';
     }
-    return "0";
-}
 
-std::string BigInteger::toString(long n) {
-    std::stringstream ss;
-    std::string temp;
-    ss << n;
-    ss >> temp;
-    return temp;
+    // reverse and return the string
+    std::reverse(str.begin(), str.end());
+    return str;
 }
 
 BigInteger& BigInteger::operator =(const BigInteger& b) {
-    setNumber(b.getNumber());
-    setSign(b.getSign());
+    mag = b.mag;
+    sign = b.sign;
+    return *this;
+}
+
+BigInteger& BigInteger::operator =(BigInteger&& b) {
+    if (this != &b) {
+        mag = std::move(b.mag);
+        sign = b.sign;
+        b.mag.clear();
+        b.sign = false;
+    }
     return *this;
 }
 
@@ -634,45 +895,38 @@ BigInteger& BigInteger::operator ^=(const BigInteger& b) {
 }
 
 BigInteger BigInteger::operator ~() const {
-    std::string s1 = this->toString(2);
-
-    // loop over each bit, performing ~ operation
-    for (int i = 0, len = (int) s1.length(); i < len; i++) {
-        bool b1 = s1[i] == '1';
-        s1[i] = b1 ? '0' : '1';
+    // invert each bit of the magnitude up to and including its highest 1 bit
+    // (the value 0 is treated as the single bit 0, so ~0 is 1)
+    if (mag.empty()) {
+        return ONE;
     }
-    s1 = removeLeadingZeros(s1);
-
-    return BigInteger(s1, 2);
+    Limbs result(mag);
+    for (size_t i = 0; i + 1 < result.size(); i++) {
+        result[i] = ~result[i];
+    }
+    uint32_t top = result.back();
+    uint32_t mask = 0;
+    while (mask < top) {
+        mask = (mask << 1) | 1;
+    }
+    result.back() = ~top & mask;
+    return BigInteger(result, false);
 }
 
 BigInteger BigInteger::operator !() const {
-    if (*this == ZERO) {
+    if (mag.empty()) {
         return ONE;
     } else {
         return ZERO;
     }
 }
 
-BigInteger& BigInteger::operator [](int n) {
-    return *(this + (n * sizeof(BigInteger)));
-}
-
 BigInteger BigInteger::operator -() const {
-    return BigInteger(getNumber(), !getSign());
+    return BigInteger(mag, !sign);
 }
 
-//BigInteger& BigInteger::operator =(const BigInteger& other) {
-//    this->number = other.number;
-//    this->sign = other.sign;
-//}
-
 BigInteger BigInteger::operator <<(unsigned int shift) const {
-    BigInteger result(*this);
-    for (unsigned int i = 0; i < shift; i++) {
-        result *= TWO;
-    }
-    return result;
+    return BigInteger(shiftLeft(mag, shift), sign);
 }
 
 BigInteger& BigInteger::operator <<=(unsigned int shift) {
@@ -681,11 +935,8 @@ BigInteger& BigInteger::operator <<=(unsigned int shift) {
 }
 
 BigInteger BigInteger::operator >>(unsigned int shift) const {
-    BigInteger result(*this);
-    for (unsigned int i = 0; i < shift; i++) {
-        result /= TWO;
-    }
-    return result;
+    // same as dividing by 2^shift, i.e. rounds toward zero
+    return BigInteger(shiftRight(mag, shift), sign);
 }
 
 BigInteger& BigInteger::operator >>=(unsigned int shift) {
@@ -694,17 +945,9 @@ BigInteger& BigInteger::operator >>=(unsigned int shift) {
 }
 
 BigInteger::operator bool() const {
-    return *this != ZERO;
+    return !mag.empty();
 }
 
-//BigInteger::operator double() const {
-//    return (double) toLong();
-//}
-
-//BigInteger::operator float() const {
-//    return (float) toLong();
-//}
-
 BigInteger::operator int() const {
     return toInt();
 }
@@ -715,8 +958,8 @@ BigInteger::operator long() const {
 
 BigInteger::operator std::string() const {
     // if positive, don't print + sign
-    std::string signedString = (getSign()) ? "-" : "";
-    signedString += number;
+    std::string signedString = sign ? "-" : "";
+    signedString += toDecimal(mag);
     return signedString;
 }
 
@@ -725,138 +968,85 @@ std::string bigIntegerToString(const BigInteger& bi, int radix) {
 }
 
 int hashCode(const BigInteger& b) {
-    return hashCode2(b.getNumber(), b.getSign());
+    unsigned hash = hashSeed();
+    for (size_t i = 0; i < b.mag.size(); i++) {
+        hash = hashMultiplier() * hash + b.mag[i];
+    }
+    return hashCode2(int(hash & hashMask()), b.sign);
 }
 
 BigInteger operator +(const BigInteger& b1, const BigInteger& b2) {
-    BigInteger sum;
-    if (b1.getSign() == b2.getSign()) {
+    if (b1.sign == b2.sign) {
         // both +ve or -ve
-        sum.setNumber(BigInteger::add(b1.getNumber(), b2.getNumber()));
-        sum.setSign(b1.getSign());
-    } else {
+        return BigInteger(BigInteger::add(b1.mag, b2.mag), b1.sign);
+    } else if (BigInteger::compare(b1.mag, b2.mag) > 0) {
         // sign different
-        if (b1.abs() > b2.abs()) {
-            sum.setNumber(BigInteger::subtract(b1.getNumber(), b2.getNumber()));
-            sum.setSign(b1.getSign());
-        } else {
-            sum.setNumber(BigInteger::subtract(b2.getNumber(), b1.getNumber()));
-            sum.setSign(b2.getSign());
-        }
-    }
-    if (sum.getNumber() == "0") {
-        // avoid (-0) problem
-        sum.setSign(false);
+        return BigInteger(BigInteger::subtract(b1.mag, b2.mag), b1.sign);
+    } else {
+        return BigInteger(BigInteger::subtract(b2.mag, b1.mag), b2.sign);
     }
-    return sum;
 }
 
 BigInteger operator -(const BigInteger& b1, const BigInteger& b2) {
     // x - y = x + (-y)
-    BigInteger bcopy = b2;
-    bcopy.setSign(!b2.getSign());
-    return b1 + bcopy;
+    return b1 + (-b2);
 }
 
 BigInteger operator *(const BigInteger& b1, const BigInteger& b2) {
-    BigInteger product;
-    product.setNumber(BigInteger::multiply(b1.getNumber(), b2.getNumber()));
-    product.setSign(b1.getSign() != b2.getSign());
-    return product;
+    return BigInteger(BigInteger::multiply(b1.mag, b2.mag), b1.sign != b2.sign);
 }
 
 BigInteger operator /(const BigInteger& b1, const BigInteger& b2) {
-    if (b2 == BigInteger::ZERO) {
+    if (b2.mag.empty()) {
         error("Division by zero");
-    } else if (BigInteger::MIN_LONG <= b2 && b2 <= BigInteger::MAX_LONG) {
-        long den = BigInteger::toLong(b2.getNumber());
-        BigInteger div;
-        div.setNumber(BigInteger::divide(b1.getNumber(), den).first);
-        div.setSign(b1.getSign() != b2.getSign());
-        return div;
     }
-
-    // else large denominator; compute through naive repeated subtraction
-    // (this is not a smart way to do large integer division, but this
-    // library is not meant to be particularly clever or performant)
-    std::pair<BigInteger, BigInteger> result = BigInteger::divideBig(b1, b2);
-    return result.first;
+    BigInteger::Limbs quotient;
+    BigInteger::Limbs remainder;
+    BigInteger::divide(b1.mag, b2.mag, quotient, remainder);
+    return BigInteger(quotient, b1.sign != b2.sign);
 }
 
 BigInteger operator %(const BigInteger& b1, const BigInteger& b2) {
-    if (b2 == BigInteger::ZERO) {
+    if (b2.mag.empty()) {
         error("Division by zero");
-    } else if (BigInteger::MIN_LONG <= b2 && b2 <= BigInteger::MAX_LONG) {
-        long den = BigInteger::toLong(b2.getNumber());
-        BigInteger div;
-        div.setNumber(BigInteger::divide(b1.getNumber(), den).first);
-        div.setSign(b1.getSign() != b2.getSign());
-        return div;
     }
-
-    // else large denominator; compute through naive repeated subtraction
-    // (this is not a smart way to do large integer division, but this
-    // library is not meant to be particularly clever or performant)
-    std::pair<BigInteger, BigInteger> result = BigInteger::divideBig(b1, b2);
-    return result.second;
+    BigInteger::Limbs quotient;
+    BigInteger::Limbs remainder;
+    BigInteger::divide(b1.mag, b2.mag, quotient, remainder);
+    return BigInteger(remainder, b1.sign);
 }
 
 BigInteger operator &(const BigInteger& b1, const BigInteger& b2) {
-    // build same-length binary strings for both numbers
-    std::string s1 = b1.toString(2);
-    std::string s2 = b2.toString(2);
-    int len = (int) (s1.length() > s2.length() ? s1.length() : s2.length());
-    s1 = BigInteger::padLeft(s1, len);
-    s2 = BigInteger::padLeft(s2, len);
-
-    // loop over each bit, performing & operation; store into s1
-    for (int i = 0; i < len; i++) {
-        bool b1 = s1[i] == '1';
-        bool b2 = s2[i] == '1';
-        s1[i] = (b1 && b2) ? '1' : '0';
+    // operates on the magnitudes of both numbers; result is non-negative
+    BigInteger::Limbs result(std::min(b1.mag.size(), b2.mag.size()));
+    for (size_t i = 0; i < result.size(); i++) {
+        result[i] = b1.mag[i] & b2.mag[i];
     }
-    s1 = BigInteger::removeLeadingZeros(s1);
-
-    return BigInteger(s1, 2);
+    return BigInteger(result, false);
 }
 
 BigInteger operator |(const BigInteger& b1, const BigInteger& b2) {
-    // build same-length binary strings for both numbers
-    std::string s1 = b1.toString(2);
-    std::string s2 = b2.toString(2);
-    int len = (int) (s1.length() > s2.length() ? s1.length() : s2.length());
-    s1 = BigInteger::padLeft(s1, len);
-    s2 = BigInteger::padLeft(s2, len);
-
-    // loop over each bit, performing | operation; store into s1
-    for (int i = 0; i < len; i++) {
-        bool b1 = s1[i] == '1';
-        bool b2 = s2[i] == '1';
-        s1[i] = (b1 || b2) ? '1' : '0';
+    // operates on the magnitudes of both numbers; result is non-negative
+    BigInteger::Limbs result(std::max(b1.mag.size(), b2.mag.size()), 0);
+    for (size_t i = 0; i < b1.mag.size(); i++) {
+        result[i] |= b1.mag[i];
     }
-    // don't need to check for leading 0s because | can only make more 1s than before
-    // s1 = removeLeadingZeros(s1);
-
-    return BigInteger(s1, 2);
+    for (size_t i = 0; i < b2.mag.size(); i++) {
+        result[i] |= b2.mag[i];
+    }
+    return BigInteger(result, false);
 }
 
 BigInteger operator ^(const BigInteger& b1, const BigInteger& b2) {
-    // build same-length binary strings for both numbers
-    std::string s1 = b1.toString(2);
-    std::string s2 = b2.toString(2);
-    int len = (int) (s1.length() > s2.length() ? s1.length() : s2.length());
-    s1 = BigInteger::padLeft(s1, len);
-    s2 = BigInteger::padLeft(s2, len);
-
-    // loop over each bit, performing ^ operation; store into s1
-    for (int i = 0; i < len; i++) {
-        bool b1 = s1[i] == '1';
-        bool b2 = s2[i] == '1';
-        s1[i] = (b1 ^ b2) ? '1' : '0';
+    // operates on the magnitudes of both numbers; result is non-negative
+    BigInteger::Limbs result(std::max(b1.mag.size(), b2.mag.size()), 0);
+    for (size_t i = 0; i < b1.mag.size(); i++) {
+        result[i] ^= b1.mag[i];
     }
-    s1 = BigInteger::removeLeadingZeros(s1);
-
-    return BigInteger(s1, 2);
+    for (size_t i = 0; i < b2.mag.size(); i++) {
+        result[i] ^= b2.mag[i];
+    }
+    return BigInteger(result, false);
 }
 
 bool operator ==(const BigInteger& b1, const BigInteger& b2) {
@@ -876,13 +1066,11 @@ bool operator <(const BigInteger& b1, const BigInteger& b2) {
 }
 
 bool operator >=(const BigInteger& b1, const BigInteger& b2) {
-    return BigInteger::equals(b1, b2)
-            || BigInteger::greater(b1, b2);
+    return !BigInteger::less(b1, b2);
 }
 
 bool operator <=(const BigInteger& b1, const BigInteger& b2) {
-    return BigInteger::equals(b1, b2)
-            || BigInteger::less(b1, b2);
+    return !BigInteger::greater(b1, b2);
 }
 
 std::istream& operator >>(std::istream& input, BigInteger& b) {
@@ -895,23 +1083,3 @@ std::istream& operator >>(std::istream& input, BigInteger& b) {
 std::ostream& operator <<(std::ostream& out, const BigInteger& b) {
     return out << std::string(b);
 }
-
-//BigInteger operator +(int n, const BigInteger& b) {
-//    return BigInteger(n) + b;
-//}
-
-//BigInteger operator -(int n, const BigInteger& b) {
-//    return BigInteger(n) - b;
-//}
-
-//BigInteger operator *(int n, const BigInteger& b) {
-//    return BigInteger(n) * b;
-//}
-
-//BigInteger operator /(int n, const BigInteger& b) {
-//    return BigInteger(n) / b;
-//}
-
-//BigInteger operator %(int n, const BigInteger& b) {
-//    return BigInteger(n) % b;
-//}
@@ -20,13 +20,19 @@
  * This code is heavily based on a BigInteger library taken from:
  * https://github.com/panks/BigInteger
  *
- * The implementation stores the big integer as a string of base-10 digits
- * along with a sign bit represented as a bool.
- * In general the operations are not heavily optimized; this class should not
- * be used in situations where performance is critical.
- * Note that better Big Integer libraries exist in other places for more
- * serious work and can be found using your favorite search engine.
+ * The implementation stores the magnitude of the big integer as a vector of
+ * 32-bit limbs in little-endian order (least significant limb first), along
+ * with a sign bit represented as a bool.  The value is only converted to
+ * base-10 digits when it is parsed from or printed to a string.
+ * Multiplication switches from the schoolbook algorithm to Karatsuba's
+ * algorithm once both operands are large; division uses Knuth's Algorithm D;
+ * pow and modPow use binary square-and-multiply.
  *
+ * @version 2026/10/17
+ * - store magnitude as 32-bit limbs rather than a string of decimal digits
+ * - Karatsuba multiplication, Knuth long division, square-and-multiply modPow
+ * - division by any non-zero denominator (not just those in range of long)
+ * - % now returns the remainder (sign of numerator) rather than the quotient
  * @version 2017/10/28
  * - initial version
  */
@@ -35,7 +41,9 @@
 #define _biginteger_h
 
 #include <iostream>
+#include <stdint.h>
 #include <string>
+#include <vector>
 #include "hashcode.h"
 
 class BigInteger {
@@ -74,6 +82,12 @@ public:
      */
     BigInteger(const BigInteger& other);
 
+    /**
+     * Constructs a new big integer by taking over the storage of another
+     * big integer, which is left equal to zero.
+     */
+    BigInteger(BigInteger&& other);
+
     /**
      * Constructs a new big integer set to the given value.
      *
@@ -152,7 +166,9 @@ public:
 
     /**
      * Returns a new BigInteger whose value is (this ^^ exp) % m.
-     * Throws an ErrorException if exp is negative or if m is 0.
+     * The result is always in the range [0, m).
+     * Runs in time proportional to the number of bits in exp.
+     * Throws an ErrorException if exp is negative or if m is not positive.
      */
     BigInteger modPow(const BigInteger& exp, const BigInteger& m) const;
 
@@ -230,17 +246,16 @@ public:
 
     /**
      * Assigns this BigInteger to store the quotient of dividing
-     * itself by the given other BigInteger.
+     * itself by the given other BigInteger, rounded toward zero.
      * Throws an ErrorException if denominator is 0.
-     * Throws an ErrorException if denominator is not within the range of type long.
      */
     BigInteger& operator /=(const BigInteger& b);
 
     /**
      * Assigns this BigInteger to store the remainder of dividing
      * itself by the given other BigInteger.
+     * The remainder has the same sign as the numerator, as with int.
      * Throws an ErrorException if denominator is 0.
-     * Throws an ErrorException if denominator is not within the range of type long.
      */
     BigInteger& operator %=(const BigInteger& b);
 
@@ -279,6 +294,12 @@ public:
      */
     BigInteger& operator =(const BigInteger& other);
 
+    /**
+     * Sets this BigInteger to store the value of the given other big integer,
+     * taking over its storage; the other big integer is left equal to zero.
+     */
+    BigInteger& operator =(BigInteger&& other);
+
     /**
      * Unary negation; returns a new BigInteger that is
      * the negative of this BigInteger.
@@ -348,25 +369,32 @@ public:
 
 private:
     /*
-     * Constructs a new big integer set to the given value,
-     * with optional sign (true=negative, false=positive).
-     *
-     * Example:
-     * BigInteger bi("1234567890123456789", true);   // negative
+     * Magnitude of a big integer: 32-bit limbs, least significant first,
+     * with no high-order zero limbs.  Zero is represented as an empty vector.
      */
-    BigInteger(const std::string& s, bool sin); // "string" constructor
+    typedef std::vector<uint32_t> Limbs;
 
-    // add two big integers as string and return result; used by operator +
-    static std::string add(const std::string& number1, const std::string& number2);
+    /*
+     * Constructs a new big integer with the given magnitude and sign
+     * (true=negative, false=positive).
+     */
+    BigInteger(const Limbs& mag, bool sign);
+
+    // adds two magnitudes and returns result; used by operator +
+    static Limbs add(const Limbs& a, const Limbs& b);
 
     // checks that the given string is in the proper format that it could be
     // interpreted as an integer in the given base; if not, issues an error()
     static void checkStringIsNumeric(const std::string& s, int radix = 10);
 
-    // TODO: make work for big integer division
-    // divide n by den and return result; used by operator /
-    static std::pair<std::string, long> divide(const std::string& n, long den);
-    static std::pair<BigInteger, BigInteger> divideBig(const BigInteger& numer, const BigInteger& denom);
+    // returns -1, 0, or 1 as magnitude a is less than, equal to, or greater than b
+    static int compare(const Limbs& a, const Limbs& b);
+
+    // divides magnitude a by b and stores quotient/remainder; b must be non-zero
+    static void divide(const Limbs& a, const Limbs& b, Limbs& quotient, Limbs& remainder);
+
+    // divides magnitude a in place by small divisor d and returns the remainder
+    static uint32_t divideSmall(Limbs& a, uint32_t d);
 
     // return true if two BigIntegers are equal; used by operator ==
     static bool equals(const BigInteger& n1, const BigInteger& n2);
@@ -374,13 +402,6 @@ private:
     // checks for -0 case and changes to 0
     void fixNegativeZero();
 
-    /*
-     * Returns the number stored by this BigInteger as a string.
-     * If this BigInteger represents a negative number, the sign will be omitted.
-     * Example: "1234567890123456789"
-     */
-    const std::string& getNumber() const; // retrieves the number
-
     /*
      * Returns the sign of this BigInteger; true if negative, false if not.
      */
@@ -392,14 +413,17 @@ private:
     // return true if n1 < n2; used by operator <
     static bool less(const BigInteger& n1, const BigInteger& n2);
 
-    // multiply two big integers as string and return result; used by operator *
-    static std::string multiply(const std::string& n1, const std::string& n2);
+    // multiplies two magnitudes and returns result; used by operator *
+    static Limbs multiply(const Limbs& a, const Limbs& b);
+
+    // sets a = a * m + addend in place, for small m and addend
+    static void multiplyAddSmall(Limbs& a, uint32_t m, uint32_t addend);
 
-    // pads left side with 0s until s reaches given length
-    static std::string padLeft(const std::string& s, int length);
+    // converts a string of base-10 digits into a magnitude
+    static Limbs parseDecimal(const std::string& s);
 
-    // removes leading 0s except one from given number
-    static std::string removeLeadingZeros(const std::string& s);
+    // removes high-order zero limbs so that the magnitude is normalized
+    static void removeLeadingZeros(Limbs& a);
 
     /*
      * Sets the number and the sign stored by this BigInteger.
@@ -417,20 +441,21 @@ private:
      */
     void setSign(bool s);
 
+    // shifts magnitude left/right by given number of bits
+    static Limbs shiftLeft(const Limbs& a, unsigned int shift);
+    static Limbs shiftRight(const Limbs& a, unsigned int shift);
+
     // e.g. "0xfff" => "fff"
     static std::string stripNumberPrefix(const std::string& num, int radix = 10);
 
-    // subtract num2 from num1 as string and return result; used by operator -
-    static std::string subtract(const std::string& number1, const std::string& number2);
+    // subtract magnitude b from a and return result; a must be >= b
+    static Limbs subtract(const Limbs& a, const Limbs& b);
 
-    // convert a string value into a long
-    static long toLong(const std::string& s);
+    // converts a magnitude into a string of base-10 digits
+    static std::string toDecimal(const Limbs& a);
 
-    // convert a long value to a string
-    static std::string toString(long n);
-
-    // TODO: remove?
-    BigInteger& operator [](int n);
+    // returns magnitude as an unsigned long, or error()s if too large
+    static unsigned long toUnsignedLong(const Limbs& a);
 
     friend int hashCode(const BigInteger& b);
     friend BigInteger operator +(const BigInteger& b1, const BigInteger& b2);
@@ -451,8 +476,8 @@ private:
     friend std::ostream& operator <<(std::ostream& out, const BigInteger& b);
 
     // member variables
-    std::string number;   // string representation of this big integer in base-10, e.g. "1234567890123456789"
-    bool sign;            // true if number is negative
+    Limbs mag;   // magnitude of this big integer in base 2^32, least significant limb first
+    bool sign;   // true if number is negative
 };
 
 /*
@@ -487,17 +512,16 @@ BigInteger operator *(const BigInteger& b1, const BigInteger& b2);
 
 /**
  * Returns a new BigInteger that is the quotient of dividing
- * this BigInteger by the given other BigInteger.
+ * this BigInteger by the given other BigInteger, rounded toward zero.
  * Throws an ErrorException if denominator is 0.
- * Throws an ErrorException if denominator is not within the range of type long.
  */
 BigInteger operator /(const BigInteger& b1, const BigInteger& b2);
 
 /**
  * Returns a new BigInteger that is the remainder of dividing
  * this BigInteger by the given other BigInteger.
+ * The remainder has the same sign as the numerator, as with int.
  * Throws an ErrorException if denominator is 0.
- * Throws an ErrorException if denominator is not within the range of type long.
  */
 BigInteger operator %(const BigInteger& b1, const BigInteger& b2);
 
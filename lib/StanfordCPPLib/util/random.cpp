@@ -3,6 +3,8 @@
  * ----------------
  * This file implements the random.h interface.
  * 
+ * @version 2026/10/17
+ * - added RandomGenerator and getThreadRandomGenerator
  * @version 2017/10/05
  * - added randomFeedClear
  * @version 2017/09/28
@@ -19,10 +21,13 @@
  */
 
 #include "random.h"
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <cmath>
 #include <ctime>
 #include <queue>
+#include "error.h"
 #include "private/static.h"
 
 /* Private function prototype */
@@ -175,3 +180,159 @@ static void initRandomSeed() {
         _initialized = true;
     }
 }
+
+/*
+ * Implementation notes: RandomGenerator
+ * -------------------------------------
+ * The generator is xoshiro256** by Blackman and Vigna, which passes the
+ * usual statistical test suites and needs only a few shifts, rotates and
+ * multiplies per 64-bit output.  Seeds are spread across its 256 bits of
+ * state with splitmix64, as its authors recommend, and separate streams
+ * are made with its jump function, which advances the state by 2^128 steps.
+ */
+
+static std::uint64_t splitMix64(std::uint64_t& x) {
+    std::uint64_t z = (x += UINT64_C(0x9e3779b97f4a7c15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+static inline std::uint64_t rotateLeft(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+RandomGenerator::RandomGenerator() {
+    std::uint64_t seed = (std::uint64_t) std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    seed ^= reinterpret_cast<uintptr_t>(this) * UINT64_C(0x9e3779b97f4a7c15);
+    setSeed(seed);
+}
+
+RandomGenerator::RandomGenerator(std::uint64_t seed, int stream) {
+    setSeed(seed, stream);
+}
+
+void RandomGenerator::fillIntegers(int* values, int count, int low, int high) {
+    if (low > high) {
+        error("RandomGenerator::fillIntegers: low cannot be greater than high");
+    }
+    std::uint64_t range = (std::uint64_t) ((std::int64_t) high - low) + 1;
+    if (range > UINT64_C(0xffffffff)) {
+        for (int i = 0; i < count; i++) {
+            values[i] = (int) ((std::int64_t) low + (std::int64_t) (next() >> 32));
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            values[i] = (int) ((std::int64_t) low + nextBounded((unsigned int) range));
+        }
+    }
+}
+
+void RandomGenerator::fillReals(double* values, int count, double low, double high) {
+    for (int i = 0; i < count; i++) {
+        values[i] = nextReal(low, high);
+    }
+}
+
+std::uint64_t RandomGenerator::next() {
+    std::uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+    std::uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotateLeft(state[3], 45);
+    return result;
+}
+
+bool RandomGenerator::nextBool() {
+    return (next() >> 63) != 0;
+}
+
+bool RandomGenerator::nextChance(double p) {
+    return nextReal(0, 1) < p;
+}
+
+int RandomGenerator::nextInteger(int low, int high) {
+    if (low > high) {
+        error("RandomGenerator::nextInteger: low cannot be greater than high");
+    }
+    std::uint64_t range = (std::uint64_t) ((std::int64_t) high - low) + 1;
+    if (range > UINT64_C(0xffffffff)) {
+        // the whole int range; any 32 bits will do
+        return (int) ((std::int64_t) low + (std::int64_t) (next() >> 32));
+    }
+    return (int) ((std::int64_t) low + nextBounded((unsigned int) range));
+}
+
+/*
+ * Implementation notes: nextReal
+ * ------------------------------
+ * The top 53 bits of a random number, scaled by 2^-53, give a double that
+ * is uniformly distributed over [0 .. 1) with every representable step.
+ */
+double RandomGenerator::nextReal(double low, double high) {
+    double d = (double) (next() >> 11) * (1.0 / 9007199254740992.0);
+    return low + d * (high - low);
+}
+
+void RandomGenerator::setSeed(std::uint64_t seed, int stream) {
+    if (stream < 0) {
+        error("RandomGenerator::setSeed: stream cannot be negative");
+    }
+    for (int i = 0; i < 4; i++) {
+        state[i] = splitMix64(seed);
+    }
+    for (int i = 0; i < stream; i++) {
+        jump();
+    }
+}
+
+/*
+ * Implementation notes: nextBounded
+ * ---------------------------------
+ * Lemire's method: multiplying a random 32-bit number by the range gives a
+ * 64-bit product whose high half is a number in [0 .. range).  It is
+ * slightly biased only when the low half lands in the first
+ * (2^32 mod range) values, so those rare cases are rejected and redrawn.
+ * The expensive modulus is only computed when a rejection is possible.
+ */
+unsigned int RandomGenerator::nextBounded(unsigned int range) {
+    std::uint64_t product = (next() >> 32) * range;
+    unsigned int low = (unsigned int) product;
+    if (low < range) {
+        unsigned int threshold = (0u - range) % range;
+        while (low < threshold) {
+            product = (next() >> 32) * range;
+            low = (unsigned int) product;
+        }
+    }
+    return (unsigned int) (product >> 32);
+}
+
+void RandomGenerator::jump() {
+    static const std::uint64_t JUMP[] = {
+        UINT64_C(0x180ec6d33cfd0aba), UINT64_C(0xd5a61266f0c9392c),
+        UINT64_C(0xa9582618e03fc9aa), UINT64_C(0x39abdc4529b1661c)
+    };
+    std::uint64_t s[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (JUMP[i] & (UINT64_C(1) << b)) {
+                for (int j = 0; j < 4; j++) {
+                    s[j] ^= state[j];
+                }
+            }
+            next();
+        }
+    }
+    for (int j = 0; j < 4; j++) {
+        state[j] = s[j];
+    }
+}
+
+RandomGenerator& getThreadRandomGenerator() {
+    static thread_local RandomGenerator generator;
+    return generator;
+}
@@ -3,6 +3,8 @@
  * --------------
  * This file exports functions for generating pseudorandom numbers.
  * 
+ * @version 2026/10/17
+ * - added RandomGenerator and getThreadRandomGenerator
  * @version 2017/10/05
  * - added randomFeedClear
  * @version 2017/09/28
@@ -16,6 +18,7 @@
 #ifndef _random_h
 #define _random_h
 
+#include <cstdint>
 #include <string>
 
 /*
@@ -88,6 +91,143 @@ double randomReal(double low, double high);
  */
 void setRandomSeed(int seed);
 
+/*
+ * Class: RandomGenerator
+ * ----------------------
+ * This class is a fast, self-contained pseudorandom number generator
+ * (xoshiro256**) for code that needs a lot of random numbers, or needs
+ * several independent, repeatable streams of them, such as one per thread.
+ * Unlike the functions above, it has no shared state and ignores the
+ * autograder's fed values, so separate generators can be used from separate
+ * threads at the same time.
+ *
+ * Bounded integers are exactly uniform (using Lemire's multiply-and-reject
+ * method), and the fill methods generate whole arrays of values at once.
+ *
+ *<pre>
+ *    RandomGenerator gen(seed, threadIndex);   // same numbers on every run
+ *    int die = gen.nextInteger(1, 6);
+ *</pre>
+ */
+class RandomGenerator {
+public:
+    /*
+     * Constructor: RandomGenerator
+     * Usage: RandomGenerator gen;
+     *        RandomGenerator gen(seed, stream);
+     * -----------------------------------------
+     * Creates a generator.  With no arguments, it is seeded from the clock
+     * and its own address, so every generator gives different numbers.
+     * Otherwise it is seeded as described in <code>setSeed</code>.
+     */
+    RandomGenerator();
+    RandomGenerator(std::uint64_t seed, int stream = 0);
+
+    /*
+     * Method: fillIntegers
+     * Usage: gen.fillIntegers(values, count, low, high);
+     * --------------------------------------------------
+     * Stores <code>count</code> random integers in the range
+     * <code>low</code> to <code>high</code>, inclusive, into the array
+     * <code>values</code>.  This gives the same numbers as calling
+     * <code>nextInteger</code> that many times, only faster.
+     */
+    void fillIntegers(int* values, int count, int low, int high);
+
+    /*
+     * Method: fillReals
+     * Usage: gen.fillReals(values, count, low, high);
+     * -----------------------------------------------
+     * Stores <code>count</code> random real numbers in the half-open interval
+     * [<code>low</code>&nbsp;..&nbsp;<code>high</code>) into the array
+     * <code>values</code>.
+     */
+    void fillReals(double* values, int count, double low, double high);
+
+    /*
+     * Method: jump
+     * Usage: gen.jump();
+     * ------------------
+     * Skips ahead 2^128 numbers, in about the time it takes to generate 256.
+     * A generator on stream <i>k</i> of a seed moves to stream <i>k</i>+1,
+     * so a thread that needs streams in increasing order can jump one
+     * generator forward instead of starting each stream from scratch.
+     */
+    void jump();
+
+    /*
+     * Method: next
+     * Usage: std::uint64_t bits = gen.next();
+     * ---------------------------------------
+     * Returns the next 64 random bits.
+     */
+    std::uint64_t next();
+
+    /*
+     * Method: nextBool
+     * Usage: if (gen.nextBool()) ...
+     * -------------------------------
+     * Returns <code>true</code> with 50% probability.
+     */
+    bool nextBool();
+
+    /*
+     * Method: nextChance
+     * Usage: if (gen.nextChance(p)) ...
+     * ---------------------------------
+     * Returns <code>true</code> with probability <code>p</code>, which
+     * must be between 0 and 1.
+     */
+    bool nextChance(double p);
+
+    /*
+     * Method: nextInteger
+     * Usage: int n = gen.nextInteger(low, high);
+     * ------------------------------------------
+     * Returns a random integer in the range <code>low</code> to
+     * <code>high</code>, inclusive.  Every value in the range is exactly
+     * equally likely.  Signals an error if <code>low</code> is greater
+     * than <code>high</code>.
+     */
+    int nextInteger(int low, int high);
+
+    /*
+     * Method: nextReal
+     * Usage: double d = gen.nextReal(low, high);
+     * ------------------------------------------
+     * Returns a random real number in the half-open interval
+     * [<code>low</code>&nbsp;..&nbsp;<code>high</code>).
+     */
+    double nextReal(double low, double high);
+
+    /*
+     * Method: setSeed
+     * Usage: gen.setSeed(seed, stream);
+     * ---------------------------------
+     * Restarts the generator from the given seed.  Generators with the same
+     * seed and different <code>stream</code> numbers give sequences that
+     * are guaranteed not to overlap for 2^128 numbers, which makes them
+     * suitable for giving each thread of a parallel job its own repeatable
+     * stream.  Choosing stream <i>k</i> takes time proportional to <i>k</i>.
+     */
+    void setSeed(std::uint64_t seed, int stream = 0);
+
+private:
+    unsigned int nextBounded(unsigned int range);
+
+    std::uint64_t state[4];
+};
+
+/*
+ * Function: getThreadRandomGenerator
+ * Usage: RandomGenerator& gen = getThreadRandomGenerator();
+ * --------------------------------------------------------
+ * Returns a generator that belongs to the calling thread.  Each thread's
+ * generator starts out seeded differently; call <code>setSeed</code> on it
+ * to make the thread's numbers repeatable.
+ */
+RandomGenerator& getThreadRandomGenerator();
+
 // extra functions to facilitate creation of autograder programs
 namespace autograder {
 /*
@@ -3,6 +3,11 @@
  * ----------------
  * This file implements the strlib.h interface.
  * 
+ * @version 2026/10/17
+ * - numeric conversions parse plain decimal strings without a stringstream
+ *   (std::from_chars in C++17, strtol/strtod otherwise)
+ * - stringSplit and trim functions no longer copy or erase repeatedly
+ * - added stringSplitView and trimView functions (C++17)
  * @version 2017/10/24
  * - print nullptr instead of null in uppercase
  * @version 2016/11/07
@@ -36,12 +41,142 @@
 
 #include "strlib.h"
 #include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
 #include "error.h"
 
-/* Function prototypes */
+/*
+ * Implementation notes: fast numeric parsing
+ * ------------------------------------------
+ * Almost every string passed to stringToInteger and friends (for example,
+ * the results sent back by the Java back-end) is a plain decimal number.
+ * For those we parse the trimmed characters in place; anything else (other
+ * radixes, hex prefixes, "inf", out-of-range values, malformed input) goes
+ * through the original istringstream code, so the results and error
+ * behavior are exactly what they have always been.
+ */
+
+/* Finds the range of str left after trimming whitespace from both ends. */
+static void trimBounds(const std::string& str, const char*& begin, const char*& end) {
+    begin = str.data();
+    end = begin + str.length();
+    while (end > begin && isspace(end[-1])) {
+        end--;
+    }
+    while (begin < end && isspace(*begin)) {
+        begin++;
+    }
+}
+
+/* Returns true if [begin, end) is an optional sign followed by decimal digits. */
+static bool isPlainInteger(const char* begin, const char* end) {
+    if (begin < end && (*begin == '+' || *begin == '-')) {
+        begin++;
+    }
+    if (begin == end) {
+        return false;
+    }
+    for (; begin < end; begin++) {
+        if (*begin < '0' || *begin > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Returns true if [begin, end) looks like [sign] digits [. digits] [e [sign] digits]. */
+static bool isPlainReal(const char* begin, const char* end) {
+    if (begin < end && (*begin == '+' || *begin == '-')) {
+        begin++;
+    }
+    bool digits = false;
+    while (begin < end && *begin >= '0' && *begin <= '9') {
+        begin++;
+        digits = true;
+    }
+    if (begin < end && *begin == '.') {
+        begin++;
+        while (begin < end && *begin >= '0' && *begin <= '9') {
+            begin++;
+            digits = true;
+        }
+    }
+    if (!digits) {
+        return false;
+    }
+    if (begin < end && (*begin == 'e' || *begin == 'E')) {
+        begin++;
+        if (begin < end && (*begin == '+' || *begin == '-')) {
+            begin++;
+        }
+        if (begin == end) {
+            return false;
+        }
+        while (begin < end && *begin >= '0' && *begin <= '9') {
+            begin++;
+        }
+    }
+    return begin == end;
+}
+
+/*
+ * Parses a plain decimal integer in [begin, end) into a long.
+ * Returns false if it is not plain decimal or does not fit; the caller
+ * then falls back to the stream-based parse.
+ */
+static bool parsePlainLong(const char* begin, const char* end, long& value) {
+    if (!isPlainInteger(begin, end)) {
+        return false;
+    }
+    if (*begin == '+') {
+        begin++;
+    }
+#if __cplusplus >= 201703L
+    std::from_chars_result result = std::from_chars(begin, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+#else
+    // end is followed by whitespace or the string's null terminator
+    char* stop;
+    errno = 0;
+    value = strtol(begin, &stop, 10);
+    return errno == 0 && stop == end;
+#endif
+}
+
+static bool parsePlainInteger(const char* begin, const char* end, int& value) {
+    long result;
+    if (!parsePlainLong(begin, end, result) || result < INT_MIN || result > INT_MAX) {
+        return false;
+    }
+    value = (int) result;
+    return true;
+}
+
+static bool parsePlainReal(const char* begin, const char* end, double& value) {
+    if (!isPlainReal(begin, end)) {
+        return false;
+    }
+    if (*begin == '+') {
+        begin++;
+    }
+#if defined(__cpp_lib_to_chars)
+    std::from_chars_result result = std::from_chars(begin, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+#else
+    char* stop;
+    errno = 0;
+    value = strtod(begin, &stop);
+    return errno == 0 && stop == end && !std::isinf(value);
+#endif
+}
 
 std::string boolToString(bool b) {
     return (b ? "true" : "false");
@@ -199,6 +334,13 @@ bool stringIsInteger(const std::string& str, int radix) {
     if (radix <= 0) {
         error("stringIsInteger: Illegal radix: " + integerToString(radix));
     }
+    const char* begin;
+    const char* end;
+    trimBounds(str, begin, end);
+    int fast;
+    if (radix == 10 && parsePlainInteger(begin, end, fast)) {
+        return true;
+    }
     std::istringstream stream(trim(str));
     stream >> std::setbase(radix);
     int value;
@@ -210,6 +352,13 @@ bool stringIsLong(const std::string& str, int radix) {
     if (radix <= 0) {
         error("stringIsLong: Illegal radix: " + integerToString(radix));
     }
+    const char* begin;
+    const char* end;
+    trimBounds(str, begin, end);
+    long fast;
+    if (radix == 10 && parsePlainLong(begin, end, fast)) {
+        return true;
+    }
     std::istringstream stream(trim(str));
     stream >> std::setbase(radix);
     long value;
@@ -218,6 +367,13 @@ bool stringIsLong(const std::string& str, int radix) {
 }
 
 bool stringIsReal(const std::string& str) {
+    const char* begin;
+    const char* end;
+    trimBounds(str, begin, end);
+    double fast;
+    if (parsePlainReal(begin, end, fast)) {
+        return true;
+    }
     std::istringstream stream(trim(str));
     double value;
     stream >> value;
@@ -335,21 +491,21 @@ std::vector<std::string> stringSplit(const std::string& str, char delimiter, int
 }
 
 std::vector<std::string> stringSplit(const std::string& str, const std::string& delimiter, int limit) {
-    std::string str2 = str;
     std::vector<std::string> result;
     int count = 0;
-    size_t index = 0;
-    while (limit < 0 || count < limit) {
-        index = str2.find(delimiter);
+    size_t start = 0;
+    // (an empty delimiter would match forever, so only split on it with a limit)
+    while (limit < 0 ? !delimiter.empty() : count < limit) {
+        size_t index = str.find(delimiter, start);
         if (index == std::string::npos) {
             break;
         }
-        result.push_back(str2.substr(0, index));
-        str2.erase(str2.begin(), str2.begin() + index + delimiter.length());
+        result.push_back(str.substr(start, index - start));
+        start = index + delimiter.length();
         count++;
     }
-    if ((int) str2.length() > 0) {
-        result.push_back(str2);
+    if (start < str.length()) {
+        result.push_back(str.substr(start));
     }
 
     return result;
@@ -386,6 +542,13 @@ int stringToInteger(const std::string& str, int radix) {
     if (radix <= 0) {
         error("stringToInteger: Illegal radix: " + integerToString(radix));
     }
+    const char* begin;
+    const char* end;
+    trimBounds(str, begin, end);
+    int fast;
+    if (radix == 10 && parsePlainInteger(begin, end, fast)) {
+        return fast;
+    }
     std::istringstream stream(trim(str));
     stream >> std::setbase(radix);
     int value;
@@ -400,6 +563,13 @@ long stringToLong(const std::string& str, int radix) {
     if (radix <= 0) {
         error("stringToLong: Illegal radix: " + integerToString(radix));
     }
+    const char* begin;
+    const char* end;
+    trimBounds(str, begin, end);
+    long fast;
+    if (radix == 10 && parsePlainLong(begin, end, fast)) {
+        return fast;
+    }
     std::istringstream stream(trim(str));
     stream >> std::setbase(radix);
     long value;
@@ -411,6 +581,13 @@ long stringToLong(const std::string& str, int radix) {
 }
 
 double stringToReal(const std::string& str) {
+    const char* begin;
+    const char* end;
+    trimBounds(str, begin, end);
+    double fast;
+    if (parsePlainReal(begin, end, fast)) {
+        return fast;
+    }
     std::istringstream stream(trim(str));
     double value;
     stream >> value;
@@ -455,9 +632,10 @@ void toUpperCaseInPlace(std::string& str) {
 }
 
 std::string trim(const std::string& str) {
-    std::string str2 = str;
-    trimInPlace(str2);
-    return str2;
+    const char* begin;
+    const char* end;
+    trimBounds(str, begin, end);
+    return std::string(begin, end);
 }
 
 void trimInPlace(std::string& str) {
@@ -466,9 +644,11 @@ void trimInPlace(std::string& str) {
 }
 
 std::string trimEnd(const std::string& str) {
-    std::string str2 = str;
-    trimEndInPlace(str2);
-    return str2;
+    int finish = (int) str.length();
+    while (finish > 0 && isspace(str[finish - 1])) {
+        finish--;
+    }
+    return str.substr(0, finish);
 }
 
 void trimEndInPlace(std::string& str) {
@@ -483,9 +663,12 @@ void trimEndInPlace(std::string& str) {
 }
 
 std::string trimStart(const std::string& str) {
-    std::string str2 = str;
-    trimStartInPlace(str2);
-    return str2;
+    int start = 0;
+    int length = (int) str.length();
+    while (start < length && isspace(str[start])) {
+        start++;
+    }
+    return str.substr(start);
 }
 
 void trimStartInPlace(std::string& str) {
@@ -560,6 +743,144 @@ void urlEncodeInPlace(std::string& str) {
     str = urlEncode(str);   // no real efficiency gain here
 }
 
+#if __cplusplus >= 201703L
+StringSplitRange::StringSplitRange(std::string_view str, std::string_view delimiter, int limit)
+        : m_str(str),
+          m_delimiter(delimiter),
+          m_delimiterChar('\0'),
+          m_isCharDelimiter(false),
+          m_limit(limit) {
+    // empty
+}
+
+StringSplitRange::StringSplitRange(std::string_view str, char delimiter, int limit)
+        : m_str(str),
+          m_delimiterChar(delimiter),
+          m_isCharDelimiter(true),
+          m_limit(limit) {
+    // empty
+}
+
+StringSplitRange::iterator StringSplitRange::begin() const {
+    return iterator(this, false);
+}
+
+StringSplitRange::iterator StringSplitRange::end() const {
+    return iterator(this, true);
+}
+
+size_t StringSplitRange::delimiterLength() const {
+    return m_isCharDelimiter ? 1 : m_delimiter.length();
+}
+
+size_t StringSplitRange::findDelimiter(size_t start) const {
+    if (m_isCharDelimiter) {
+        return m_str.find(m_delimiterChar, start);
+    } else if (m_delimiter.empty() && m_limit < 0) {
+        // as in stringSplit, an empty delimiter would match forever
+        return std::string_view::npos;
+    } else {
+        return m_str.find(m_delimiter, start);
+    }
+}
+
+StringSplitRange::iterator::iterator(const StringSplitRange* range, bool atEnd)
+        : m_range(range),
+          m_start(0),
+          m_next(0),
+          m_count(0),
+          m_last(false),
+          m_done(atEnd) {
+    if (!m_done) {
+        advance();
+    }
+}
+
+std::string_view StringSplitRange::iterator::operator *() const {
+    return m_piece;
+}
+
+const std::string_view* StringSplitRange::iterator::operator ->() const {
+    return &m_piece;
+}
+
+StringSplitRange::iterator& StringSplitRange::iterator::operator ++() {
+    if (m_last) {
+        m_done = true;
+    } else {
+        m_start = m_next;
+        advance();
+    }
+    return *this;
+}
+
+StringSplitRange::iterator StringSplitRange::iterator::operator ++(int) {
+    iterator copy(*this);
+    operator ++();
+    return copy;
+}
+
+bool StringSplitRange::iterator::operator ==(const iterator& other) const {
+    return m_range == other.m_range && m_done == other.m_done
+            && (m_done || (m_start == other.m_start && m_count == other.m_count));
+}
+
+bool StringSplitRange::iterator::operator !=(const iterator& other) const {
+    return !(*this == other);
+}
+
+/*
+ * Finds the piece that starts at m_start: the text up to the next delimiter
+ * if we have not yet reached the limit, otherwise the rest of the string
+ * (which, as in stringSplit, is only a piece if it is not empty).
+ */
+void StringSplitRange::iterator::advance() {
+    const std::string_view& str = m_range->m_str;
+    size_t index = std::string_view::npos;
+    if (m_range->m_limit < 0 || m_count < m_range->m_limit) {
+        index = m_range->findDelimiter(m_start);
+    }
+    if (index != std::string_view::npos) {
+        m_piece = str.substr(m_start, index - m_start);
+        m_next = index + m_range->delimiterLength();
+        m_count++;
+    } else if (m_start < str.length()) {
+        m_piece = str.substr(m_start);
+        m_last = true;
+    } else {
+        m_done = true;
+    }
+}
+
+StringSplitRange stringSplitView(std::string_view str, char delimiter, int limit) {
+    return StringSplitRange(str, delimiter, limit);
+}
+
+StringSplitRange stringSplitView(std::string_view str, std::string_view delimiter, int limit) {
+    return StringSplitRange(str, delimiter, limit);
+}
+
+std::string_view trimView(std::string_view str) {
+    return trimStartView(trimEndView(str));
+}
+
+std::string_view trimEndView(std::string_view str) {
+    size_t finish = str.length();
+    while (finish > 0 && isspace(str[finish - 1])) {
+        finish--;
+    }
+    return str.substr(0, finish);
+}
+
+std::string_view trimStartView(std::string_view str) {
+    size_t start = 0;
+    while (start < str.length() && isspace(str[start])) {
+        start++;
+    }
+    return str.substr(start);
+}
+#endif // __cplusplus >= 201703L
+
 
 /*
  * Implementation notes: readQuotedString and writeQuotedString
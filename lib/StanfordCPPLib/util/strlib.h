@@ -4,6 +4,9 @@
  * This file exports several useful string functions that are not
  * included in the C++ string library.
  * 
+ * @version 2026/10/17
+ * - added stringSplitView and trimView functions returning std::string_view
+ *   (only available when compiling as C++17 or later)
  * @version 2016/11/09
  * - added boolalpha to writeGenericValue (improves bool printing in
  *   collection toString output)
@@ -36,6 +39,10 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#if __cplusplus >= 201703L
+#include <iterator>
+#include <string_view>
+#endif
 
 /*
  * Returns the string "true" if b is true, or "false" if b is false.
@@ -267,6 +274,76 @@ int stringReplaceInPlace(std::string& str, const std::string& old, const std::st
 std::vector<std::string> stringSplit(const std::string& str, char delimiter, int limit = -1);
 std::vector<std::string> stringSplit(const std::string& str, const std::string& delimiter, int limit = -1);
 
+#if __cplusplus >= 201703L
+/*
+ * Class: StringSplitRange
+ * -----------------------
+ * The sequence of pieces returned by stringSplitView.  The pieces are
+ * found one at a time as you iterate over the range, and each one is a
+ * std::string_view into the original string, so nothing is copied.
+ */
+class StringSplitRange {
+public:
+    class iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::string_view value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string_view* pointer;
+        typedef const std::string_view& reference;
+
+        std::string_view operator *() const;
+        const std::string_view* operator ->() const;
+        iterator& operator ++();
+        iterator operator ++(int);
+        bool operator ==(const iterator& other) const;
+        bool operator !=(const iterator& other) const;
+
+    private:
+        iterator(const StringSplitRange* range, bool atEnd);
+        void advance();
+
+        const StringSplitRange* m_range;
+        std::string_view m_piece;   // current piece
+        size_t m_start;             // index where the current piece starts
+        size_t m_next;              // index where the next piece starts
+        int m_count;                // number of delimiters used so far
+        bool m_last;                // true if the current piece is the remainder
+        bool m_done;
+        friend class StringSplitRange;
+    };
+
+    StringSplitRange(std::string_view str, char delimiter, int limit = -1);
+    StringSplitRange(std::string_view str, std::string_view delimiter, int limit = -1);
+
+    iterator begin() const;
+    iterator end() const;
+
+private:
+    size_t delimiterLength() const;
+    size_t findDelimiter(size_t start) const;
+
+    std::string_view m_str;
+    std::string_view m_delimiter;
+    char m_delimiterChar;
+    bool m_isCharDelimiter;
+    int m_limit;
+};
+
+/*
+ * Function: stringSplitView
+ * Usage: for (std::string_view piece : stringSplitView(str, ",")) ...
+ * -------------------------------------------------------------------
+ * Splits str by the given delimiter just as stringSplit does, but lazily
+ * and without copying: the pieces are views into str, which must therefore
+ * outlive the loop.  As with stringSplit, an empty delimiter only splits
+ * the string when a limit is given: the pieces are then that many empty
+ * strings followed by the whole string.
+ */
+StringSplitRange stringSplitView(std::string_view str, char delimiter, int limit = -1);
+StringSplitRange stringSplitView(std::string_view str, std::string_view delimiter, int limit = -1);
+#endif // __cplusplus >= 201703L
+
 /*
  * If str is "true", returns the bool value true.
  * If str is "false", returns the bool value false.
@@ -390,6 +467,19 @@ void trimEndInPlace(std::string& str);
 std::string trimStart(const std::string& str);
 void trimStartInPlace(std::string& str);
 
+#if __cplusplus >= 201703L
+/*
+ * Function: trimView
+ * Usage: std::string_view trimmed = trimView(str);
+ * ------------------------------------------------
+ * Like trim, trimEnd and trimStart, but return a view of the part of the
+ * argument that remains instead of a new string.
+ */
+std::string_view trimView(std::string_view str);
+std::string_view trimEndView(std::string_view str);
+std::string_view trimStartView(std::string_view str);
+#endif // __cplusplus >= 201703L
+
 /*
  * Returns a URL-decoded version of the given string, where any %xx character
  * codes are converted back to the equivalent characters.
@@ -2,15 +2,21 @@
  * File: timer.cpp
  * ---------------
  * Implementation of the Timer class as declared in timer.h.
+ *
+ * @version 2026/10/17
+ * - added nanosecond-resolution elapsedNanos and currentTimeNanos
  */
 
 #include "timer.h"
+#include <chrono>
 #include <sys/time.h>
 #include "error.h"
 
 Timer::Timer(bool autostart) {
     m_startMS = 0;
     m_stopMS = 0;
+    m_startNS = 0;
+    m_stopNS = 0;
     m_isStarted = false;
     if (autostart) {
         start();
@@ -21,20 +27,30 @@ long Timer::elapsed() const {
     return m_stopMS - m_startMS;
 }
 
+std::int64_t Timer::elapsedNanos() const {
+    if (m_isStarted) {
+        return currentTimeNanos() - m_startNS;
+    }
+    return m_stopNS - m_startNS;
+}
+
 bool Timer::isStarted() const {
     return m_isStarted;
 }
 
 void Timer::start() {
     m_startMS = currentTimeMS();
+    m_startNS = currentTimeNanos();
     m_isStarted = true;
 }
 
 long Timer::stop() {
     m_stopMS = currentTimeMS();
+    m_stopNS = currentTimeNanos();
     if (!m_isStarted) {
         // error("Timer is not started");
         m_startMS = m_stopMS;
+        m_startNS = m_stopNS;
     }
     m_isStarted = false;
     return elapsed();
@@ -45,3 +61,8 @@ long Timer::currentTimeMS() {
     gettimeofday(&time, nullptr);
     return (time.tv_sec * 1000000 + time.tv_usec) / 1000;
 }
+
+std::int64_t Timer::currentTimeNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
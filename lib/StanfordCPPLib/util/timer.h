@@ -3,11 +3,16 @@
  * -------------
  * This file exports a Timer class that is useful for measuring the elapsed
  * time of a program in milliseconds over a given interval.
+ *
+ * @version 2026/10/17
+ * - added nanosecond-resolution elapsedNanos and currentTimeNanos
  */
 
 #ifndef _timer_h
 #define _timer_h
 
+#include <cstdint>
+
 class Timer {
 public:
     /*
@@ -23,6 +28,14 @@ public:
      */
     long elapsed() const;
 
+    /*
+     * Returns the number of nanoseconds that have elapsed since this timer
+     * was started, measured on a steady clock that is not affected by changes
+     * to the system time.  If the timer is still running, this is the time
+     * up to now; if it was never started, returns 0.
+     */
+    std::int64_t elapsedNanos() const;
+
     /*
      * Returns true if the timer has been started.
      */
@@ -47,10 +60,19 @@ public:
      */
     static long currentTimeMS();
 
+    /*
+     * A static utility function for getting the current reading of a steady
+     * clock in nanoseconds.  The zero point is arbitrary, so this is only
+     * useful for measuring the time between two readings.
+     */
+    static std::int64_t currentTimeNanos();
+
 private:
     /* instance variables */
     long m_startMS;
     long m_stopMS;
+    std::int64_t m_startNS;
+    std::int64_t m_stopNS;
     bool m_isStarted;
 };
 
@@ -0,0 +1,188 @@
+/*
+ * File: trace.cpp
+ * ---------------
+ * This file implements the trace.h interface.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include "trace.h"
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include "timer.h"
+#include "private/static.h"
+
+namespace {
+
+const int TRACE_CHUNK_SIZE = 4096;
+
+struct TraceRecord {
+    const char* category;
+    const char* name;
+    std::int64_t startNanos;
+    std::int64_t durationNanos;
+};
+
+/*
+ * A block of records.  Only the owning thread writes to a chunk; it fills in
+ * a record and then publishes it by storing the new count with release
+ * ordering, so a reader that loads the count with acquire ordering sees
+ * complete records.
+ */
+struct TraceChunk {
+    TraceRecord records[TRACE_CHUNK_SIZE];
+    std::atomic<int> count;
+    std::atomic<TraceChunk*> next;
+
+    TraceChunk() : count(0), next(nullptr) {
+        // empty
+    }
+};
+
+/*
+ * One thread's records.  Buffers are pushed onto a global lock-free list when
+ * their thread records its first span and are never freed, so the spans of a
+ * thread that has exited can still be written out.
+ */
+struct TraceBuffer {
+    TraceChunk* first;
+    TraceChunk* last;       // only used by the owning thread
+    int threadId;
+    TraceBuffer* next;
+
+    TraceBuffer() : first(new TraceChunk()), last(first), threadId(0), next(nullptr) {
+        // empty
+    }
+};
+
+} // namespace
+
+// atomics can't be copy-initialized, so these rely on static storage
+// being zero-initialized: false, nullptr and 0
+STATIC_VARIABLE_DECLARE_BLANK(std::atomic<bool>, tracingEnabled)
+STATIC_VARIABLE_DECLARE_BLANK(std::atomic<TraceBuffer*>, traceBuffers)
+STATIC_VARIABLE_DECLARE_BLANK(std::atomic<int>, traceThreadCount)
+
+static TraceBuffer* getTraceBuffer() {
+    static thread_local TraceBuffer* buffer = nullptr;
+    if (!buffer) {
+        buffer = new TraceBuffer();
+        buffer->threadId = ++STATIC_VARIABLE(traceThreadCount);
+        std::atomic<TraceBuffer*>& head = STATIC_VARIABLE(traceBuffers);
+        buffer->next = head.load();
+        while (!head.compare_exchange_weak(buffer->next, buffer)) {
+            // buffer->next now holds the current head; try again
+        }
+    }
+    return buffer;
+}
+
+static void writeJsonString(std::ostream& out, const char* str) {
+    out << '"';
+    for (const char* p = str; *p; p++) {
+        char ch = *p;
+        if (ch == '"' || ch == '\\') {
+            out << '\\' << ch;
+        } else if ((unsigned char) ch < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", ch);
+            out << escape;
+        } else {
+            out << ch;
+        }
+    }
+    out << '"';
+}
+
+/*
+ * Writes a time in nanoseconds as the microseconds the trace format expects,
+ * keeping the nanosecond digits.
+ */
+static void writeMicros(std::ostream& out, std::int64_t nanos) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%" PRId64 ".%03" PRId64, nanos / 1000, nanos % 1000);
+    out << buf;
+}
+
+TraceSpan::TraceSpan(const char* category, const char* name)
+        : category(category),
+          name(name),
+          startNanos(-1) {
+    if (STATIC_VARIABLE(tracingEnabled).load(std::memory_order_relaxed)) {
+        startNanos = Timer::currentTimeNanos();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (startNanos < 0) {
+        return;
+    }
+    std::int64_t endNanos = Timer::currentTimeNanos();
+    TraceBuffer* buffer = getTraceBuffer();
+    TraceChunk* chunk = buffer->last;
+    int count = chunk->count.load(std::memory_order_relaxed);
+    if (count == TRACE_CHUNK_SIZE) {
+        TraceChunk* next = new TraceChunk();
+        chunk->next.store(next, std::memory_order_release);
+        buffer->last = chunk = next;
+        count = 0;
+    }
+    TraceRecord& record = chunk->records[count];
+    record.category = category;
+    record.name = name;
+    record.startNanos = startNanos;
+    record.durationNanos = endNanos - startNanos;
+    chunk->count.store(count + 1, std::memory_order_release);
+}
+
+bool isTracingEnabled() {
+    return STATIC_VARIABLE(tracingEnabled).load(std::memory_order_relaxed);
+}
+
+void setTracingEnabled(bool enabled) {
+    STATIC_VARIABLE(tracingEnabled).store(enabled, std::memory_order_relaxed);
+}
+
+void writeTrace(std::ostream& out) {
+    TraceBuffer* buffers = STATIC_VARIABLE(traceBuffers).load(std::memory_order_acquire);
+
+    // times are written relative to the earliest span so that they stay short
+    std::int64_t origin = -1;
+    for (TraceBuffer* buffer = buffers; buffer; buffer = buffer->next) {
+        for (TraceChunk* chunk = buffer->first; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            int count = chunk->count.load(std::memory_order_acquire);
+            for (int i = 0; i < count; i++) {
+                if (origin < 0 || chunk->records[i].startNanos < origin) {
+                    origin = chunk->records[i].startNanos;
+                }
+            }
+        }
+    }
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (TraceBuffer* buffer = buffers; buffer; buffer = buffer->next) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+            << ",\"args\":{\"name\":\"thread " << buffer->threadId << "\"}}";
+        for (TraceChunk* chunk = buffer->first; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            int count = chunk->count.load(std::memory_order_acquire);
+            for (int i = 0; i < count; i++) {
+                const TraceRecord& record = chunk->records[i];
+                out << ",\n{\"name\":";
+                writeJsonString(out, record.name);
+                out << ",\"cat\":";
+                writeJsonString(out, record.category);
+                out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+                writeMicros(out, record.startNanos - origin);
+                out << ",\"dur\":";
+                writeMicros(out, record.durationNanos);
+                out << "}";
+            }
+        }
+    }
+    out << "\n]}" << std::endl;
+}
@@ -0,0 +1,406 @@
+/*
+ * File: chorale-archive.cpp
+ * Name: Victor Lin
+ * -------------------------
+ * This file contains the implementations of the functions defined in chorale-archive.h.
+ *
+ * File layout (all fields are written with writeBits, least significant bit first):
+ *   header:  magic (32 bits), version (8 bits), chorales per chunk (16 bits)
+ *   chunks:  chorale count (16 bits), Rice parameter for each voice (3 bits x 4), then each chorale:
+ *            length (16 bits), major key flag (1 bit), chord degree - 1 (3 bits each),
+ *            and for each voice the first key number (6 bits) followed by Rice-coded deltas
+ *   index:   byte offset of each chunk (32 bits each)
+ *   trailer: byte offset of the index (32 bits), number of chorales (32 bits)
+ */
+
+#include "chorale-archive.h"
+#include <algorithm>
+#include "chorale-constants.h"
+#include "error.h"
+#include "strlib.h"
+
+static const uint32_t ARCHIVE_MAGIC = 0x41524843;   // "CHRA" in file order
+static const int ARCHIVE_VERSION = 1;
+static const int CHORALES_PER_CHUNK = 256;
+static const int KEY_BITS = 6;
+static const int CHORD_BITS = 3;
+static const int LENGTH_BITS = 16;
+static const int RICE_PARAM_BITS = 3;
+static const int MAX_RICE_BITS = 6;     // deltas are at most 2 * SOPRANO_MAX after zigzag encoding
+static const int TRAILER_BYTES = 8;
+static const int N_VOICES = 4;
+
+/**
+ * Function: zigzag
+ * ----------------
+ * These functions map signed distances between notes to unsigned numbers (0, -1, 1, -2, 2, ... become 0, 1, 2, 3, 4, ...) so that small steps in either direction get short codes.
+ */
+
+static inline uint32_t zigzag(int delta) {
+    return delta >= 0 ? (uint32_t) delta * 2 : (uint32_t) (-delta) * 2 - 1;
+}
+
+static inline int unzigzag(uint32_t value) {
+    return (value & 1) ? -(int) ((value + 1) / 2) : (int) (value / 2);
+}
+
+/**
+ * Function: riceCost
+ * ------------------
+ * This function returns how many bits the deltas of a voice take with the given Rice parameter.
+ */
+
+static uint64_t riceCost(const std::vector<int>& voice, int riceBits) {
+    uint64_t bits = 0;
+    for (size_t i = 1; i < voice.size(); ++i) {
+        bits += (zigzag(voice[i] - voice[i - 1]) >> riceBits) + 1 + riceBits;
+    }
+    return bits;
+}
+
+static const std::vector<int>& voiceOf(const Chorale& chorale, int voice) {
+    switch (voice) {
+    case 0: return chorale.soprano;
+    case 1: return chorale.alto;
+    case 2: return chorale.tenor;
+    default: return chorale.bass;
+    }
+}
+
+static std::vector<int>& voiceOf(Chorale& chorale, int voice) {
+    return const_cast<std::vector<int>&>(voiceOf(const_cast<const Chorale&>(chorale), voice));
+}
+
+ChoraleArchiveWriter::ChoraleArchiveWriter(const std::string& filename) : bitsWritten(0), count(0), closed(false) {
+    out.open(filename);
+    if (out.fail()) {
+        error("ChoraleArchiveWriter: unable to create file " + filename);
+    }
+    writeBits(ARCHIVE_MAGIC, 32);
+    writeBits(ARCHIVE_VERSION, 8);
+    writeBits(CHORALES_PER_CHUNK, 16);
+}
+
+ChoraleArchiveWriter::~ChoraleArchiveWriter() {
+    if (!closed) {
+        // a destructor must not throw, so a failure here goes unreported; call close to find out about it
+        try {
+            close();
+        } catch (...) {
+            closed = true;
+        }
+    }
+}
+
+void ChoraleArchiveWriter::add(const Chorale& chorale) {
+    if (closed) {
+        error("ChoraleArchiveWriter::add: archive is already closed");
+    }
+    int length = (int) chorale.chords.size();
+    if (length >= (1 << LENGTH_BITS)) {
+        error("ChoraleArchiveWriter::add: chorale is too long (" + integerToString(length) + " chords)");
+    }
+    for (int chord: chorale.chords) {
+        if (chord < 1 || chord > (1 << CHORD_BITS)) {
+            error("ChoraleArchiveWriter::add: invalid chord degree " + integerToString(chord));
+        }
+    }
+    for (int v = 0; v < N_VOICES; ++v) {
+        const std::vector<int>& voice = voiceOf(chorale, v);
+        if ((int) voice.size() != length) {
+            error("ChoraleArchiveWriter::add: every voice must have one note per chord");
+        }
+        for (int note: voice) {
+            if (note < BASS_MIN || note > SOPRANO_MAX) {
+                error("ChoraleArchiveWriter::add: invalid key number " + integerToString(note));
+            }
+        }
+    }
+    pending.push_back(chorale);
+    ++count;
+    if ((int) pending.size() == CHORALES_PER_CHUNK) {
+        writeChunk();
+    }
+}
+
+void ChoraleArchiveWriter::close() {
+    if (closed) {
+        return;
+    }
+    if (!pending.empty()) {
+        writeChunk();
+    }
+    uint32_t indexOffset = (uint32_t) (bitsWritten / 8);
+    for (uint32_t offset: chunkOffsets) {
+        writeBits(offset, 32);
+    }
+    writeBits(indexOffset, 32);
+    writeBits((uint32_t) count, 32);
+    out.close();
+    closed = true;
+    if (out.fail()) {
+        error("ChoraleArchiveWriter::close: unable to write the archive");
+    }
+}
+
+/**
+ * Method: writeChunk
+ * ------------------
+ * This method writes the pending chorales as one chunk. Every voice gets the Rice parameter that makes it smallest across the whole chunk, and the chunk is padded out to a byte boundary so the index can point at it.
+ */
+
+void ChoraleArchiveWriter::writeChunk() {
+    chunkOffsets.push_back((uint32_t) (bitsWritten / 8));
+    int riceBits[N_VOICES];
+    for (int v = 0; v < N_VOICES; ++v) {
+        uint64_t bestCost = 0;
+        for (int k = 0; k <= MAX_RICE_BITS; ++k) {
+            uint64_t cost = 0;
+            for (const Chorale& chorale: pending) {
+                cost += riceCost(voiceOf(chorale, v), k);
+            }
+            if (k == 0 || cost < bestCost) {
+                bestCost = cost;
+                riceBits[v] = k;
+            }
+        }
+    }
+
+    writeBits(pending.size(), 16);
+    for (int v = 0; v < N_VOICES; ++v) {
+        writeBits(riceBits[v], RICE_PARAM_BITS);
+    }
+    for (const Chorale& chorale: pending) {
+        writeBits(chorale.chords.size(), LENGTH_BITS);
+        writeBits(chorale.majorKey ? 1 : 0, 1);
+        for (int chord: chorale.chords) {
+            writeBits(chord - 1, CHORD_BITS);
+        }
+        for (int v = 0; v < N_VOICES; ++v) {
+            writeVoice(voiceOf(chorale, v), riceBits[v]);
+        }
+    }
+    writeBits(0, (8 - bitsWritten % 8) % 8);
+    pending.clear();
+}
+
+/**
+ * Method: writeVoice
+ * ------------------
+ * This method writes the first note of a voice, then each step as a Rice code: the high bits of the zigzagged delta in unary (that many 1s and a 0), then its low riceBits bits.
+ */
+
+void ChoraleArchiveWriter::writeVoice(const std::vector<int>& voice, int riceBits) {
+    if (voice.empty()) {
+        return;
+    }
+    writeBits(voice[0], KEY_BITS);
+    for (size_t i = 1; i < voice.size(); ++i) {
+        uint32_t value = zigzag(voice[i] - voice[i - 1]);
+        int quotient = value >> riceBits;
+        // a run of 1s followed by a 0; quotient is at most 2 * SOPRANO_MAX, so split long runs
+        while (quotient >= 63) {
+            writeBits(~(uint64_t) 0, 63);
+            quotient -= 63;
+        }
+        writeBits(((uint64_t) 1 << quotient) - 1, quotient + 1);
+        writeBits(value & ((1u << riceBits) - 1), riceBits);
+    }
+}
+
+void ChoraleArchiveWriter::writeBits(uint64_t value, int n) {
+    out.writeBits(value, n);
+    bitsWritten += n;
+}
+
+/*
+ * Chunks are decoded from memory rather than through ibitstream::readBit, because the Rice codes are variable-length and the per-call overhead of the stream would dominate. This reader keeps the same least-significant-bit-first order as bitstream.h, in a 64-bit accumulator that is refilled a byte at a time.
+ */
+class ChunkBitReader {
+public:
+    ChunkBitReader(const std::vector<unsigned char>& bytes)
+        : next(bytes.data()), end(bytes.data() + bytes.size()), bits(0), bitCount(0), overrun(false) {}
+
+    uint32_t read(int n) {
+        if (bitCount < n) {
+            refill();
+            if (bitCount < n) {
+                overrun = true;
+                return 0;
+            }
+        }
+        uint32_t value = (uint32_t) (bits & (((uint64_t) 1 << n) - 1));
+        bits >>= n;
+        bitCount -= n;
+        return value;
+    }
+
+    /* Reads a run of 1 bits and the 0 that ends it, and returns the length of the run. */
+    uint32_t readUnary() {
+        uint32_t run = 0;
+        while (true) {
+            if (bitCount == 0) {
+                refill();
+                if (bitCount == 0) {
+                    overrun = true;
+                    return run;
+                }
+            }
+            uint64_t zeros = ~bits & (bitCount == 64 ? ~(uint64_t) 0 : (((uint64_t) 1 << bitCount) - 1));
+            if (zeros == 0) {
+                run += bitCount;
+                bits = 0;
+                bitCount = 0;
+            } else {
+                int ones = countTrailingZeros(zeros);
+                run += ones;
+                bits = (ones + 1 == 64) ? 0 : (bits >> (ones + 1));
+                bitCount -= ones + 1;
+                return run;
+            }
+        }
+    }
+
+    /* Reads a Rice code: the high bits in unary, then riceBits low bits. */
+    uint32_t readRice(int riceBits) {
+        uint32_t quotient = readUnary();
+        return (quotient << riceBits) | read(riceBits);
+    }
+
+    bool failed() const {
+        return overrun;
+    }
+
+private:
+    void refill() {
+        while (bitCount <= 56 && next < end) {
+            bits |= (uint64_t) *next++ << bitCount;
+            bitCount += 8;
+        }
+    }
+
+    static int countTrailingZeros(uint64_t value) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(value);
+#else
+        int n = 0;
+        while (!(value & 1)) {
+            value >>= 1;
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    const unsigned char* next;
+    const unsigned char* end;
+    uint64_t bits;
+    int bitCount;
+    bool overrun;
+};
+
+ChoraleArchiveReader::ChoraleArchiveReader(const std::string& filename) : indexOffset(0), count(0), choralesPerChunk(0), cachedChunk(-1) {
+    in.open(filename);
+    if (in.fail()) {
+        error("ChoraleArchiveReader: unable to open file " + filename);
+    }
+    long fileSize = in.size();
+    if (fileSize < TRAILER_BYTES || in.readBits(32) != ARCHIVE_MAGIC) {
+        error("ChoraleArchiveReader: " + filename + " is not a chorale archive");
+    }
+    if ((int) in.readBits(8) != ARCHIVE_VERSION) {
+        error("ChoraleArchiveReader: " + filename + " was written by an unsupported version");
+    }
+    choralesPerChunk = (int) in.readBits(16);
+
+    in.seekg(fileSize - TRAILER_BYTES);
+    indexOffset = (uint32_t) in.readBits(32);
+    count = (int) in.readBits(32);
+    int nChunks = choralesPerChunk == 0 ? 0 : (count + choralesPerChunk - 1) / choralesPerChunk;
+    if (in.fail() || choralesPerChunk == 0 || count < 0
+            || (uint64_t) indexOffset + (uint64_t) nChunks * 4 + TRAILER_BYTES != (uint64_t) fileSize) {
+        error("ChoraleArchiveReader: " + filename + " has a damaged chunk index");
+    }
+    in.seekg(indexOffset);
+    for (int i = 0; i < nChunks; ++i) {
+        uint32_t offset = (uint32_t) in.readBits(32);
+        if (offset >= indexOffset || (i > 0 && offset <= chunkOffsets.back())) {
+            error("ChoraleArchiveReader: " + filename + " has a damaged chunk index");
+        }
+        chunkOffsets.push_back(offset);
+    }
+}
+
+int ChoraleArchiveReader::size() const {
+    return count;
+}
+
+Chorale ChoraleArchiveReader::get(int index) {
+    if (index < 0 || index >= count) {
+        error("ChoraleArchiveReader::get: index " + integerToString(index) + " is out of range [0.." + integerToString(count - 1) + "]");
+    }
+    int chunk = index / choralesPerChunk;
+    if (chunk != cachedChunk) {
+        loadChunk(chunk);
+    }
+    return cache[index % choralesPerChunk];
+}
+
+/**
+ * Method: loadChunk
+ * -----------------
+ * This method seeks to a chunk using the index, reads its bytes in one go, and decodes all of its chorales into the cache.
+ */
+
+void ChoraleArchiveReader::loadChunk(int chunk) {
+    cache.clear();
+    cachedChunk = -1;
+    uint32_t chunkEnd = chunk + 1 < (int) chunkOffsets.size() ? chunkOffsets[chunk + 1] : indexOffset;
+    std::vector<unsigned char> bytes(chunkEnd - chunkOffsets[chunk]);
+    in.clear();
+    in.seekg(chunkOffsets[chunk]);
+    in.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+
+    ChunkBitReader reader(bytes);
+    int nChorales = (int) reader.read(16);
+    int riceBits[N_VOICES];
+    for (int v = 0; v < N_VOICES; ++v) {
+        riceBits[v] = (int) reader.read(RICE_PARAM_BITS);
+    }
+    // every chunk is full except possibly the last one
+    int expected = std::min(choralesPerChunk, count - chunk * choralesPerChunk);
+    if (in.fail() || nChorales != expected) {
+        error("ChoraleArchiveReader::get: chunk " + integerToString(chunk) + " is damaged");
+    }
+    cache.resize(nChorales);
+    for (Chorale& chorale: cache) {
+        int length = (int) reader.read(LENGTH_BITS);
+        chorale.majorKey = reader.read(1) != 0;
+        chorale.chords.assign(length, 0);
+        for (int i = 0; i < length; ++i) {
+            chorale.chords[i] = (int) reader.read(CHORD_BITS) + 1;
+        }
+        for (int v = 0; v < N_VOICES; ++v) {
+            readVoice(reader, voiceOf(chorale, v), length, riceBits[v]);
+        }
+    }
+    if (reader.failed()) {
+        cache.clear();
+        error("ChoraleArchiveReader::get: chunk " + integerToString(chunk) + " is truncated");
+    }
+    cachedChunk = chunk;
+}
+
+void ChoraleArchiveReader::readVoice(ChunkBitReader& reader, std::vector<int>& voice, int length, int riceBits) {
+    voice.resize(length);
+    if (length == 0) {
+        return;
+    }
+    int* notes = voice.data();
+    int note = (int) reader.read(KEY_BITS);
+    notes[0] = note;
+    for (int i = 1; i < length; ++i) {
+        note += unzigzag(reader.readRice(riceBits));
+        notes[i] = note;
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * File: chorale-archive.h
+ * Name: Victor Lin
+ * -----------------------
+ * This file defines a compact file format for storing many solved chorales. It is built on the bit streams in bitstream.h.
+ *
+ * Each voice is stored as its first key number (6 bits, since keys go from 0 to 43) followed by the distance from each note to the next one. The distances are small numbers, so they are stored with a Rice code whose parameter is picked separately for every chunk and voice. Chord degrees go from 1 to 8 and take 3 bits each.
+ *
+ * Chorales are grouped into chunks that each start on a byte boundary, and an index of chunk offsets is stored at the end of the file so that any chorale can be read without decoding the ones before its chunk.
+ */
+
+#ifndef CHORALEARCHIVE_H
+#define CHORALEARCHIVE_H
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "bitstream.h"
+
+/*
+ * A solved chorale: the chord degree at each step and the four voices as key numbers. All five sequences have the same length.
+ */
+struct Chorale {
+    bool majorKey;
+    std::vector<int> chords;
+    std::vector<int> soprano;
+    std::vector<int> alto;
+    std::vector<int> tenor;
+    std::vector<int> bass;
+};
+
+class ChunkBitReader;
+
+class ChoraleArchiveWriter {
+public:
+    /**
+     * Constructor: ChoraleArchiveWriter
+     * This constructor creates a new archive file with the given name, replacing any file that is already there.
+     */
+
+    ChoraleArchiveWriter(const std::string& filename);
+
+    /**
+     * Destructor: ~ChoraleArchiveWriter
+     * The destructor closes the archive if close has not been called yet. It does not raise errors, so call close to find out whether the archive was written successfully.
+     */
+
+    ~ChoraleArchiveWriter();
+
+    /**
+     * Method: add
+     * This method adds a chorale to the end of the archive. It raises an error if a key number or chord degree is out of range or if the sequences are different lengths.
+     */
+
+    void add(const Chorale& chorale);
+
+    /**
+     * Method: close
+     * This method writes out the last chunk and the chunk index, then closes the file. It raises an error if the file could not be written. Nothing can be added after the archive is closed.
+     */
+
+    void close();
+
+private:
+    void writeChunk();
+    void writeVoice(const std::vector<int>& voice, int riceBits);
+    void writeBits(uint64_t value, int n);
+
+    ofbitstream out;
+    std::vector<Chorale> pending;       // chorales that will go into the next chunk
+    std::vector<uint32_t> chunkOffsets; // byte offset of each chunk written so far
+    uint64_t bitsWritten;
+    int count;
+    bool closed;
+};
+
+class ChoraleArchiveReader {
+public:
+    /**
+     * Constructor: ChoraleArchiveReader
+     * This constructor opens an existing archive and reads its chunk index. It raises an error if the file is not a chorale archive.
+     */
+
+    ChoraleArchiveReader(const std::string& filename);
+
+    /**
+     * Method: size
+     * This method returns the number of chorales in the archive.
+     */
+
+    int size() const;
+
+    /**
+     * Method: get
+     * This method returns the chorale at the given index. Only the chunk containing it is decoded, and that chunk is kept so reading its neighbors is cheap.
+     */
+
+    Chorale get(int index);
+
+private:
+    void loadChunk(int chunk);
+    void readVoice(ChunkBitReader& reader, std::vector<int>& voice, int length, int riceBits);
+
+    ifbitstream in;
+    std::vector<uint32_t> chunkOffsets; // byte offset of each chunk
+    uint32_t indexOffset;               // byte offset of the chunk index, which is where the last chunk ends
+    int count;
+    int choralesPerChunk;
+    int cachedChunk;
+    std::vector<Chorale> cache;         // decoded chorales of cachedChunk
+};
+
+#endif // CHORALEARCHIVE_H
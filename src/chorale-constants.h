@@ -19,7 +19,7 @@ static const int ALTO_MAX = 36;
 static const int SOPRANO_MIN = 24;
 static const int SOPRANO_MAX = 43;
 //static const std::map<std::string, int> lowestNote;
-bool majorKey = true;
+extern bool majorKey; // defined in chorale-solver.cpp
 
 /*
  * This vector contains chord relationships. Each index of the vector corresponds to a chord (e.g. index 1 would be used for a I chord). Each index stores a vector of chords that are permitted to follow the chord at the index.
@@ -5,14 +5,29 @@
  * This file contains the main part of the chorale solver program. It contains all the user interface and the algorithms necessary to calculate which notes are in the next chord.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <mutex>
+#include <thread>
 #include "console.h"
 #include "simpio.h" // getLine
 #include "gobjects.h"
 #include "choraledisplay.h"
+#include "chorale-archive.h"
 #include "chorale-constants.h"
+#include "filelib.h"
+#include "pianoroll.h"
+#include "random.h"
+#include "trace.h"
 #include "vector.h"
 
+bool majorKey = true;
+
 /**
  * Function: welcome
  * -----------------
@@ -47,6 +62,7 @@ static std::string menu() {
     std::cout << "1) input bass line" << std::endl;
     std::cout << "2) look up key number" << std::endl;
     std::cout << "3) more information" << std::endl;
+    std::cout << "4) review chorales in an archive" << std::endl;
     std::cout << "Q) quit" << std::endl;
 
     std::cout << std::endl;
@@ -99,6 +115,77 @@ static void displayRules() {
     std::cout << std::endl;
 }
 
+/**
+ * Function: reviewArchive
+ * -----------------------
+ * Asks for a chorale archive and a chorale in it, then shows that chorale in a scrolling piano roll until the user presses Q or closes the window.
+ */
+
+static void reviewArchive() {
+    std::string filename = trim(getLine("Archive file name: "));
+    if (!fileExists(filename)) {
+        std::cout << "That file does not exist." << std::endl;
+        return;
+    }
+    try {
+        ChoraleArchiveReader reader(filename);
+        if (reader.size() == 0) {
+            std::cout << "That archive is empty." << std::endl;
+            return;
+        }
+        int index = getInteger("Which chorale (0 to " + std::to_string(reader.size() - 1) + ")? ");
+        if (index < 0 || index >= reader.size()) {
+            std::cout << "Invalid chorale number." << std::endl;
+            return;
+        }
+        Chorale chorale = reader.get(index);
+        std::cout << "Use the arrow keys, Page Up/Down, and Home/End to scroll. Press Q to go back." << std::endl;
+        PianoRoll roll;
+        roll.setChorale(chorale);
+        roll.review();
+    }
+    catch (const ErrorException& ex) {
+        std::cout << "Could not read the archive: " << ex.getMessage() << std::endl;
+    }
+}
+
+/**
+ * Function: saveToArchive
+ * -----------------------
+ * Offers to add a solved chorale to a chorale archive so that it can be reviewed later. Archives can't be appended to, so the chorales already in the file are read back and written out again with the new one at the end, into a temporary file that then replaces the archive.
+ */
+
+static void saveToArchive(const Chorale& chorale) {
+    std::string filename = trim(getLine("Archive file to save this chorale in (press ENTER to skip): "));
+    if (filename.empty()) {
+        return;
+    }
+    std::string tempFilename = filename + ".tmp";
+    try {
+        std::vector<Chorale> chorales;
+        if (fileExists(filename)) {
+            ChoraleArchiveReader reader(filename);
+            for (int i = 0; i < reader.size(); ++i) {
+                chorales.push_back(reader.get(i));
+            }
+        }
+        chorales.push_back(chorale);
+        ChoraleArchiveWriter writer(tempFilename);
+        for (const Chorale& saved: chorales) {
+            writer.add(saved);
+        }
+        writer.close();
+        if (std::rename(tempFilename.c_str(), filename.c_str()) != 0) {
+            error("unable to replace " + filename);
+        }
+        std::cout << "Saved as chorale " << chorales.size() - 1 << " of " << filename << "." << std::endl;
+    }
+    catch (const ErrorException& ex) {
+        std::remove(tempFilename.c_str());
+        std::cout << "Could not save the chorale: " << ex.getMessage() << std::endl;
+    }
+}
+
 /**
  * Function: setUpChordRels
  * ----------------------
@@ -191,29 +278,33 @@ static std::vector<int> getNotes(ChoraleDisplay& display) {
                 break;
             }
         }
-
         // Check to make sure it's a number
-
-        // Convert string to an int
-        int nextNote = stringToInteger(nextNoteStr);
-
-        // Note must be in valid bass range (0-24)
-        if (nextNote < BASS_MIN || nextNote > BASS_MAX) {
-            std::cout << "Oops! The note must be between " << BASS_MIN << " and " << BASS_MAX << ". ";
-            nextNoteStr = getLine("Please try again: ");
-        }
-        // Note must be in the scale of the starting note
-        else if (notInScale(nextNote, startNote, majorKey)) {
-            std::cout << "That note isn't in the scale. ";
+        else if (!stringIsInteger(trim(nextNoteStr))) {
+            std::cout << "Oops! Type a note number, or \"done\" to finish. ";
             nextNoteStr = getLine("Please try again: ");
         }
-        // Otherwise, no errors - add this note to the vector, highlight it, and get the next note
         else {
-            bassLine.push_back(nextNote);
-            display.highlightKey(nextNote, "purple", true);
-            pause(1000);
-            display.highlightKey(nextNote, "purple", false);
-            nextNoteStr = getLine("Next note: ");
+            // Convert string to an int
+            int nextNote = stringToInteger(trim(nextNoteStr));
+
+            // Note must be in valid bass range (0-24)
+            if (nextNote < BASS_MIN || nextNote > BASS_MAX) {
+                std::cout << "Oops! The note must be between " << BASS_MIN << " and " << BASS_MAX << ". ";
+                nextNoteStr = getLine("Please try again: ");
+            }
+            // Note must be in the scale of the starting note
+            else if (notInScale(nextNote, startNote, majorKey)) {
+                std::cout << "That note isn't in the scale. ";
+                nextNoteStr = getLine("Please try again: ");
+            }
+            // Otherwise, no errors - add this note to the vector, highlight it, and get the next note
+            else {
+                bassLine.push_back(nextNote);
+                display.highlightKey(nextNote, "purple", true);
+                pause(1000);
+                display.highlightKey(nextNote, "purple", false);
+                nextNoteStr = getLine("Next note: ");
+            }
         }
     }
     return bassLine;
@@ -286,7 +377,7 @@ static bool createChordProgression(std::vector<int>& bass, Vector<int>& chords,
                 if (createChordProgression(bass, chords, chordRelations, index + 1, startingNote, nextChord)) {
                     return true;
                 }
-                chords.remove(index);
+                chords.remove(index + 1);
             }
         }
 
@@ -313,7 +404,7 @@ static bool createChordProgression(std::vector<int>& bass, Vector<int>& chords,
                 if (createChordProgression(bass, chords, chordRelations, index + 1, startingNote, firstInvChord)) {
                     return true;
                 }
-                chords.remove(index);
+                chords.remove(index + 1);
             }
         }
     }
@@ -328,6 +419,7 @@ static bool createChordProgression(std::vector<int>& bass, Vector<int>& chords,
  */
 
 static bool createChordProgression(std::vector<int>& bass, Vector<int>& chords, const std::vector<std::vector<int>>& chordRelations) {
+    TRACE_SPAN("solver", "progression search");
     // Assume that bass is well formed - more than 3 notes, all notes in key, begins and ends with I.
     int startingNote = bass[0];
     chords.push_back(1);
@@ -490,6 +582,8 @@ static int nextLowerNote(const std::vector<int>& chord, int note) {
         }
     }
     // Because the average calculation uses integer division, if we are not at the target note, the right hand side will be lower than the left hand side.
+    // If every note in the chord is higher, return the chord's lowest note an octave down, which is below every part's range.
+    if (rhs < 0) return chord.front() - 12;
     return chord[rhs];
 }
 
@@ -514,6 +608,8 @@ static int nextHigherNote(const std::vector<int>& chord, int note) {
         }
     }
     // Since lhs is greater than rhs if the loop terminates, we want to return the greater value.
+    // If every note in the chord is lower, return the chord's highest note an octave up, which is above every part's range.
+    if (lhs >= (int) chord.size()) return chord.back() + 12;
     return chord[lhs];
 }
 
@@ -538,7 +634,8 @@ static bool canCreateChoraleHelper(Vector<int>& chords, const std::vector<std::v
     // If any other checks fail (voice crossing, parts going out of range) return false
 
     // If the bass is moving down, or if the bass is moving up a distance of 5
-    if (bass[index] < bass[index - 1] || (bass[index] - bass[index - 1] == 5)) {
+    // A repeated bass note is handled the same way, so the upper voices keep any notes the two chords have in common (every chord needs a voicing, or the parts would end up shorter than the bass)
+    if (bass[index] <= bass[index - 1] || (bass[index] - bass[index - 1] == 5)) {
         // LTCorrected is only true if the soprano moved differently than it should have due to a leading tone. This check ensures that the soprano is not impacted by that change by passing in the next lower note in that chord.
         if (LTCorrected) {
             soprano.push_back(nextHigherNote(notesInChords[chords[index]], soprano.back() - 3));
@@ -575,6 +672,8 @@ static bool canCreateChoraleHelper(Vector<int>& chords, const std::vector<std::v
         // Move other voices down
         alto.push_back(nextLowerNote(notesInChords[chords[index]], alto.back()));
         tenor.push_back(nextLowerNote(notesInChords[chords[index]], tenor.back()));
+        // Make sure parts are not going out of range (the check at the top of this function is skipped for the last chord)
+        if (soprano.back() > SOPRANO_MAX || alto.back() < ALTO_MIN || tenor.back() < TENOR_MIN) return false;
         // Voice crossing - tenor lower than upcoming bass
         if (index < (int)(bass.size() - 1)) {
             if (tenor.back() < bass[index + 1]) return false;
@@ -592,6 +691,7 @@ static bool canCreateChoraleHelper(Vector<int>& chords, const std::vector<std::v
  */
 
 static bool canCreateChorale(Vector<int>& chords, const std::vector<std::vector<int>>& notesInChords, std::vector<int>& soprano, std::vector<int>& alto, std::vector<int>& tenor, const std::vector<int>& bass) {
+    TRACE_SPAN("solver", "voicing search");
     // Note that the way notesInChords is designed makes all 1's of the chord at indices congruent to 0 % 3, all 3's congruent to 1 % 3, and all 5's congruent to 2 % 3
     // Each chord must be as close to stepwise motion as possible
     // Each part must be between the MIN and MAX values specified
@@ -613,7 +713,7 @@ static bool canCreateChorale(Vector<int>& chords, const std::vector<std::vector<
     alto.clear();
     tenor.clear();
     // Reset highest tonic
-    if ((notesInChords[1][highestTonicIndex + 3]) <= SOPRANO_MAX)
+    if (highestTonicIndex + 3 < (int) notesInChords[1].size() && notesInChords[1][highestTonicIndex + 3] <= SOPRANO_MAX)
         highestTonicIndex += 3;
     // Try giving mediant to alto and dominant to tenor
     if (notesInChords[1][highestTonicIndex - 4] > bass[0] && notesInChords[1][highestTonicIndex - 4] > TENOR_MIN) {
@@ -625,7 +725,7 @@ static bool canCreateChorale(Vector<int>& chords, const std::vector<std::vector<
     soprano.clear();
     alto.clear();
     tenor.clear();
-    if ((notesInChords[1][highestTonicIndex + 1]) <= SOPRANO_MAX) {
+    if (highestTonicIndex + 1 < (int) notesInChords[1].size() && notesInChords[1][highestTonicIndex + 1] <= SOPRANO_MAX) {
         // Try starting soprano on mediant
         soprano.push_back(notesInChords[1][highestTonicIndex + 1]);
         alto.push_back(notesInChords[1][highestTonicIndex]);
@@ -642,7 +742,262 @@ static bool canCreateChorale(Vector<int>& chords, const std::vector<std::vector<
     return false;
 }
 
+/**
+ * Function: luby
+ * --------------
+ * Returns the ith term (starting at 1) of the Luby sequence 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ... The randomized search gives restart i a budget of luby(i) units, which wastes at most a logarithmic factor compared to knowing the best budget in advance.
+ */
+
+static long luby(long i) {
+    long size = 1;
+    int power = 0;
+    // Find the smallest complete block 2^k - 1 that reaches i
+    while (size < i) {
+        size = 2 * size + 1;
+        ++power;
+    }
+    // i is either the last term of the block, or falls in the copy of the previous block in front of it
+    while (size != i) {
+        size = (size - 1) / 2;
+        --power;
+        if (i > size) i -= size;
+    }
+    return 1L << power;
+}
+
+/**
+ * Function: isGoodVoicing
+ * -----------------------
+ * Checks one chord of a randomized voicing (the four voices of chord index, with the previous chord already in the vectors) against the part-writing rules: every part in range, no voice crossing, the tenor not below the next bass note, upper voices no more than an octave apart, all three notes of the triad present, no parallel 5ths or octaves, and a leading tone in a V chord resolving up to the tonic.
+ */
+
+static bool isGoodVoicing(const std::vector<int>& chords, const std::vector<std::vector<int>>& notesInChords, const std::vector<int>& soprano, const std::vector<int>& alto, const std::vector<int>& tenor, const std::vector<int>& bass, int index, int s, int a, int t) {
+    int b = bass[index];
+    if (s > SOPRANO_MAX || s < SOPRANO_MIN || a > ALTO_MAX || a < ALTO_MIN || t > TENOR_MAX || t < TENOR_MIN) return false;
+    if (s < a || a < t || t < b) return false;
+    if (index < (int) bass.size() - 1 && t < bass[index + 1]) return false;
+    if (s - a > 12 || a - t > 12) return false;
+
+    // The first three entries of a chord's vector are its root, third, and fifth
+    const std::vector<int>& chord = notesInChords[chords[index]];
+    for (int i = 0; i < 3; ++i) {
+        int pitch = chord[i] % 12;
+        if (s % 12 != pitch && a % 12 != pitch && t % 12 != pitch && b % 12 != pitch) return false;
+    }
+
+    if (index == 0) return true;
+    int previous[4] = { soprano[index - 1], alto[index - 1], tenor[index - 1], bass[index - 1] };
+    int current[4] = { s, a, t, b };
+    for (int i = 0; i < 4; ++i) {
+        for (int j = i + 1; j < 4; ++j) {
+            int before = ((previous[i] - previous[j]) % 12 + 12) % 12;
+            int after = ((current[i] - current[j]) % 12 + 12) % 12;
+            bool bothMove = previous[i] != current[i] && previous[j] != current[j];
+            if (bothMove && before == after && (after == 0 || after == 7)) return false;
+        }
+    }
+    if (chords[index - 1] == 5 && chords[index] == 1 && distanceToChord(previous[0] - bass[0]) == 7 && s != previous[0] + 1) return false;
+    return true;
+}
+
+/**
+ * Function: randomizedVoicingHelper
+ * ---------------------------------
+ * Depth-first search for the soprano, alto, and tenor from chord index onwards. Each voice may take any note of the chord within a fifth of its previous note (or any note in its range for the first chord). The combinations are tried in order of how far the voices move, with random jitter from rng so that every restart explores differently. Each dead end uses up one unit of failuresLeft, and the search gives up when it runs out or when stopBelow says that an earlier restart has already succeeded.
+ */
+
+static bool randomizedVoicingHelper(const std::vector<int>& chords, const std::vector<std::vector<int>>& notesInChords, std::vector<int>& soprano, std::vector<int>& alto, std::vector<int>& tenor, const std::vector<int>& bass, int index, RandomGenerator& rng, long& failuresLeft, const std::atomic<int>& stopBelow, int restart) {
+    if (index >= (int) chords.size()) return true;
+    if (failuresLeft <= 0 || stopBelow.load(std::memory_order_relaxed) < restart) return false;
+
+    // Candidate notes for each voice
+    const std::vector<int>& chord = notesInChords[chords[index]];
+    std::vector<int> candidates[3];
+    for (int voice = 0; voice < 3; ++voice) {
+        for (int note: chord) {
+            if (index == 0) {
+                candidates[voice].push_back(note);
+            }
+            else {
+                int previous = voice == 0 ? soprano.back() : voice == 1 ? alto.back() : tenor.back();
+                if (std::abs(note - previous) <= 7) candidates[voice].push_back(note);
+            }
+        }
+    }
+
+    // Every combination that follows the rules, keyed by total motion plus jitter
+    std::vector<std::pair<int, int>> order;
+    std::vector<int> choices;
+    for (int s: candidates[0]) {
+        for (int a: candidates[1]) {
+            for (int t: candidates[2]) {
+                if (!isGoodVoicing(chords, notesInChords, soprano, alto, tenor, bass, index, s, a, t)) continue;
+                int motion = index == 0 ? 0 : std::abs(s - soprano.back()) + std::abs(a - alto.back()) + std::abs(t - tenor.back());
+                order.push_back(std::make_pair(motion + rng.nextInteger(0, 6), (int) choices.size()));
+                choices.push_back(s);
+                choices.push_back(a);
+                choices.push_back(t);
+            }
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    for (const std::pair<int, int>& entry: order) {
+        int choice = entry.second;
+        soprano.push_back(choices[choice]);
+        alto.push_back(choices[choice + 1]);
+        tenor.push_back(choices[choice + 2]);
+        if (randomizedVoicingHelper(chords, notesInChords, soprano, alto, tenor, bass, index + 1, rng, failuresLeft, stopBelow, restart)) return true;
+        soprano.pop_back();
+        alto.pop_back();
+        tenor.pop_back();
+        if (failuresLeft <= 0) return false;
+    }
+    --failuresLeft;
+    return false;
+}
+
+/**
+ * Struct: RestartSearch
+ * ---------------------
+ * The state shared by the threads of a randomized-restart search. Restart numbers are handed out in order from nextRestart, and bestRestart is the lowest restart that has found a solution so far, so the answer is always the one that running the restarts one at a time would have found first.
+ */
+
+struct RestartSearch {
+    const std::vector<int>* chords;
+    const std::vector<std::vector<int>>* notesInChords;
+    const std::vector<int>* bass;
+    std::uint64_t seed;
+    int maxRestarts;
+    std::atomic<int> nextRestart;
+    std::atomic<int> bestRestart;
+    std::atomic<int> restartsRun;
+    std::mutex lock;   // guards the solution below
+    std::vector<int> soprano;
+    std::vector<int> alto;
+    std::vector<int> tenor;
+};
+
+// Dead ends allowed per unit of the Luby sequence
+static const long LUBY_UNIT = 16;
+
+/**
+ * Function: restartWorker
+ * -----------------------
+ * Runs on each thread of a randomized-restart search, taking restarts until they run out or an earlier restart has succeeded. Restart r always uses stream r of the seed, so results do not depend on the number of threads. A thread takes restarts in increasing order, so it keeps one generator and jumps it forward to each restart's stream rather than seeding every stream from scratch.
+ */
+
+static void restartWorker(RestartSearch& search) {
+    RandomGenerator streams(search.seed);
+    int stream = 0;
+    while (true) {
+        int restart = search.nextRestart.fetch_add(1);
+        if (restart > search.maxRestarts || restart > search.bestRestart.load()) return;
+        search.restartsRun.fetch_add(1);
+        for (; stream < restart; ++stream) {
+            streams.jump();
+        }
+        RandomGenerator rng = streams;
+        long failuresLeft = LUBY_UNIT * luby(restart);
+        std::vector<int> soprano, alto, tenor;
+        if (randomizedVoicingHelper(*search.chords, *search.notesInChords, soprano, alto, tenor, *search.bass, 0, rng, failuresLeft, search.bestRestart, restart)) {
+            std::lock_guard<std::mutex> guard(search.lock);
+            if (restart < search.bestRestart.load()) {
+                search.bestRestart.store(restart);
+                search.soprano = soprano;
+                search.alto = alto;
+                search.tenor = tenor;
+            }
+        }
+    }
+}
+
+/**
+ * Function: canCreateChoraleRandomized
+ * ------------------------------------
+ * Searches for a soprano, alto, and tenor with randomized restarts on a Luby schedule, spread across threadCount threads. This explores many more voicings than canCreateChorale, so it can solve bass lines where the three standard starting voicings all fail. The same seed always gives the same chorale. If a solution is found, restarts is set to the number of the restart that found it (starting at 1) and restartsRun to the number of restarts that were started in total.
+ */
+
+static bool canCreateChoraleRandomized(Vector<int>& chords, const std::vector<std::vector<int>>& notesInChords, std::vector<int>& soprano, std::vector<int>& alto, std::vector<int>& tenor, const std::vector<int>& bass, std::uint64_t seed, int maxRestarts, int threadCount, int& restarts, int& restartsRun) {
+    TRACE_SPAN("solver", "randomized voicing search");
+    std::vector<int> chordList;
+    for (int chord: chords) {
+        chordList.push_back(chord);
+    }
+    RestartSearch search;
+    search.chords = &chordList;
+    search.notesInChords = &notesInChords;
+    search.bass = &bass;
+    search.seed = seed;
+    search.maxRestarts = maxRestarts;
+    search.nextRestart = 1;
+    search.bestRestart = maxRestarts + 1;
+    search.restartsRun = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; ++i) {
+        threads.push_back(std::thread(restartWorker, std::ref(search)));
+    }
+    restartWorker(search);
+    for (std::thread& thread: threads) {
+        thread.join();
+    }
+
+    restartsRun = search.restartsRun.load();
+    if (search.bestRestart.load() > maxRestarts) return false;
+    restarts = search.bestRestart.load();
+    soprano = search.soprano;
+    alto = search.alto;
+    tenor = search.tenor;
+    return true;
+}
+
+// Restarts to try before giving up on a bass line
+static const int MAX_RESTARTS = 2000;
+
+/**
+ * Function: searchWithRestarts
+ * ----------------------------
+ * Runs canCreateChoraleRandomized on every core and tells the user how it went. The seed comes from the CHORALE_SEED environment variable if it is set, so a run can be repeated exactly; otherwise a random seed is picked and printed.
+ */
+
+static bool searchWithRestarts(Vector<int>& chords, const std::vector<std::vector<int>>& notesInChords, std::vector<int>& soprano, std::vector<int>& alto, std::vector<int>& tenor, const std::vector<int>& bass) {
+    soprano.clear();
+    alto.clear();
+    tenor.clear();
+    const char* seedText = getenv("CHORALE_SEED");
+    std::uint64_t seed = seedText != nullptr ? strtoull(seedText, nullptr, 10) : getThreadRandomGenerator().next();
+    int threadCount = std::max(1, (int) std::thread::hardware_concurrency());
+    std::cout << "The standard voicings didn't work, so trying randomized restarts (seed " << seed << ", " << threadCount << " threads)..." << std::endl;
+    int restarts = 0;
+    int restartsRun = 0;
+    if (!canCreateChoraleRandomized(chords, notesInChords, soprano, alto, tenor, bass, seed, MAX_RESTARTS, threadCount, restarts, restartsRun)) {
+        std::cout << "Gave up after " << restartsRun << " restarts." << std::endl;
+        return false;
+    }
+    std::cout << "Found a voicing on restart " << restarts << " (" << restartsRun << " restarts run in total)." << std::endl;
+    return true;
+}
+
+/**
+ * Function: saveTrace
+ * -------------------
+ * If the CHORALE_TRACE environment variable was set when the program started, writes every trace span recorded so far (solver phases, rendering, and pipe I/O) to the file it names, in the Chrome trace format that chrome://tracing and ui.perfetto.dev can open.
+ */
+
+static void saveTrace() {
+    const char* filename = getenv("CHORALE_TRACE");
+    if (filename == nullptr || !isTracingEnabled()) return;
+    std::ofstream out(filename);
+    writeTrace(out);
+    std::cout << "Trace written to " << filename << "." << std::endl;
+}
+
 int main() {
+    // Record a profiling trace of this run if asked to
+    if (getenv("CHORALE_TRACE") != nullptr) {
+        setTracingEnabled(true);
+    }
     ChoraleDisplay display;
     welcome();
     while (true) {
@@ -670,7 +1025,12 @@ int main() {
                 std::vector<int> alto;
                 std::vector<int> tenor;
                 // Create other parts recursively
-                if (!canCreateChorale(chords, notesInChords, soprano, alto, tenor, bass)) {
+                bool found = canCreateChorale(chords, notesInChords, soprano, alto, tenor, bass);
+                if (!found) {
+                    // The standard starting voicings failed, so search more widely with randomized restarts
+                    found = searchWithRestarts(chords, notesInChords, soprano, alto, tenor, bass);
+                }
+                if (!found) {
                     std::cout << "No solutions were found for that chord progression." << std::endl;
                 }
                 else {
@@ -686,6 +1046,14 @@ int main() {
                         display.highlightKey(tenor[i], "red", false);
                         display.highlightKey(bass[i], "purple", false);
                     }
+                    Chorale chorale;
+                    chorale.majorKey = majorKey;
+                    chorale.chords.assign(chords.begin(), chords.end());
+                    chorale.soprano = soprano;
+                    chorale.alto = alto;
+                    chorale.tenor = tenor;
+                    chorale.bass = bass;
+                    saveToArchive(chorale);
                 }
                 std::cout << std::endl;
             }
@@ -706,9 +1074,13 @@ int main() {
         else if (choice == "3") {
             displayRules();
         }
+        else if (choice == "4") {
+            reviewArchive();
+        }
         else if (choice[0] == 'Q') {
             std::cout << std::endl;
             std::cout << "Thanks for using the 4-Part Chorale Solver! Have a nice day!" << std::endl;
+            saveTrace();
             break;
         }
     }
@@ -7,6 +7,7 @@
 
 #include "choraledisplay.h"
 #include <iostream>
+#include "trace.h"
 
 ChoraleDisplay::ChoraleDisplay() : window(WINDOW_WIDTH, WINDOW_HEIGHT) {
     window.setVisible(true);
@@ -102,16 +103,20 @@ void ChoraleDisplay::initializeKeys() {
             // Create label
             makeLabel(blackKey);
 
-            // Add to keys vector
+            // Add to keys vector; black keys are drawn after all the white keys
             keys.push_back(blackKey);
 
-            // Draw key
-            window.add(rect);
-            window.add(blackKey.label);
-
             ++blackKeyCounter;
         }
     }
+
+    // Draw the black keys last so that they stay on top of the white keys, even when a white key is filled in
+    for (Key& key : keys) {
+        if (key.color == BLACK) {
+            window.add(key.rect);
+            window.add(key.label);
+        }
+    }
     repaint();
 }
 
@@ -131,6 +136,7 @@ void ChoraleDisplay::makeLabel(Key& key) {
 }
 
 void ChoraleDisplay::highlightKey(int keyNumber, std::string color, bool flag) {
+    TRACE_SPAN("rendering", "highlightKey");
     Key key = keys[keyNumber];
     if (flag) {
         // Set the color of the key based on the color (blue, green, red, or purple)
@@ -142,39 +148,16 @@ void ChoraleDisplay::highlightKey(int keyNumber, std::string color, bool flag) {
             key.rect->setFillColor("#ff0000");
         else if (color == "purple")
             key.rect->setFillColor("#800080");
-        // For white keys, we have to redraw the neighboring keys
+        // White keys are only filled while they are highlighted; the black keys were added last, so they stay on top
         if (key.color == WHITE) {
             key.rect->setFilled(true);
-            window.add(key.rect);
-            window.add(key.label);
-            window.add(keys[keyNumber - 1].rect);
-            window.add(keys[keyNumber - 1].label);
-            window.add(keys[keyNumber + 1].rect);
-            window.add(keys[keyNumber + 1].label);
-        }
-        // For black keys, just redraw the black key and its label
-        else {
-            window.add(key.rect);
-            window.add(key.label);
         }
     }
     // Unhighlight by changing color back to black, and unfilling if white
     else {
         key.rect->setFillColor("#000000");
-        // White key
-        if (getKeyColor(keyNumber) == WHITE) {
+        if (key.color == WHITE) {
             key.rect->setFilled(false);
-            window.add(key.rect);
-            window.add(key.label);
-            window.add(keys[keyNumber - 1].rect);
-            window.add(keys[keyNumber - 1].label);
-            window.add(keys[keyNumber + 1].rect);
-            window.add(keys[keyNumber + 1].label);
-        }
-        // Black key
-        else {
-            window.add(key.rect);
-            window.add(key.label);
         }
     }
     repaint();
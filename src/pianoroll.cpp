@@ -0,0 +1,162 @@
+/*
+ * File: pianoroll.cpp
+ * Name: Victor Lin
+ * -------------------
+ * This file contains the implementations of the functions defined in pianoroll.h.
+ */
+
+#include "pianoroll.h"
+#include <algorithm>
+#include "gevents.h"
+#include "trace.h"
+
+// Colors of the background, the keyboard on the left edge, and the lines between octaves and chords
+static const int ROW_WHITE = 0xffffff;
+static const int ROW_BLACK = 0xebebeb;
+static const int KEYBOARD_WHITE = 0xffffff;
+static const int KEYBOARD_BLACK = 0x000000;
+static const int OCTAVE_LINE = 0xa0a0a0;
+static const int CHORD_LINE = 0xd0d0d0;
+
+// Voices are drawn from the bass up so that the higher voice stays visible when two voices share a key; the colors match ChoraleDisplay::highlightKey
+static const int N_VOICES = 4;
+static const int VOICE_COLORS[N_VOICES] = { 0x800080, 0xff0000, 0x008000, 0x0040c0 };
+
+/**
+ * Function: isBlackKey
+ * --------------------
+ * Returns whether the key with the given number is a black key. Key 0 is a C, just like in ChoraleDisplay.
+ */
+
+static bool isBlackKey(int keyNumber) {
+    int index = keyNumber % 12;
+    return index == 1 || index == 3 || index == 6 || index == 8 || index == 10;
+}
+
+PianoRoll::PianoRoll() : window(VIEW_WIDTH, VIEW_HEIGHT), pixels(VIEW_HEIGHT, VIEW_WIDTH) {
+    window.setWindowTitle("Piano Roll");
+    window.setRepaintImmediately(false);
+    image = new GBufferedImage(VIEW_WIDTH, VIEW_HEIGHT, ROW_WHITE);
+    window.add(image);
+    chordCount = 0;
+    scrollOffset = 0;
+    render();
+}
+
+PianoRoll::~PianoRoll() {
+    // take the image out of the window first so that the window never holds a deleted object
+    window.remove(image);
+    delete image;
+    window.close();
+}
+
+void PianoRoll::setChorale(const Chorale& chorale) {
+    this->chorale = chorale;
+    // All four voices should be the same length, but never draw past the end of the shortest one
+    chordCount = (int) std::min(std::min(chorale.soprano.size(), chorale.alto.size()), std::min(chorale.tenor.size(), chorale.bass.size()));
+    scrollOffset = 0;
+    render();
+}
+
+void PianoRoll::scrollTo(int offset) {
+    offset = std::max(0, std::min(offset, getMaxScrollOffset()));
+    if (offset != scrollOffset) {
+        scrollOffset = offset;
+        render();
+    }
+}
+
+void PianoRoll::scrollBy(int distance) {
+    scrollTo(scrollOffset + distance);
+}
+
+int PianoRoll::getScrollOffset() const {
+    return scrollOffset;
+}
+
+int PianoRoll::getMaxScrollOffset() const {
+    return std::max(0, chordCount * CHORD_WIDTH - NOTES_WIDTH);
+}
+
+void PianoRoll::review() {
+    window.requestFocus();
+    while (true) {
+        GEvent event = waitForEvent(KEY_EVENT | WINDOW_EVENT);
+        if (event.getEventType() == WINDOW_CLOSED) {
+            if (GWindowEvent(event).getGWindow() == window) return;
+        }
+        else if (event.getEventType() == KEY_PRESSED) {
+            GKeyEvent keyEvent(event);
+            if (!(keyEvent.getGWindow() == window)) continue;
+            char ch = keyEvent.getKeyChar();
+            switch (keyEvent.getKeyCode()) {
+            case LEFT_ARROW_KEY: scrollBy(-CHORD_WIDTH); break;
+            case RIGHT_ARROW_KEY: scrollBy(CHORD_WIDTH); break;
+            case PAGE_UP_KEY: scrollBy(-NOTES_WIDTH); break;
+            case PAGE_DOWN_KEY: scrollBy(NOTES_WIDTH); break;
+            case HOME_KEY: scrollTo(0); break;
+            case END_KEY: scrollTo(getMaxScrollOffset()); break;
+            case ESCAPE_KEY: return;
+            default:
+                if (ch == 'q' || ch == 'Q') return;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Method: fillRect
+ * Fills the pixels from x0 up to (but not including) x1 and from y0 up to (but not including) y1. The caller has already clipped the rectangle to the view.
+ */
+
+void PianoRoll::fillRect(int x0, int x1, int y0, int y1, int rgb) {
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            pixels[y][x] = rgb;
+        }
+    }
+}
+
+/**
+ * Method: render
+ * Draws the visible part of the chorale into the pixel grid and sends the whole frame to the image in one upload. Only the chords that are at least partly on screen are looked at.
+ */
+
+void PianoRoll::render() {
+    TRACE_SPAN("rendering", "piano roll");
+    // Background rows, with the keyboard on the left and a line under every C
+    for (int key = 0; key < N_KEYS; ++key) {
+        int top = (N_KEYS - 1 - key) * ROW_HEIGHT;
+        bool black = isBlackKey(key);
+        fillRect(0, KEYBOARD_WIDTH, top, top + ROW_HEIGHT, black ? KEYBOARD_BLACK : KEYBOARD_WHITE);
+        fillRect(KEYBOARD_WIDTH, VIEW_WIDTH, top, top + ROW_HEIGHT, black ? ROW_BLACK : ROW_WHITE);
+        if (key % 12 == 0) {
+            fillRect(0, VIEW_WIDTH, top + ROW_HEIGHT - 1, top + ROW_HEIGHT, OCTAVE_LINE);
+        }
+    }
+
+    // Notes of the chords on screen; the first and last chord may be cut off by the edges of the view
+    const std::vector<int>* voices[N_VOICES] = { &chorale.bass, &chorale.tenor, &chorale.alto, &chorale.soprano };
+    int firstChord = scrollOffset / CHORD_WIDTH;
+    int lastChord = std::min(chordCount - 1, (scrollOffset + NOTES_WIDTH - 1) / CHORD_WIDTH);
+    for (int i = firstChord; i <= lastChord; ++i) {
+        int left = KEYBOARD_WIDTH + i * CHORD_WIDTH - scrollOffset;
+        if (left >= KEYBOARD_WIDTH) {
+            fillRect(left, left + 1, 0, VIEW_HEIGHT, CHORD_LINE);
+        }
+        int x0 = left + 1;
+        int x1 = left + CHORD_WIDTH;
+        if (x0 < KEYBOARD_WIDTH) x0 = KEYBOARD_WIDTH;
+        if (x1 > VIEW_WIDTH) x1 = VIEW_WIDTH;
+        for (int voice = 0; voice < N_VOICES; ++voice) {
+            int key = (*voices[voice])[i];
+            if (key < 0 || key >= N_KEYS) continue;
+            int top = (N_KEYS - 1 - key) * ROW_HEIGHT;
+            fillRect(x0, x1, top, top + ROW_HEIGHT - 1, VOICE_COLORS[voice]);
+        }
+    }
+
+    image->fromGrid(pixels);
+    window.repaint();
+}
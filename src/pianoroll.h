@@ -0,0 +1,96 @@
+/*
+ * File: pianoroll.h
+ * Name: Victor Lin
+ * -----------------
+ * This file defines a scrolling piano-roll view for reviewing long chorales. Time goes from left to right (one column per chord) and pitch goes from bottom to top (one row per key), with a small keyboard on the left edge that stays in place while the notes scroll.
+ *
+ * The whole view is a single GBufferedImage. Every time the view scrolls, the visible part of the chorale is drawn into a grid of pixels and sent to the window in one upload, so only the chords that are on screen are ever touched and a 1,000-chord chorale scrolls as fast as a 10-chord one.
+ */
+
+#ifndef PIANOROLL_H
+#define PIANOROLL_H
+#include "gwindow.h"
+#include "gbufferedimage.h"
+#include "grid.h"
+#include "chorale-archive.h"
+
+class PianoRoll {
+public:
+    /**
+     * Constructor: PianoRoll
+     * This constructor opens the piano-roll window with an empty chorale.
+     */
+
+    PianoRoll();
+
+    /**
+     * Destructor: ~PianoRoll
+     * The destructor closes the window.
+     */
+
+    ~PianoRoll();
+
+    /**
+     * Method: setChorale
+     * This method shows the given chorale, scrolled all the way to the left.
+     */
+
+    void setChorale(const Chorale& chorale);
+
+    /**
+     * Method: scrollTo
+     * This method scrolls so that the given pixel offset into the chorale is at the left edge of the notes. The offset is clamped so that the view never scrolls past either end. Nothing is redrawn if the view does not move.
+     */
+
+    void scrollTo(int offset);
+
+    /**
+     * Method: scrollBy
+     * This method scrolls by the given number of pixels (negative numbers scroll to the left).
+     */
+
+    void scrollBy(int distance);
+
+    /**
+     * Method: getScrollOffset
+     * This method returns the current pixel offset of the left edge of the notes.
+     */
+
+    int getScrollOffset() const;
+
+    /**
+     * Method: getMaxScrollOffset
+     * This method returns the largest offset that scrollTo will scroll to.
+     */
+
+    int getMaxScrollOffset() const;
+
+    /**
+     * Method: review
+     * This method lets the user scroll through the chorale with the keyboard until they press Q or Escape or close the window. The arrow keys move one chord, Page Up and Page Down move one screen, and Home and End jump to either end.
+     */
+
+    void review();
+
+    static const int CHORD_WIDTH = 24;    // width of one chord's column in pixels
+    static const int ROW_HEIGHT = 6;      // height of one key's row in pixels
+
+private:
+    void render();
+    void fillRect(int x0, int x1, int y0, int y1, int rgb);
+
+    GWindow window;
+    GBufferedImage* image;
+    Grid<int> pixels;                     // the frame that is sent to image on every render
+    Chorale chorale;
+    int chordCount;
+    int scrollOffset;
+
+    static const int N_KEYS = 44;
+    static const int KEYBOARD_WIDTH = 24;
+    static const int VIEW_WIDTH = 900;
+    static const int NOTES_WIDTH = VIEW_WIDTH - KEYBOARD_WIDTH;
+    static const int VIEW_HEIGHT = N_KEYS * ROW_HEIGHT;
+};
+
+#endif // PIANOROLL_H
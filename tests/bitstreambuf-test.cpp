@@ -0,0 +1,166 @@
+/*
+ * File: bitstreambuf-test.cpp
+ * ---------------------------
+ * Checks that BitStreambuf keeps an unfinished byte across the seek to the
+ * end and back that ibitstream::size and obitstream::size perform, across a
+ * flush, and across a read that runs out of bytes.
+ * BitStreambuf is header-only, so this builds on its own:
+ *
+ *    g++ -std=c++11 -Ilib/StanfordCPPLib tests/bitstreambuf-test.cpp -o bitstreambuf-test
+ *    ./bitstreambuf-test
+ *
+ * It prints one line per check and exits with status 1 if any check fails.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include "private/bitstreambuf.h"
+
+using stanfordcpplib::BitStreambuf;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& name) {
+    std::cout << (ok ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!ok) {
+        failures++;
+    }
+}
+
+/* The same seeks as ibitstream::size. */
+static long inputSize(std::istream& in) {
+    std::streampos cur = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(cur);
+    return long(end);
+}
+
+/* The same seeks as obitstream::size. */
+static long outputSize(std::ostream& out) {
+    std::streampos cur = out.tellp();
+    out.seekp(0, std::ios::end);
+    std::streampos end = out.tellp();
+    out.seekp(cur);
+    return long(end);
+}
+
+static void writeBits(BitStreambuf& buf, const std::string& bits) {
+    for (char ch : bits) {
+        buf.writeBits(ch == '1' ? 1 : 0, 1);
+    }
+}
+
+static std::string readBits(BitStreambuf& buf, int n) {
+    std::string bits;
+    for (int i = 0; i < n; i++) {
+        uint64_t bit;
+        bits += !buf.readBits(1, bit) ? '?' : bit ? '1' : '0';
+    }
+    return bits;
+}
+
+static void testWrite(std::streambuf* dest, const std::string& name) {
+    BitStreambuf buf(std::ios::out);
+    buf.setSource(dest);
+    std::ostream out(&buf);
+    writeBits(buf, "101");
+    check(outputSize(out) == 1, name + ": size() of 3 bits is 1 byte");
+    writeBits(buf, "11");
+    check(outputSize(out) == 1, name + ": size() of 5 bits is 1 byte");
+    writeBits(buf, "0001");
+    out.flush();
+}
+
+static void testRead(std::streambuf* source, const std::string& name) {
+    BitStreambuf buf(std::ios::in);
+    buf.setSource(source);
+    std::istream in(&buf);
+    std::string bits = readBits(buf, 2);
+    check(inputSize(in) == 2, name + ": size() in mid-byte");
+    bits += readBits(buf, 2);
+    check(inputSize(in) == 2, name + ": size() in mid-byte again");
+    bits += readBits(buf, 5);
+    check(bits == "101110001", name + ": bits read around size() are " + bits);
+}
+
+/* Bits read after size() must not bring back the byte that size() saw. */
+static void testReadAfterResume() {
+    std::stringbuf source(std::string("\x0f\xf0", 2), std::ios::in);
+    BitStreambuf buf(std::ios::in);
+    buf.setSource(&source);
+    std::istream in(&buf);
+    std::string bits = readBits(buf, 4);
+    inputSize(in);
+    bits += readBits(buf, 4);
+    inputSize(in);
+    bits += readBits(buf, 8);
+    check(bits == "1111000000001111", "size() twice in one byte: bits are " + bits);
+}
+
+/* A flush in mid-byte writes the byte out but leaves it open. */
+static void testFlush() {
+    std::stringbuf written(std::ios::in | std::ios::out);
+    BitStreambuf buf(std::ios::out);
+    buf.setSource(&written);
+    std::ostream out(&buf);
+    writeBits(buf, "101");
+    out.flush();
+    check(written.str() == "\x05", "flush in mid-byte writes the partial byte");
+    writeBits(buf, "11");
+    out.flush();
+    check(written.str() == "\x1d", "bits after a flush finish the same byte");
+}
+
+/* Running out of bytes in mid-byte keeps the bits that are left. */
+static void testEndOfInput() {
+    std::stringbuf source(std::string("\x05", 1), std::ios::in);
+    BitStreambuf buf(std::ios::in);
+    buf.setSource(&source);
+    std::istream in(&buf);
+    std::string bits = readBits(buf, 3);
+    check(in.peek() == EOF, "peek in the last byte's bits is EOF");
+    in.clear();
+    uint64_t value;
+    check(!buf.readBits(8, value), "reading past the end fails");
+    bits += readBits(buf, 5);
+    check(bits == "10100000", "bits left after EOF are still read: " + bits);
+}
+
+int main() {
+    // 1,0,1,1,1 then 0,0,0,1 packs least significant bit first into 0x1d 0x01
+    const std::string expected("\x1d\x01", 2);
+
+    std::stringbuf written(std::ios::in | std::ios::out);
+    testWrite(&written, "string write");
+    check(written.str() == expected, "string write: bytes are 1d 01");
+
+    std::stringbuf toRead(expected, std::ios::in);
+    testRead(&toRead, "string read");
+
+    const char* filename = "bitstreambuf-test.tmp";
+    std::filebuf file;
+    file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    testWrite(&file, "file write");
+    file.close();
+    file.open(filename, std::ios::in | std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(&file)), std::istreambuf_iterator<char>());
+    check(contents == expected, "file write: bytes are 1d 01");
+    file.pubseekpos(0, std::ios::in);
+    testRead(&file, "file read");
+    file.close();
+    std::remove(filename);
+
+    testReadAfterResume();
+    testFlush();
+    testEndOfInput();
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+/*
+ * File: set-merge-test.cpp
+ * ------------------------
+ * Checks Set's +, *, -, their in-place forms, isSubsetOf, containsAll and ==
+ * against std::set on 20000 random pairs of sets, some large and some with
+ * only a few elements, so that both the merge and the per-element paths
+ * run.  Each trial also covers aliasing (s += s, s *= s, s -= s), sets
+ * ordered by a custom comparator, operands with different comparators, and
+ * adding and removing elements after a merge.  After every operation the
+ * result's tree is checked for the AVL invariants, since the merges build
+ * it directly instead of inserting one element at a time.
+ *
+ * From the top of the repository:
+ *
+ *   g++ -std=c++11 $FLAGS tests/set-merge-test.cpp $SOURCES -ldl -lpthread -o set-merge-test
+ *   ./set-merge-test
+ *
+ * where FLAGS and SOURCES are as in fuzz/chorale-fuzz.cpp.  It prints one
+ * line per check and exits with status 1 if any check fails.
+ *
+ * @version 2026/10/17
+ * - initial version
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "collections.h"
+#include "error.h"
+#include "hashcode.h"
+#include "random.h"
+#include "stack.h"
+#include "vector.h"
+
+// The tree inside a Set is private; open it up to check its balance factors.
+#define private public
+#include "map.h"
+#include "set.h"
+#undef private
+
+// random.h brings in the library's wrapper around main(), which this file replaces
+#undef main
+
+static const int TRIALS = 20000;
+
+// Number of failed trials for each check, in the order they were first seen
+static std::vector<std::pair<std::string, int>> results;
+
+static void expect(bool ok, const std::string& what) {
+    for (std::pair<std::string, int>& result : results) {
+        if (result.first == what) {
+            result.second += ok ? 0 : 1;
+            return;
+        }
+    }
+    results.push_back(std::make_pair(what, ok ? 0 : 1));
+}
+
+/*
+ * Appends the keys in the subtree at t to keys in order and returns its
+ * height.  Clears ok if any node's balance factor is not the difference in
+ * its subtrees' heights or is outside -1..1.
+ */
+template <typename NodeType>
+static int walk(const NodeType* t, std::vector<int>& keys, bool& ok) {
+    if (t == nullptr) {
+        return 0;
+    }
+    int left = walk(t->left, keys, ok);
+    keys.push_back(t->key);
+    int right = walk(t->right, keys, ok);
+    if (t->bf != right - left || std::abs(right - left) > 1) {
+        ok = false;
+    }
+    return 1 + std::max(left, right);
+}
+
+/*
+ * Returns the elements of s in its own order, read straight from its tree.
+ */
+static std::vector<int> elements(const Set<int>& s, bool& balanced) {
+    std::vector<int> keys;
+    balanced = true;
+    walk(s.map.root, keys, balanced);
+    return keys;
+}
+
+static std::vector<int> elements(const Set<int>& s) {
+    bool balanced;
+    return elements(s, balanced);
+}
+
+static std::set<int> toStdSet(const Set<int>& s) {
+    std::vector<int> values = elements(s);
+    return std::set<int>(values.begin(), values.end());
+}
+
+/*
+ * Checks that set s is a valid AVL tree holding exactly the elements of
+ * expected, in order.
+ */
+static void expectSet(const Set<int>& s, const std::set<int>& expected, const std::string& what) {
+    bool balanced;
+    std::vector<int> keys = elements(s, balanced);
+    expect(balanced && (int) keys.size() == s.size(), what + " keeps the tree balanced");
+    expect(keys == std::vector<int>(expected.begin(), expected.end()), what);
+}
+
+/* Orders integers from largest to smallest. */
+struct Descending {
+    bool operator ()(int a, int b) const {
+        return a > b;
+    }
+};
+
+static void runTrial(RandomGenerator& rng) {
+    int range = rng.nextInteger(1, 200);
+    int sizeA = rng.nextInteger(0, 100);
+    int sizeB = rng.nextChance(0.3) ? rng.nextInteger(0, 3) : rng.nextInteger(0, 100);
+    Set<int> a;
+    Set<int> b;
+    std::set<int> refA;
+    std::set<int> refB;
+    for (int i = 0; i < sizeA; i++) {
+        int value = rng.nextInteger(0, range);
+        a.add(value);
+        refA.insert(value);
+    }
+    for (int i = 0; i < sizeB; i++) {
+        int value = rng.nextInteger(0, range);
+        b.add(value);
+        refB.insert(value);
+    }
+    std::set<int> both;
+    std::set<int> either;
+    std::set<int> onlyA;
+    std::set_union(refA.begin(), refA.end(), refB.begin(), refB.end(), std::inserter(either, either.end()));
+    std::set_intersection(refA.begin(), refA.end(), refB.begin(), refB.end(), std::inserter(both, both.end()));
+    std::set_difference(refA.begin(), refA.end(), refB.begin(), refB.end(), std::inserter(onlyA, onlyA.end()));
+    bool subset = std::includes(refB.begin(), refB.end(), refA.begin(), refA.end());
+
+    expectSet(a + b, either, "a + b");
+    expectSet(a * b, both, "a * b");
+    expectSet(a - b, onlyA, "a - b");
+    expect(a.isSubsetOf(b) == subset, "a.isSubsetOf(b)");
+    expect(b.containsAll(a) == subset, "b.containsAll(a)");
+    expect((a == b) == (refA == refB), "a == b");
+
+    Set<int> c = a;
+    c += b;
+    expectSet(c, either, "c += b");
+    c = a;
+    c *= b;
+    expectSet(c, both, "c *= b");
+    c = a;
+    c -= b;
+    expectSet(c, onlyA, "c -= b");
+
+    c = a;
+    c += c;
+    expectSet(c, refA, "c += c");
+    c = a;
+    c *= c;
+    expectSet(c, refA, "c *= c");
+    c = a;
+    c -= c;
+    expectSet(c, std::set<int>(), "c -= c");
+
+    // a merged tree must still take ordinary inserts and removes
+    c = a;
+    c += b;
+    std::set<int> changed = either;
+    for (int i = 0; i < 20; i++) {
+        int value = rng.nextInteger(0, range);
+        if (rng.nextBool()) {
+            c.add(value);
+            changed.insert(value);
+        } else {
+            c.remove(value);
+            changed.erase(value);
+        }
+    }
+    expectSet(c, changed, "add and remove after c += b");
+
+    Set<int> descA((Descending()));
+    Set<int> descB((Descending()));
+    for (int value : refA) {
+        descA.add(value);
+    }
+    for (int value : refB) {
+        descB.add(value);
+    }
+    expect(toStdSet(descA + descB) == either && toStdSet(descA * descB) == both
+           && toStdSet(descA - descB) == onlyA, "+, *, - with a custom comparator");
+    expect(elements(descA + descB) == std::vector<int>(either.rbegin(), either.rend()),
+           "a + b keeps a custom comparator's order");
+    expect(toStdSet(a + descB) == either && toStdSet(a * descB) == both
+           && toStdSet(a - descB) == onlyA, "+, *, - with different comparators");
+    expect(a.isSubsetOf(descB) == subset, "isSubsetOf with different comparators");
+}
+
+int main() {
+    RandomGenerator rng(20261017);
+    for (int trial = 0; trial < TRIALS; trial++) {
+        runTrial(rng);
+    }
+    int failures = 0;
+    for (const std::pair<std::string, int>& result : results) {
+        if (result.second == 0) {
+            std::cout << "PASS: " << result.first << std::endl;
+        } else {
+            std::cout << "FAIL: " << result.first << " (" << result.second << " of " << TRIALS << " trials)" << std::endl;
+            failures++;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}